@@ -0,0 +1,400 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include "ngraph/binary_model.hpp"
+#include "ngraph/runtime/aligned_buffer.hpp"
+#include "ngraph/util.hpp"
+
+using namespace ngraph;
+using namespace std;
+
+static const char s_magic[8] = {'N', 'G', 'B', 'M', 'O', 'D', 'E', 'L'};
+static const uint64_t s_version = 1;
+static const uint64_t s_header_size = sizeof(s_magic) + 2 * sizeof(uint64_t);
+static const uint64_t s_trailer_size = 2 * sizeof(uint64_t) + sizeof(s_magic);
+
+static uint64_t decode_u64(const char* p)
+{
+    uint64_t rc = 0;
+    for (size_t i = sizeof(uint64_t); i-- > 0;)
+    {
+        rc = (rc << 8) | static_cast<uint8_t>(p[i]);
+    }
+    return rc;
+}
+
+static void check_header(const char* header)
+{
+    if (memcmp(header, s_magic, sizeof(s_magic)) != 0)
+    {
+        throw runtime_error("Binary model magic error");
+    }
+    uint64_t version = decode_u64(header + sizeof(s_magic));
+    if (version != s_version)
+    {
+        throw runtime_error("Unsupported binary model version " + to_string(version));
+    }
+}
+
+// Returns the index offset and record count stored in the trailer
+static pair<uint64_t, uint64_t> check_trailer(const char* trailer, uint64_t container_size)
+{
+    if (memcmp(trailer + 2 * sizeof(uint64_t), s_magic, sizeof(s_magic)) != 0)
+    {
+        throw runtime_error("Binary model is truncated");
+    }
+    uint64_t index_offset = decode_u64(trailer);
+    uint64_t record_count = decode_u64(trailer + sizeof(uint64_t));
+    if (index_offset < s_header_size || index_offset > container_size - s_trailer_size)
+    {
+        throw runtime_error("Binary model index offset out of range");
+    }
+    return make_pair(index_offset, record_count);
+}
+
+binary_model::Writer::Writer(ostream& out, size_t alignment)
+    : m_stream(nullptr)
+    , m_alignment(alignment)
+    , m_position(0)
+    , m_closed(false)
+{
+    open(out);
+}
+
+binary_model::Writer::Writer(const string& filename, size_t alignment)
+    : m_stream(nullptr)
+    , m_alignment(alignment)
+    , m_position(0)
+    , m_closed(false)
+{
+    m_my_stream.open(filename, ios_base::binary | ios_base::out);
+    if (!m_my_stream)
+    {
+        throw runtime_error("Unable to open binary model file " + filename);
+    }
+    open(m_my_stream);
+}
+
+binary_model::Writer::~Writer()
+{
+    if (!m_closed)
+    {
+        try
+        {
+            close();
+        }
+        catch (...)
+        {
+            // Destructors must not throw, errors are reported by an explicit close()
+        }
+    }
+}
+
+void binary_model::Writer::open(ostream& out)
+{
+    if (m_alignment == 0)
+    {
+        throw runtime_error("Binary model alignment must be non-zero");
+    }
+    m_stream = &out;
+    write_bytes(s_magic, sizeof(s_magic));
+    write_u64(s_version);
+    write_u64(m_alignment);
+}
+
+void binary_model::Writer::write(const string& record_name, const void* data, size_t size_in_bytes)
+{
+    if (m_closed)
+    {
+        throw runtime_error("Binary model writer is closed");
+    }
+    pad_to(round_up(m_position, m_alignment));
+    m_records.emplace_back(record_name, m_position, size_in_bytes);
+    write_bytes(data, size_in_bytes);
+    if (!*m_stream)
+    {
+        throw runtime_error("Unable to write binary model record " + record_name);
+    }
+}
+
+void binary_model::Writer::close()
+{
+    if (m_closed)
+    {
+        return;
+    }
+    // A failed close is not retried by the destructor
+    m_closed = true;
+    uint64_t index_offset = m_position;
+    for (const Record& record : m_records)
+    {
+        write_u64(record.get_name().size());
+        write_bytes(record.get_name().data(), record.get_name().size());
+        write_u64(record.get_offset());
+        write_u64(record.get_size());
+    }
+    write_u64(index_offset);
+    write_u64(m_records.size());
+    write_bytes(s_magic, sizeof(s_magic));
+    m_stream->flush();
+    bool failed = !*m_stream;
+    if (m_my_stream.is_open())
+    {
+        m_my_stream.close();
+        failed = failed || !m_my_stream;
+    }
+    if (failed)
+    {
+        throw runtime_error("Unable to write binary model");
+    }
+}
+
+void binary_model::Writer::write_bytes(const void* data, size_t size)
+{
+    m_stream->write(static_cast<const char*>(data), size);
+    m_position += size;
+}
+
+void binary_model::Writer::write_u64(uint64_t value)
+{
+    char bytes[sizeof(uint64_t)];
+    for (size_t i = 0; i < sizeof(uint64_t); i++)
+    {
+        bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+    write_bytes(bytes, sizeof(bytes));
+}
+
+void binary_model::Writer::pad_to(uint64_t position)
+{
+    static const char zeros[64] = {};
+    while (m_position < position)
+    {
+        write_bytes(zeros, min<uint64_t>(sizeof(zeros), position - m_position));
+    }
+}
+
+binary_model::Reader::Reader(istream& in)
+    : m_stream(&in)
+    , m_base(in.tellg())
+    , m_mapped_data(nullptr)
+{
+    char header[s_header_size];
+    m_stream->read(header, s_header_size);
+    if (!*m_stream)
+    {
+        throw runtime_error("Binary model header is truncated");
+    }
+    check_header(header);
+
+    m_stream->seekg(0, ios_base::end);
+    streamoff end = m_stream->tellg();
+    if (!*m_stream || end < m_base)
+    {
+        throw runtime_error("Unable to find the size of the binary model");
+    }
+    uint64_t container_size = static_cast<uint64_t>(end - m_base);
+    if (container_size < s_header_size + s_trailer_size)
+    {
+        throw runtime_error("Binary model is truncated");
+    }
+    char trailer[s_trailer_size];
+    m_stream->seekg(m_base + static_cast<streamoff>(container_size - s_trailer_size));
+    m_stream->read(trailer, s_trailer_size);
+    if (!*m_stream)
+    {
+        throw runtime_error("Unable to read binary model trailer");
+    }
+    auto index_info = check_trailer(trailer, container_size);
+
+    uint64_t index_size = container_size - s_trailer_size - index_info.first;
+    vector<char> index(index_size);
+    m_stream->seekg(m_base + static_cast<streamoff>(index_info.first));
+    m_stream->read(index.data(), index_size);
+    if (!*m_stream)
+    {
+        throw runtime_error("Unable to read binary model index");
+    }
+    read_index(index.data(), index_info.first, index_size, index_info.second);
+}
+
+binary_model::Reader::Reader(const string& path)
+    : m_stream(nullptr)
+    , m_base(0)
+    , m_mapped_data(nullptr)
+{
+    uint64_t container_size;
+#ifdef _WIN32
+    // No mmap, so load the whole file into an aligned buffer that plays the part of the mapping
+    ifstream in(path, ios_base::binary | ios_base::in | ios_base::ate);
+    if (!in)
+    {
+        throw runtime_error("Unable to open binary model file " + path);
+    }
+    container_size = static_cast<uint64_t>(in.tellg());
+    auto buffer = make_shared<runtime::AlignedBuffer>(container_size, 4096);
+    in.seekg(0, ios_base::beg);
+    in.read(static_cast<char*>(buffer->get_ptr()), container_size);
+    if (!in)
+    {
+        throw runtime_error("Unable to read binary model file " + path);
+    }
+    m_mapped_data = static_cast<const char*>(buffer->get_ptr());
+    m_mapping = buffer;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw runtime_error("Unable to open binary model file " + path + " " + strerror(errno));
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        throw runtime_error("Unable to stat binary model file " + path + " " + strerror(errno));
+    }
+    container_size = static_cast<uint64_t>(st.st_size);
+    void* addr = nullptr;
+    if (container_size > 0)
+    {
+        addr = mmap(nullptr, container_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    // The mapping keeps its own reference to the file
+    ::close(fd);
+    if (addr == nullptr || addr == MAP_FAILED)
+    {
+        throw runtime_error("Unable to map binary model file " + path);
+    }
+    m_mapped_data = static_cast<const char*>(addr);
+    m_mapping = shared_ptr<void>(addr, [container_size](void* p) { munmap(p, container_size); });
+#endif
+
+    if (container_size < s_header_size + s_trailer_size)
+    {
+        throw runtime_error("Binary model is truncated");
+    }
+    check_header(m_mapped_data);
+    auto index_info =
+        check_trailer(m_mapped_data + container_size - s_trailer_size, container_size);
+    read_index(m_mapped_data + index_info.first,
+               index_info.first,
+               container_size - s_trailer_size - index_info.first,
+               index_info.second);
+}
+
+void binary_model::Reader::read_index(const char* index,
+                                      uint64_t index_offset,
+                                      uint64_t index_size,
+                                      uint64_t record_count)
+{
+    uint64_t position = 0;
+    auto next_u64 = [&]() {
+        if (index_size - position < sizeof(uint64_t))
+        {
+            throw runtime_error("Binary model index is truncated");
+        }
+        uint64_t value = decode_u64(index + position);
+        position += sizeof(uint64_t);
+        return value;
+    };
+
+    // Every index entry takes at least three u64s, so a count the index cannot hold is corrupt
+    // and must not size an allocation
+    if (record_count > index_size / (3 * sizeof(uint64_t)))
+    {
+        throw runtime_error("Binary model record count out of range");
+    }
+    m_records.reserve(record_count);
+    for (uint64_t i = 0; i < record_count; i++)
+    {
+        uint64_t name_size = next_u64();
+        if (index_size - position < name_size)
+        {
+            throw runtime_error("Binary model index is truncated");
+        }
+        string name(index + position, name_size);
+        position += name_size;
+        uint64_t offset = next_u64();
+        uint64_t size = next_u64();
+        // Record data lies between the header and the index
+        if (offset < s_header_size || offset > index_offset || size > index_offset - offset)
+        {
+            throw runtime_error("Binary model record " + name + " out of range");
+        }
+        m_record_index[name] = m_records.size();
+        m_records.emplace_back(name, offset, size);
+    }
+}
+
+const binary_model::Record* binary_model::Reader::find(const string& name) const
+{
+    auto it = m_record_index.find(name);
+    return it == m_record_index.end() ? nullptr : &m_records[it->second];
+}
+
+void binary_model::Reader::read(const Record& record, void* data)
+{
+    if (is_mapped())
+    {
+        memcpy(data, get_data(record), record.get_size());
+    }
+    else
+    {
+        m_stream->seekg(m_base + static_cast<streamoff>(record.get_offset()));
+        m_stream->read(static_cast<char*>(data), record.get_size());
+        if (!*m_stream)
+        {
+            throw runtime_error("Unable to read binary model record " + record.get_name());
+        }
+    }
+}
+
+const void* binary_model::Reader::get_data(const Record& record) const
+{
+    if (!is_mapped())
+    {
+        throw runtime_error("Binary model is not memory mapped");
+    }
+    return m_mapped_data + record.get_offset();
+}
+
+bool binary_model::is_binary_model(const string& path)
+{
+    ifstream in(path, ios_base::binary | ios_base::in);
+    return is_binary_model(in);
+}
+
+bool binary_model::is_binary_model(istream& in)
+{
+    streamoff offset = in.tellg();
+    char magic[sizeof(s_magic)];
+    in.read(magic, sizeof(magic));
+    bool rc = in.gcount() == sizeof(magic) && memcmp(magic, s_magic, sizeof(s_magic)) == 0;
+    in.clear();
+    in.seekg(offset, ios_base::beg);
+    return rc;
+}
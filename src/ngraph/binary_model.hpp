@@ -0,0 +1,137 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Binary model container
+//
+// A container is a sequence of named records followed by an index, so records of any size can be
+// stored and any record can be located without scanning the file:
+//
+//   header   magic[8] "NGBMODEL", u64 version, u64 alignment
+//   records  raw bytes, each starting on a multiple of alignment from the start of the container
+//   index    for every record: u64 name size, name bytes, u64 offset, u64 size
+//   trailer  u64 index offset, u64 record count, magic[8]
+//
+// All integers are little endian. Because record offsets are aligned, a memory mapped container
+// gives aligned pointers to record data that can be used in place.
+
+namespace ngraph
+{
+    namespace binary_model
+    {
+        class Record;
+        class Writer;
+        class Reader;
+
+        bool is_binary_model(const std::string& path);
+        bool is_binary_model(std::istream&);
+    }
+}
+
+class ngraph::binary_model::Record
+{
+public:
+    Record(const std::string& name, uint64_t offset, uint64_t size)
+        : m_name(name)
+        , m_offset(offset)
+        , m_size(size)
+    {
+    }
+    const std::string& get_name() const { return m_name; }
+    uint64_t get_offset() const { return m_offset; }
+    uint64_t get_size() const { return m_size; }
+private:
+    std::string m_name;
+    uint64_t m_offset;
+    uint64_t m_size;
+};
+
+class ngraph::binary_model::Writer
+{
+public:
+    static constexpr size_t default_alignment = 64;
+
+    Writer(std::ostream& out, size_t alignment = default_alignment);
+    Writer(const std::string& filename, size_t alignment = default_alignment);
+    ~Writer();
+
+    void write(const std::string& record_name, const void* data, size_t size_in_bytes);
+
+    /// \brief Writes the index and trailer, throwing if any write failed. The destructor closes
+    /// a writer that was not closed explicitly, but cannot report errors.
+    void close();
+
+private:
+    void open(std::ostream& out);
+    void write_bytes(const void* data, size_t size);
+    void write_u64(uint64_t value);
+    void pad_to(uint64_t position);
+
+    std::ostream* m_stream;
+    std::ofstream m_my_stream;
+    size_t m_alignment;
+    uint64_t m_position;
+    std::vector<Record> m_records;
+    bool m_closed;
+};
+
+/// \brief Reads a binary model container either from a stream, in which case record data is
+/// copied out with read(), or by memory mapping a file, in which case get_data() returns
+/// pointers into the mapping. The mapping stays valid as long as get_mapping() is referenced.
+class ngraph::binary_model::Reader
+{
+public:
+    /// \brief Read the index from a stream positioned at the start of the container
+    Reader(std::istream& in);
+
+    /// \brief Memory map the file at path and read its index
+    Reader(const std::string& path);
+
+    const std::vector<Record>& get_records() const { return m_records; }
+    /// \brief Returns the record named name, or nullptr if there is no such record
+    const Record* find(const std::string& name) const;
+
+    /// \brief Copy the data of record into data, which must hold record.get_size() bytes
+    void read(const Record& record, void* data);
+
+    bool is_mapped() const { return m_mapped_data != nullptr; }
+    /// \brief Pointer to the data of record inside the mapping. Only valid if is_mapped().
+    const void* get_data(const Record& record) const;
+    /// \brief Owner of the mapping. Holding a copy keeps pointers from get_data() valid after
+    /// the Reader is destroyed.
+    std::shared_ptr<void> get_mapping() const { return m_mapping; }
+private:
+    void read_index(const char* index,
+                    uint64_t index_offset,
+                    uint64_t index_size,
+                    uint64_t record_count);
+
+    std::istream* m_stream;
+    std::streamoff m_base;
+    std::shared_ptr<void> m_mapping;
+    const char* m_mapped_data;
+    std::vector<Record> m_records;
+    std::unordered_map<std::string, size_t> m_record_index;
+};
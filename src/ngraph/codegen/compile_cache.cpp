@@ -0,0 +1,202 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/SHA1.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "ngraph/codegen/compile_cache.hpp"
+#include "ngraph/file_util.hpp"
+#include "ngraph/log.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+// Write through a temporary file so that concurrent processes never see a partial entry
+static void write_entry(const string& path, const char* data, size_t size)
+{
+    string tmp_path = path + "." + to_string(random_device()()) + ".tmp";
+    {
+        ofstream out(tmp_path, ios_base::binary | ios_base::out);
+        out.write(data, size);
+        if (!out)
+        {
+            NGRAPH_WARN << "Unable to write compile cache entry " << path;
+            file_util::remove_file(tmp_path);
+            return;
+        }
+    }
+    if (rename(tmp_path.c_str(), path.c_str()) != 0)
+    {
+        file_util::remove_file(tmp_path);
+    }
+}
+
+namespace
+{
+    // Serves MCJIT object code for modules tagged by CompileCache::store, whose identifier is
+    // their cache key
+    class CompileObjectCache : public llvm::ObjectCache
+    {
+    public:
+        CompileObjectCache(const string& directory)
+            : m_directory(directory)
+        {
+        }
+
+        void notifyObjectCompiled(const llvm::Module* module, llvm::MemoryBufferRef obj) override
+        {
+            string path = get_path(module);
+            if (!path.empty())
+            {
+                write_entry(path, obj.getBufferStart(), obj.getBufferSize());
+            }
+        }
+
+        unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) override
+        {
+            unique_ptr<llvm::MemoryBuffer> rc;
+            string path = get_path(module);
+            if (!path.empty() && file_util::exists(path))
+            {
+                auto buffer = llvm::MemoryBuffer::getFile(path);
+                if (buffer)
+                {
+                    rc = move(buffer.get());
+                }
+            }
+            return rc;
+        }
+
+    private:
+        string get_path(const llvm::Module* module) const
+        {
+            const string& key = module->getModuleIdentifier();
+            if (key.compare(0, 8, "ngcache_") != 0)
+            {
+                return "";
+            }
+            return file_util::path_join(m_directory, key + ".o");
+        }
+
+        string m_directory;
+    };
+}
+
+codegen::CompileCache::CompileCache(const string& directory)
+    : m_directory(directory)
+    , m_context(new llvm::LLVMContext())
+    , m_object_cache(new CompileObjectCache(directory))
+{
+    file_util::make_directory(m_directory);
+}
+
+codegen::CompileCache::~CompileCache()
+{
+}
+
+string codegen::CompileCache::get_key(const string& source, const string& pch_source) const
+{
+    // SHA-1 over everything the compiled code depends on, each part prefixed with its size so
+    // that ("ab", "c") and ("a", "bc") differ
+    llvm::SHA1 sha;
+    auto add = [&sha](const string& s) {
+        sha.update(to_string(s.size()) + ":");
+        sha.update(s);
+    };
+    add(NGRAPH_VERSION);
+    add(LLVM_VERSION_STRING);
+    add(llvm::sys::getHostCPUName().str());
+    add(pch_source);
+    add(source);
+
+    stringstream ss;
+    ss << "ngcache_" << hex << setfill('0');
+    for (uint8_t byte : sha.final())
+    {
+        ss << setw(2) << static_cast<int>(byte);
+    }
+    return ss.str();
+}
+
+unique_ptr<codegen::Module> codegen::CompileCache::load(const string& key, const string& source)
+{
+    unique_ptr<codegen::Module> rc;
+    string path = file_util::path_join(m_directory, key + ".bc");
+    string source_path = file_util::path_join(m_directory, key + ".cpp");
+    if (!file_util::exists(path) || !file_util::exists(source_path))
+    {
+        return rc;
+    }
+    // Reuse only code compiled from exactly this source, whatever the digest says
+    auto stored_source = llvm::MemoryBuffer::getFile(source_path);
+    if (!stored_source || stored_source.get()->getBuffer() != source)
+    {
+        NGRAPH_WARN << "Ignoring compile cache entry " << path << " for other source";
+        return rc;
+    }
+    auto buffer = llvm::MemoryBuffer::getFile(path);
+    if (buffer)
+    {
+        auto module = llvm::parseBitcodeFile(buffer.get()->getMemBufferRef(), *m_context);
+        if (module)
+        {
+            module.get()->setModuleIdentifier(key);
+            rc.reset(new codegen::Module(move(module.get())));
+        }
+        else
+        {
+            llvm::consumeError(module.takeError());
+            NGRAPH_WARN << "Ignoring unreadable compile cache entry " << path;
+        }
+    }
+    return rc;
+}
+
+void codegen::CompileCache::store(const string& key,
+                                  const string& source,
+                                  codegen::Module& module)
+{
+    llvm::Module* llvm_module = module.get_module();
+    llvm_module->setModuleIdentifier(key);
+
+    // Object code of an entry being replaced must not be served for this module
+    string object_path = file_util::path_join(m_directory, key + ".o");
+    if (file_util::exists(object_path))
+    {
+        file_util::remove_file(object_path);
+    }
+    write_entry(file_util::path_join(m_directory, key + ".cpp"), source.data(), source.size());
+
+    llvm::SmallVector<char, 0> bitcode;
+    llvm::raw_svector_ostream out(bitcode);
+    llvm::WriteBitcodeToFile(*llvm_module, out);
+    write_entry(file_util::path_join(m_directory, key + ".bc"), bitcode.data(), bitcode.size());
+}
@@ -0,0 +1,67 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "ngraph/codegen/compiler.hpp"
+
+namespace ngraph
+{
+    namespace codegen
+    {
+        class CompileCache;
+    }
+}
+
+namespace llvm
+{
+    class LLVMContext;
+    class ObjectCache;
+}
+
+/// \brief On-disk cache of compiled code, shared by every process that uses the same directory.
+///
+/// Entries are keyed on a SHA-1 digest of the source, the precompiled header source, the nGraph
+/// and LLVM versions and the host CPU. An entry holds the source it was compiled from, which a
+/// lookup compares before reuse, the LLVM bitcode produced by clang, so a hit skips the C++
+/// front end, and the object code produced by the JIT, so a hit also skips code generation. Modules loaded from the cache belong to a context owned by the cache, which must
+/// therefore outlive any ExecutionEngine they are added to.
+class ngraph::codegen::CompileCache
+{
+public:
+    CompileCache(const std::string& directory);
+    ~CompileCache();
+
+    std::string get_key(const std::string& source, const std::string& pch_source) const;
+
+    /// \brief Returns the module stored under key, or nullptr if there is none or it was
+    /// compiled from other source
+    std::unique_ptr<Module> load(const std::string& key, const std::string& source);
+
+    /// \brief Stores module, compiled from source, under key and tags it so that its object
+    /// code is cached too
+    void store(const std::string& key, const std::string& source, Module& module);
+
+    /// \brief Object cache to attach to the ExecutionEngine that runs cached modules
+    llvm::ObjectCache* get_object_cache() const { return m_object_cache.get(); }
+private:
+    std::string m_directory;
+    std::unique_ptr<llvm::LLVMContext> m_context;
+    std::unique_ptr<llvm::ObjectCache> m_object_cache;
+};
@@ -47,6 +47,7 @@ public:
     Module(std::unique_ptr<llvm::Module> module);
     ~Module();
     std::unique_ptr<llvm::Module> take_module();
+    llvm::Module* get_module() { return m_module.get(); }
 
 private:
     std::unique_ptr<llvm::Module> m_module;
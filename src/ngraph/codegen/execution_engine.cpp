@@ -22,6 +22,7 @@ using namespace ngraph;
 
 codegen::ExecutionEngine::ExecutionEngine()
     : m_execution_engine{nullptr}
+    , m_object_cache{nullptr}
 {
 }
 
@@ -51,6 +52,10 @@ bool codegen::ExecutionEngine::add_module(std::unique_ptr<ngraph::codegen::Modul
             {
                 return false;
             }
+            if (m_object_cache)
+            {
+                m_execution_engine->setObjectCache(m_object_cache);
+            }
         }
     }
     else
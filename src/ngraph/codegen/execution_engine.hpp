@@ -33,6 +33,7 @@ namespace llvm
 {
     class Module;
     class ExecutionEngine;
+    class ObjectCache;
 }
 
 class ngraph::codegen::ExecutionEngine
@@ -44,6 +45,10 @@ public:
     bool add_module(std::unique_ptr<ngraph::codegen::Module>& module);
     void finalize();
 
+    /// \brief Use cache to load and store the object code of modules. Must be set before
+    /// add_module.
+    void set_object_cache(llvm::ObjectCache* cache) { m_object_cache = cache; }
+
     template <typename ftype>
     std::function<ftype> find_function(const std::string& func_name)
     {
@@ -52,6 +57,7 @@ public:
 
 private:
     std::unique_ptr<llvm::ExecutionEngine> m_execution_engine;
+    llvm::ObjectCache* m_object_cache;
     std::string m_jit_error;
 
     void* get_pointer_to_named_function(const std::string& func_name);
@@ -0,0 +1,155 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace ngraph
+{
+    namespace descriptor
+    {
+        /// \brief Contiguous storage for a node's input or output descriptors.
+        ///
+        /// Descriptors can be neither copied nor moved because other nodes hold their addresses.
+        /// The first N elements live inside the array itself, so the common case of a node with
+        /// a few inputs and outputs needs no allocation. Capacity must be reserved before
+        /// elements are added. Growing a non-empty array takes a function that rebuilds an
+        /// element at a new address and repoints whatever refers to it.
+        template <typename T, size_t N>
+        class DescriptorArray
+        {
+        public:
+            DescriptorArray() = default;
+            DescriptorArray(const DescriptorArray&) = delete;
+            DescriptorArray& operator=(const DescriptorArray&) = delete;
+            ~DescriptorArray()
+            {
+                clear();
+                release();
+            }
+
+            size_t size() const { return m_size; }
+            size_t capacity() const { return m_capacity; }
+            bool empty() const { return m_size == 0; }
+            T* begin() { return data(); }
+            T* end() { return data() + m_size; }
+            const T* begin() const { return data(); }
+            const T* end() const { return data() + m_size; }
+            T& operator[](size_t i) { return data()[i]; }
+            const T& operator[](size_t i) const { return data()[i]; }
+            T& at(size_t i)
+            {
+                check_index(i);
+                return data()[i];
+            }
+            const T& at(size_t i) const
+            {
+                check_index(i);
+                return data()[i];
+            }
+            T& front() { return data()[0]; }
+            const T& front() const { return data()[0]; }
+            T& back() { return data()[m_size - 1]; }
+            const T& back() const { return data()[m_size - 1]; }
+            /// \brief Reserves room for n elements; the array must be empty or already large
+            ///     enough.
+            void reserve(size_t n)
+            {
+                reserve(n, [](T&, void*) {
+                    throw std::logic_error("DescriptorArray elements cannot be relocated");
+                });
+            }
+
+            /// \brief Reserves room for n elements, rebuilding existing elements with
+            ///     relocate(T& old_element, void* new_address) if the storage has to move.
+            template <typename Relocate>
+            void reserve(size_t n, Relocate relocate)
+            {
+                if (n <= m_capacity)
+                {
+                    return;
+                }
+                Storage* storage = new Storage[n];
+                for (size_t i = 0; i < m_size; i++)
+                {
+                    relocate(data()[i], &storage[i]);
+                }
+                size_t size = m_size;
+                clear();
+                release();
+                m_heap = storage;
+                m_capacity = n;
+                m_size = size;
+            }
+
+            /// \brief Constructs an element at the end; capacity must have been reserved.
+            template <typename... Args>
+            T& emplace_back(Args&&... args)
+            {
+                if (m_size == m_capacity)
+                {
+                    throw std::length_error("DescriptorArray capacity exceeded");
+                }
+                T* element = new (data() + m_size) T(std::forward<Args>(args)...);
+                m_size++;
+                return *element;
+            }
+
+        private:
+            using Storage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+            T* data() { return reinterpret_cast<T*>(m_heap ? m_heap : m_inline); }
+            const T* data() const
+            {
+                return reinterpret_cast<const T*>(m_heap ? m_heap : m_inline);
+            }
+
+            void check_index(size_t i) const
+            {
+                if (i >= m_size)
+                {
+                    throw std::out_of_range("DescriptorArray index out of range");
+                }
+            }
+
+            void clear()
+            {
+                for (size_t i = m_size; i > 0; i--)
+                {
+                    data()[i - 1].~T();
+                }
+                m_size = 0;
+            }
+
+            void release()
+            {
+                delete[] m_heap;
+                m_heap = nullptr;
+                m_capacity = N;
+            }
+
+            Storage m_inline[N];
+            Storage* m_heap = nullptr;
+            size_t m_size = 0;
+            size_t m_capacity = N;
+        };
+    }
+}
@@ -32,11 +32,15 @@ descriptor::Output::Output(Node* node, size_t index, const shared_ptr<Tensor>& t
 void descriptor::Output::add_input(Input* input)
 {
     m_inputs.insert(input);
+    m_node->topology_changed();
+    input->get_raw_pointer_node()->topology_changed();
 }
 
 void descriptor::Output::remove_input(Input* input)
 {
     m_inputs.erase(input);
+    m_node->topology_changed();
+    input->get_raw_pointer_node()->topology_changed();
 }
 
 shared_ptr<Node> descriptor::Output::get_node() const
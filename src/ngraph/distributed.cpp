@@ -23,6 +23,7 @@
 using namespace ngraph;
 
 static std::unique_ptr<DistributedInterface> s_distributed_interface;
+static thread_local int s_thread_rank = -1;
 
 void ngraph::set_distributed_interface(std::unique_ptr<DistributedInterface> distributed_interface)
 {
@@ -47,3 +48,13 @@ DistributedInterface* ngraph::get_distributed_interface()
     }
     return s_distributed_interface.get();
 }
+
+int ngraph::distributed::get_thread_rank()
+{
+    return s_thread_rank;
+}
+
+void ngraph::distributed::set_thread_rank(int rank)
+{
+    s_thread_rank = rank;
+}
@@ -34,9 +34,30 @@ namespace ngraph
 
         virtual void
             all_reduce(void* in, void* out, element::Type_t element_type, size_t count) = 0;
+
+        /// \brief Starts an all_reduce that completes in all_reduce_wait(out). Neither in nor
+        ///        out may be touched until then. Outstanding reductions must be started in the
+        ///        same order on every rank. The default implementation runs the reduction
+        ///        synchronously.
+        virtual void
+            all_reduce_start(void* in, void* out, element::Type_t element_type, size_t count)
+        {
+            all_reduce(in, out, element_type, count);
+        }
+        /// \brief Waits for the all_reduce_start that writes to out
+        virtual void all_reduce_wait(void* out) {}
         virtual void broadcast(void* in, element::Type_t element_type, size_t count) = 0;
     };
 
     void set_distributed_interface(std::unique_ptr<DistributedInterface> distributed_interface);
     DistributedInterface* get_distributed_interface();
+
+    namespace distributed
+    {
+        /// \brief The rank the calling thread acts as, for interfaces that run several ranks
+        ///     in one process, or -1 if the thread is not bound to a rank. Executables that run
+        ///     a call's ops on other threads bind those threads to the caller's rank.
+        int get_thread_rank();
+        void set_thread_rank(int rank);
+    }
 }
@@ -17,7 +17,10 @@
 #pragma once
 
 #ifdef NGRAPH_DISTRIBUTED_MLSL_ENABLE
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
 
 #include <mlsl.hpp>
 
@@ -61,29 +64,45 @@ namespace ngraph
             void
                 all_reduce(void* in, void* out, element::Type_t element_type, size_t count) override
             {
-                auto data_type = MLSL::DT_FLOAT;
-
-                if (element_type == element::Type_t::f32)
-                {
-                    data_type = MLSL::DT_FLOAT;
-                }
-                else if (element_type == element::Type_t::f64)
-                {
-                    data_type = MLSL::DT_DOUBLE;
-                }
-                else
-                {
-                    throw std::runtime_error("AllReduce op supports only f32 and f64 types");
-                }
-
                 MLSL::Environment& env = MLSL::Environment::GetEnv();
                 MLSL::Distribution* distribution = env.CreateDistribution(env.GetProcessCount(), 1);
-                MLSL::CommReq* req =
-                    distribution->AllReduce(in, out, count, data_type, MLSL::RT_SUM, MLSL::GT_DATA);
+                MLSL::CommReq* req = distribution->AllReduce(
+                    in, out, count, get_data_type(element_type), MLSL::RT_SUM, MLSL::GT_DATA);
                 env.Wait(req);
                 env.DeleteDistribution(distribution);
             }
 
+            void all_reduce_start(void* in,
+                                  void* out,
+                                  element::Type_t element_type,
+                                  size_t count) override
+            {
+                MLSL::Environment& env = MLSL::Environment::GetEnv();
+                MLSL::Distribution* distribution = env.CreateDistribution(env.GetProcessCount(), 1);
+                MLSL::CommReq* req = distribution->AllReduce(
+                    in, out, count, get_data_type(element_type), MLSL::RT_SUM, MLSL::GT_DATA);
+                std::lock_guard<std::mutex> lock(m_requests_mutex);
+                m_requests[out] = std::make_pair(distribution, req);
+            }
+
+            void all_reduce_wait(void* out) override
+            {
+                std::pair<MLSL::Distribution*, MLSL::CommReq*> request;
+                {
+                    std::lock_guard<std::mutex> lock(m_requests_mutex);
+                    auto it = m_requests.find(out);
+                    if (it == m_requests.end())
+                    {
+                        throw std::runtime_error("No AllReduce in progress for this buffer");
+                    }
+                    request = it->second;
+                    m_requests.erase(it);
+                }
+                MLSL::Environment& env = MLSL::Environment::GetEnv();
+                env.Wait(request.second);
+                env.DeleteDistribution(request.first);
+            }
+
             void broadcast(void* in, element::Type_t element_type, size_t count) override
             {
                 auto data_type = MLSL::DT_FLOAT;
@@ -106,7 +125,22 @@ namespace ngraph
             }
 
         protected:
+            static MLSL::DataType get_data_type(element::Type_t element_type)
+            {
+                if (element_type == element::Type_t::f32)
+                {
+                    return MLSL::DT_FLOAT;
+                }
+                else if (element_type == element::Type_t::f64)
+                {
+                    return MLSL::DT_DOUBLE;
+                }
+                throw std::runtime_error("AllReduce op supports only f32 and f64 types");
+            }
+
             std::string m_name{"MLSL"};
+            std::mutex m_requests_mutex;
+            std::unordered_map<void*, std::pair<MLSL::Distribution*, MLSL::CommReq*>> m_requests;
         };
     }
 }
@@ -21,7 +21,9 @@
 #include "ngraph/distributed.hpp"
 
 #ifdef NGRAPH_DISTRIBUTED_OMPI_ENABLE
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include <mpi.h>
 
@@ -72,22 +74,35 @@ namespace ngraph
             void
                 all_reduce(void* in, void* out, element::Type_t element_type, size_t count) override
             {
-                auto data_type = MPI_FLOAT;
+                MPI_Allreduce(in, out, count, get_data_type(element_type), MPI_SUM, MPI_COMM_WORLD);
+            }
 
-                if (element_type == element::Type_t::f32)
-                {
-                    data_type = MPI_FLOAT;
-                }
-                else if (element_type == element::Type_t::f64)
-                {
-                    data_type = MPI_DOUBLE;
-                }
-                else
+            void all_reduce_start(void* in,
+                                  void* out,
+                                  element::Type_t element_type,
+                                  size_t count) override
+            {
+                MPI_Request request;
+                MPI_Iallreduce(
+                    in, out, count, get_data_type(element_type), MPI_SUM, MPI_COMM_WORLD, &request);
+                std::lock_guard<std::mutex> lock(m_requests_mutex);
+                m_requests[out] = request;
+            }
+
+            void all_reduce_wait(void* out) override
+            {
+                MPI_Request request;
                 {
-                    throw std::runtime_error("AllReduce op supports only f32 and f64 types");
+                    std::lock_guard<std::mutex> lock(m_requests_mutex);
+                    auto it = m_requests.find(out);
+                    if (it == m_requests.end())
+                    {
+                        throw std::runtime_error("No AllReduce in progress for this buffer");
+                    }
+                    request = it->second;
+                    m_requests.erase(it);
                 }
-
-                MPI_Allreduce(in, out, count, data_type, MPI_SUM, MPI_COMM_WORLD);
+                MPI_Wait(&request, MPI_STATUS_IGNORE);
             }
 
             void broadcast(void* in, element::Type_t element_type, size_t count) override
@@ -107,7 +122,22 @@ namespace ngraph
             }
 
         protected:
+            static MPI_Datatype get_data_type(element::Type_t element_type)
+            {
+                if (element_type == element::Type_t::f32)
+                {
+                    return MPI_FLOAT;
+                }
+                else if (element_type == element::Type_t::f64)
+                {
+                    return MPI_DOUBLE;
+                }
+                throw std::runtime_error("AllReduce op supports only f32 and f64 types");
+            }
+
             std::string m_name;
+            std::mutex m_requests_mutex;
+            std::unordered_map<void*, MPI_Request> m_requests;
         };
     }
 }
@@ -0,0 +1,139 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "ngraph/distributed/shared_memory.hpp"
+#include "ngraph/except.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+template <typename T>
+static void reduce_slice(const vector<void*>& inputs, void* out, size_t begin, size_t end)
+{
+    T* result = static_cast<T*>(out);
+    const T* first = static_cast<const T*>(inputs[0]);
+    copy(first + begin, first + end, result + begin);
+    for (size_t rank = 1; rank < inputs.size(); rank++)
+    {
+        const T* input = static_cast<const T*>(inputs[rank]);
+        for (size_t i = begin; i < end; i++)
+        {
+            result[i] += input[i];
+        }
+    }
+}
+
+distributed::SharedMemoryDistributedInterface::SharedMemoryDistributedInterface(
+    int size, const string& name)
+    : m_name(name)
+    , m_size(size)
+    , m_buffers(size)
+{
+    if (size < 1)
+    {
+        throw ngraph_error("SharedMemoryDistributedInterface needs at least one rank");
+    }
+}
+
+int distributed::SharedMemoryDistributedInterface::get_rank()
+{
+    int rank = distributed::get_thread_rank();
+    if (rank < 0 || rank >= m_size)
+    {
+        throw ngraph_error("Thread is not bound to a rank; call set_rank first");
+    }
+    return rank;
+}
+
+void distributed::SharedMemoryDistributedInterface::set_rank(int rank)
+{
+    if (rank < 0 || rank >= m_size)
+    {
+        throw ngraph_error("Rank " + to_string(rank) + " is out of range for " +
+                           to_string(m_size) + " ranks");
+    }
+    distributed::set_thread_rank(rank);
+}
+
+void distributed::SharedMemoryDistributedInterface::barrier()
+{
+    unique_lock<mutex> lock(m_mutex);
+    size_t generation = m_generation;
+    if (++m_arrived == m_size)
+    {
+        m_arrived = 0;
+        m_generation++;
+        m_condition.notify_all();
+    }
+    else
+    {
+        m_condition.wait(lock, [this, generation] { return generation != m_generation; });
+    }
+}
+
+void distributed::SharedMemoryDistributedInterface::all_reduce(void* in,
+                                                               void* out,
+                                                               element::Type_t element_type,
+                                                               size_t count)
+{
+    void (*reduce)(const vector<void*>&, void*, size_t, size_t);
+    switch (element_type)
+    {
+    case element::Type_t::f32: reduce = reduce_slice<float>; break;
+    case element::Type_t::f64: reduce = reduce_slice<double>; break;
+    case element::Type_t::i32: reduce = reduce_slice<int32_t>; break;
+    case element::Type_t::i64: reduce = reduce_slice<int64_t>; break;
+    default: throw ngraph_error("AllReduce op supports only f32, f64, i32 and i64 types");
+    }
+
+    int rank = get_rank();
+    size_t element_size = element::Type(element_type).size();
+    m_buffers[rank] = in;
+    if (rank == 0)
+    {
+        m_reduced.resize(count * element_size);
+    }
+    barrier();
+
+    reduce(m_buffers, m_reduced.data(), count * rank / m_size, count * (rank + 1) / m_size);
+    // Every input has been read before any output is written, so in and out may alias
+    barrier();
+
+    memcpy(out, m_reduced.data(), count * element_size);
+    barrier();
+}
+
+void distributed::SharedMemoryDistributedInterface::broadcast(void* in,
+                                                              element::Type_t element_type,
+                                                              size_t count)
+{
+    int rank = get_rank();
+    if (rank == 0)
+    {
+        m_buffers[0] = in;
+    }
+    barrier();
+
+    if (rank != 0)
+    {
+        memcpy(in, m_buffers[0], count * element::Type(element_type).size());
+    }
+    barrier();
+}
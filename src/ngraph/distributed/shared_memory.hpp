@@ -0,0 +1,74 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ngraph/distributed.hpp"
+
+namespace ngraph
+{
+    namespace distributed
+    {
+        /// \brief Runs several ranks as threads of one process, communicating through memory.
+        ///
+        /// Each rank is a thread that has called set_rank; collectives must be entered by every
+        /// rank, in the same order. Executables carry the caller's rank over to the threads
+        /// that run its ops, see distributed::get_thread_rank. all_reduce is a reduce-scatter
+        /// followed by an all-gather: each rank sums its own slice of the buffer across all
+        /// ranks, then every rank copies the reduced slices. Sums are always taken in rank
+        /// order, so every rank receives bitwise identical results.
+        class SharedMemoryDistributedInterface : public DistributedInterface
+        {
+        public:
+            SharedMemoryDistributedInterface(int size,
+                                             const std::string& name = "SharedMemory");
+
+            const std::string& get_name() const override { return m_name; }
+            int get_size() override { return m_size; }
+            /// \brief The rank the calling thread is bound to
+            int get_rank() override;
+
+            /// \brief Binds the calling thread to rank
+            void set_rank(int rank);
+
+            void all_reduce(void* in,
+                            void* out,
+                            element::Type_t element_type,
+                            size_t count) override;
+            void broadcast(void* in, element::Type_t element_type, size_t count) override;
+
+        private:
+            void barrier();
+
+            std::string m_name;
+            int m_size;
+
+            std::mutex m_mutex;
+            std::condition_variable m_condition;
+            int m_arrived = 0;
+            size_t m_generation = 0;
+
+            // The buffer each rank passed to the current collective
+            std::vector<void*> m_buffers;
+            std::vector<char> m_reduced;
+        };
+    }
+}
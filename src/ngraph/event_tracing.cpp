@@ -19,6 +19,7 @@
 #include <string>
 
 #include "event_tracing.hpp"
+#include "ngraph/trace.hpp"
 #include "nlohmann/json.hpp"
 
 using namespace std;
@@ -28,30 +29,18 @@ static bool read_tracing_env_var()
     return (std::getenv("NGRAPH_ENABLE_TRACING") != nullptr);
 }
 
-mutex ngraph::Event::s_file_mutex;
-ofstream ngraph::Event::s_event_log;
 bool ngraph::Event::s_tracing_enabled = read_tracing_env_var();
 
 void ngraph::Event::write_trace(const ngraph::Event& event)
 {
     if (is_tracing_enabled())
     {
-        lock_guard<mutex> lock(s_file_mutex);
-
-        static bool so_initialized = false;
-        if (!so_initialized)
-        {
-            // Open the file
-            s_event_log.open("ngraph_event_trace.json", ios_base::trunc);
-            s_event_log << "[\n";
-            so_initialized = true;
-        }
-        else
-        {
-            s_event_log << ",\n";
-        }
-
-        s_event_log << event.to_json() << "\n" << flush;
+        uint64_t start = chrono::duration_cast<chrono::nanoseconds>(
+                             event.m_start.time_since_epoch())
+                             .count();
+        uint64_t stop =
+            chrono::duration_cast<chrono::nanoseconds>(event.m_stop.time_since_epoch()).count();
+        trace::record(trace::intern(event.m_category), trace::intern(event.m_name), start, stop);
     }
 }
 
@@ -87,4 +76,9 @@ void ngraph::Event::enable_event_tracing()
 void ngraph::Event::disable_event_tracing()
 {
     s_tracing_enabled = false;
+    // When process-wide tracing is on it owns the trace file and writes it at exit
+    if (!trace::is_enabled())
+    {
+        trace::write_chrome_trace();
+    }
 }
@@ -17,9 +17,7 @@
 #pragma once
 
 #include <chrono>
-#include <fstream>
 #include <iostream>
-#include <mutex>
 #include <string>
 #include <thread>
 #ifdef _WIN32
@@ -63,6 +61,10 @@ namespace ngraph
     //
     // More information about this is at:
     // http://dev.chromium.org/developers/how-tos/trace-event-profiling-tool
+    //
+    // write_trace records the event in the calling thread's ngraph::trace buffer, so events
+    // appear in the same trace as pass and op execution. The trace file is written when
+    // tracing is disabled and at exit. Event args are not recorded.
 
     class Event
     {
@@ -71,7 +73,7 @@ namespace ngraph
                        const std::string& category,
                        const std::string& args)
             : m_pid(getpid())
-            , m_start(std::chrono::high_resolution_clock::now())
+            , m_start(std::chrono::steady_clock::now())
             , m_stopped(false)
             , m_name(name)
             , m_category(category)
@@ -87,12 +89,15 @@ namespace ngraph
                 return;
             }
             m_stopped = true;
-            m_stop = std::chrono::high_resolution_clock::now();
+            m_stop = std::chrono::steady_clock::now();
         }
 
         static void write_trace(const Event& event);
         static bool is_tracing_enabled() { return s_tracing_enabled; }
+        /// \brief Records Events without enabling the process-wide tracing in trace.hpp
         static void enable_event_tracing();
+        /// \brief Stops recording Events and, unless process-wide tracing is enabled, writes
+        ///     the buffered events to NGRAPH_TRACE_FILE
         static void disable_event_tracing();
         std::string to_json() const;
 
@@ -101,15 +106,13 @@ namespace ngraph
 
     private:
         int m_pid;
-        std::chrono::time_point<std::chrono::high_resolution_clock> m_start;
-        std::chrono::time_point<std::chrono::high_resolution_clock> m_stop;
+        std::chrono::time_point<std::chrono::steady_clock> m_start;
+        std::chrono::time_point<std::chrono::steady_clock> m_stop;
         bool m_stopped;
         std::string m_name;
         std::string m_category;
         std::string m_args;
 
-        static std::mutex s_file_mutex;
-        static std::ofstream s_event_log;
         static bool s_tracing_enabled;
     };
 
@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <list>
 #include <memory>
+#include <set>
 
 #include "ngraph/function.hpp"
 #include "ngraph/graph_util.hpp"
@@ -99,9 +100,45 @@ void Function::init()
                    true /*include control dependencies*/);
 }
 
-std::list<shared_ptr<Node>> Function::get_ordered_ops(bool include_control_deps) const
+Function::OrderedOps Function::get_ordered_ops(bool include_control_deps) const
 {
-    return topological_sort(get_ops(include_control_deps), include_control_deps);
+    shared_ptr<const list<shared_ptr<Node>>> ops;
+    set<shared_ptr<TopologyObserver>> replaced;
+    {
+        lock_guard<mutex> lock(m_ordered_ops_cache->m_mutex);
+        ops = m_ordered_ops_cache->m_ops[include_control_deps ? 1 : 0];
+        if (!ops)
+        {
+            ops = make_shared<const list<shared_ptr<Node>>>(
+                topological_sort(get_ops(include_control_deps), include_control_deps));
+            m_ordered_ops_cache->m_ops[include_control_deps ? 1 : 0] = ops;
+            for (auto& node : *ops)
+            {
+                if (auto observer = node->set_topology_observer(m_ordered_ops_cache))
+                {
+                    replaced.insert(observer);
+                }
+            }
+        }
+    }
+    // A node only reports to one observer, so caches of other functions sharing these ops
+    // would miss their changes and must be dropped. Done outside our lock, they may be
+    // sorting ops of this function.
+    for (auto& observer : replaced)
+    {
+        observer->topology_changed();
+    }
+    return OrderedOps(ops);
+}
+
+void Function::OrderedOpsCache::topology_changed()
+{
+    shared_ptr<const list<shared_ptr<Node>>> released[2];
+    {
+        lock_guard<mutex> lock(m_mutex);
+        swap(released, m_ops);
+    }
+    // Releasing the lists may destroy nodes, which notify this cache again
 }
 
 const std::string& Function::get_friendly_name() const
@@ -20,6 +20,7 @@
 #include <initializer_list>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -86,8 +87,39 @@ namespace ngraph
         /// \returns A const reference to the function's friendly name.
         const std::string& get_friendly_name() const;
 
+        /// \brief The ops of a function in topological order. Shares an immutable list with the
+        /// function's cache, so it can be iterated while the graph is being rewritten.
+        class OrderedOps
+        {
+        public:
+            using const_iterator = std::list<std::shared_ptr<Node>>::const_iterator;
+            using const_reverse_iterator =
+                std::list<std::shared_ptr<Node>>::const_reverse_iterator;
+
+            OrderedOps(std::shared_ptr<const std::list<std::shared_ptr<Node>>> ops)
+                : m_ops(std::move(ops))
+            {
+            }
+            const_iterator begin() const { return m_ops->begin(); }
+            const_iterator end() const { return m_ops->end(); }
+            const_reverse_iterator rbegin() const { return m_ops->rbegin(); }
+            const_reverse_iterator rend() const { return m_ops->rend(); }
+            size_t size() const { return m_ops->size(); }
+            bool empty() const { return m_ops->empty(); }
+            const std::shared_ptr<Node>& front() const { return m_ops->front(); }
+            const std::shared_ptr<Node>& back() const { return m_ops->back(); }
+            operator const std::list<std::shared_ptr<Node>>&() const { return *m_ops; }
+            bool operator==(const OrderedOps& other) const { return *m_ops == *other.m_ops; }
+            bool operator!=(const OrderedOps& other) const { return *m_ops != *other.m_ops; }
+
+        private:
+            std::shared_ptr<const std::list<std::shared_ptr<Node>>> m_ops;
+        };
+
         std::list<std::shared_ptr<Node>> get_ops(bool include_control_deps = true) const;
-        std::list<std::shared_ptr<Node>> get_ordered_ops(bool include_control_deps = true) const;
+        /// \brief Returns the ops in topological order. The order is cached until an edge or
+        /// control dependency of one of the ops changes.
+        OrderedOps get_ordered_ops(bool include_control_deps = true) const;
         friend std::ostream& operator<<(std::ostream&, const Function&);
         size_t get_instance_id() { return m_instance_id; }
         size_t get_temporary_pool_size();
@@ -123,5 +155,19 @@ namespace ngraph
         std::string m_name;
         const std::string m_unique_name;
         size_t m_placement{0};
+
+        // Drops the sorted lists as soon as one of the ops they hold is rewired, so nodes
+        // removed from the graph are not kept alive by the cache
+        class OrderedOpsCache : public TopologyObserver
+        {
+        public:
+            void topology_changed() override;
+
+            std::mutex m_mutex;
+            // Indexed by include_control_deps
+            std::shared_ptr<const std::list<std::shared_ptr<Node>>> m_ops[2];
+        };
+        std::shared_ptr<OrderedOpsCache> m_ordered_ops_cache{
+            std::make_shared<OrderedOpsCache>()};
     };
 }
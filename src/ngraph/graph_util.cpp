@@ -14,6 +14,7 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
 #include <deque>
 #include <unordered_map>
 #include <unordered_set>
@@ -172,6 +173,15 @@ void ngraph::replace_node(std::shared_ptr<Node> target, std::shared_ptr<Node> re
 }
 
 // Check if all paths from X to a result go through Y
+NodeVector ngraph::get_users_in_creation_order(const Node* node)
+{
+    NodeVector users = node->get_users();
+    sort(users.begin(), users.end(), [](const shared_ptr<Node>& a, const shared_ptr<Node>& b) {
+        return a->get_instance_id() < b->get_instance_id();
+    });
+    return users;
+}
+
 bool ngraph::is_post_dominated(Node* X, Node* Y)
 {
     std::unordered_set<Node*> visited;
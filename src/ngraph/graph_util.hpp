@@ -75,6 +75,10 @@ namespace ngraph
 
     void replace_node(std::shared_ptr<Node> target, std::shared_ptr<Node> replacement);
 
+    /// \brief The users of node in the order they were created. Node::get_users follows the
+    /// addresses of the inputs, which vary from run to run.
+    NodeVector get_users_in_creation_order(const Node* node);
+
     template <typename T>
     std::list<std::shared_ptr<Node>> topological_sort(const T& nodes,
                                                       bool include_control_deps = false)
@@ -113,7 +117,7 @@ namespace ngraph
             result_list.push_back(node_map[independent_node]);
             independent_nodes.pop_front();
 
-            for (const std::shared_ptr<Node>& user : independent_node->get_users())
+            for (const std::shared_ptr<Node>& user : get_users_in_creation_order(independent_node))
             {
                 if (--node_dependency_count[user.get()] == 0)
                 {
@@ -191,7 +195,7 @@ namespace ngraph
             result_list.push_back(node_map[independent_node]);
             independent_nodes.pop_front();
 
-            for (const std::shared_ptr<Node>& user : independent_node->get_users())
+            for (const std::shared_ptr<Node>& user : get_users_in_creation_order(independent_node))
             {
                 if (--node_dependency_count[user.get()] == 0)
                 {
@@ -38,6 +38,13 @@ Node::Node(const std::string& node_type, const NodeVector& arguments, size_t out
     , m_instance_id(m_next_instance_id.fetch_add(1))
     , m_unique_name(description() + "_" + to_string(m_instance_id))
 {
+    size_t input_count = 0;
+    for (auto arg : arguments)
+    {
+        input_count += arg->m_outputs.size();
+    }
+    m_inputs.reserve(input_count);
+
     // Add this node as a user of each argument.
     size_t i = 0;
     for (auto arg : arguments)
@@ -73,6 +80,16 @@ void Node::delayed_validate_and_infer_types()
 void Node::set_output_size(size_t n)
 {
     NGRAPH_CHECK(n >= m_outputs.size(), "shrinking ", m_outputs.size(), " to ", n);
+    // Outputs that already have users are rebuilt in the new storage and their users repointed
+    m_outputs.reserve(n, [this](descriptor::Output& output, void* address) {
+        auto relocated =
+            new (address) descriptor::Output(this, output.get_index(), output.get_tensor_ptr());
+        for (descriptor::Input* input : output.get_inputs())
+        {
+            input->m_output = relocated;
+            relocated->add_input(input);
+        }
+    });
     for (size_t i = m_outputs.size(); i < n; ++i)
     {
         auto tensor_descriptor = make_shared<descriptor::Tensor>(
@@ -100,12 +117,12 @@ void Node::set_output_type(size_t i, const element::Type& element_type, const Pa
     m_outputs.at(i).get_tensor_ptr()->set_tensor_type(element_type, pshape);
 }
 
-std::deque<descriptor::Output>& Node::get_outputs()
+Node::OutputDescriptors& Node::get_outputs()
 {
     return m_outputs;
 }
 
-const std::deque<descriptor::Output>& Node::get_outputs() const
+const Node::OutputDescriptors& Node::get_outputs() const
 {
     return m_outputs;
 }
@@ -171,17 +188,25 @@ void Node::set_placement_index(size_t placement)
 
 const std::unordered_set<std::string>& Node::get_provenance_tags() const
 {
-    return m_provenance_tags;
+    static const std::unordered_set<std::string> no_tags;
+    return m_provenance_tags ? *m_provenance_tags : no_tags;
 }
 
 void Node::add_provenance_tag(const std::string& tag)
 {
-    m_provenance_tags.insert(tag);
+    if (!m_provenance_tags)
+    {
+        m_provenance_tags.reset(new std::unordered_set<std::string>());
+    }
+    m_provenance_tags->insert(tag);
 }
 
 void Node::remove_provenance_tag(const std::string& tag)
 {
-    m_provenance_tags.erase(tag);
+    if (m_provenance_tags)
+    {
+        m_provenance_tags->erase(tag);
+    }
 }
 
 void Node::merge_provenance_tags_from(const std::shared_ptr<const Node>& source)
@@ -232,6 +257,39 @@ const std::set<std::shared_ptr<Node>>& Node::get_control_dependencies() const
 void Node::add_control_dependency(std::shared_ptr<Node> node)
 {
     m_control_dependencies.insert(node);
+    topology_changed();
+}
+
+shared_ptr<TopologyObserver>
+    Node::set_topology_observer(const shared_ptr<TopologyObserver>& observer)
+{
+    // Held only long enough to swap a weak_ptr, so spin rather than give every node a mutex
+    while (m_topology_observer_lock.test_and_set(memory_order_acquire))
+    {
+    }
+    shared_ptr<TopologyObserver> replaced = m_topology_observer.lock();
+    m_topology_observer = observer;
+    m_has_topology_observer.store(true, memory_order_release);
+    m_topology_observer_lock.clear(memory_order_release);
+    return replaced == observer ? nullptr : replaced;
+}
+
+void Node::topology_changed()
+{
+    if (!m_has_topology_observer.load(memory_order_acquire))
+    {
+        return;
+    }
+    while (m_topology_observer_lock.test_and_set(memory_order_acquire))
+    {
+    }
+    shared_ptr<TopologyObserver> observer = m_topology_observer.lock();
+    m_topology_observer_lock.clear(memory_order_release);
+    // Notify without holding the lock, the observer may release nodes that notify in turn
+    if (observer)
+    {
+        observer->topology_changed();
+    }
 }
 
 std::vector<std::shared_ptr<Function>> Node::get_functions() const
@@ -20,6 +20,7 @@
 #include <deque>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <tuple>
@@ -32,6 +33,7 @@
 #include "ngraph/check.hpp"
 #include "ngraph/coordinate.hpp"
 #include "ngraph/deprecated.hpp"
+#include "ngraph/descriptor/descriptor_array.hpp"
 #include "ngraph/descriptor/input.hpp"
 #include "ngraph/descriptor/output.hpp"
 #include "ngraph/descriptor/tensor.hpp"
@@ -74,6 +76,15 @@ namespace ngraph
     /// Alias useful for cloning
     using NodeMap = std::unordered_map<ngraph::Node*, std::shared_ptr<ngraph::Node>>;
 
+    /// \brief Receives notice when an edge or control dependency of a node it was registered
+    /// with (see Node::add_topology_observer) is added or removed.
+    class TopologyObserver
+    {
+    public:
+        virtual ~TopologyObserver() {}
+        virtual void topology_changed() = 0;
+    };
+
     /// Nodes are the backbone of the graph of Value dataflow. Every node has
     /// zero or more nodes as arguments and one value, which is either a tensor
     /// or a (possibly empty) tuple of values.
@@ -200,18 +211,19 @@ namespace ngraph
         virtual std::ostream& write_short_description(std::ostream&) const;
         virtual std::ostream& write_long_description(std::ostream&) const;
 
-        std::deque<descriptor::Input>& get_inputs() NGRAPH_DEPRECATED("use inputs() instead")
+        using InputDescriptors = descriptor::DescriptorArray<descriptor::Input, 2>;
+        using OutputDescriptors = descriptor::DescriptorArray<descriptor::Output, 1>;
+
+        InputDescriptors& get_inputs() NGRAPH_DEPRECATED("use inputs() instead")
         {
             return m_inputs;
         }
-        const std::deque<descriptor::Input>& get_inputs() const
-            NGRAPH_DEPRECATED("use inputs() instead")
+        const InputDescriptors& get_inputs() const NGRAPH_DEPRECATED("use inputs() instead")
         {
             return m_inputs;
         }
-        std::deque<descriptor::Output>& get_outputs() NGRAPH_DEPRECATED("use outputs() instead");
-        const std::deque<descriptor::Output>& get_outputs() const
-            NGRAPH_DEPRECATED("use outputs() instead");
+        OutputDescriptors& get_outputs() NGRAPH_DEPRECATED("use outputs() instead");
+        const OutputDescriptors& get_outputs() const NGRAPH_DEPRECATED("use outputs() instead");
 
         /// Get control dependencies registered on the node
         const std::set<std::shared_ptr<Node>>& get_control_dependencies() const;
@@ -221,8 +233,19 @@ namespace ngraph
         void remove_control_dependency(std::shared_ptr<Node> node)
         {
             m_control_dependencies.erase(node);
+            topology_changed();
         }
 
+        /// \brief Registers the observer that is told when an edge or control dependency of this
+        /// node is added or removed. The node keeps a weak reference to a single observer.
+        /// \return The observer this one replaced, which is no longer told about changes, or
+        /// nullptr.
+        std::shared_ptr<TopologyObserver>
+            set_topology_observer(const std::shared_ptr<TopologyObserver>& observer);
+        /// \brief Tells the topology observers of this node that its edges have changed. Called
+        /// by the edge and control dependency mutators.
+        void topology_changed();
+
         /// Returns the number of outputs from the node.
         size_t get_output_size() const;
 
@@ -376,10 +399,15 @@ namespace ngraph
         std::string m_friendly_name;
         const std::string m_unique_name;
         static std::atomic<size_t> m_next_instance_id;
-        std::unordered_set<std::string> m_provenance_tags;
-        std::deque<descriptor::Input> m_inputs;
-        std::deque<descriptor::Output> m_outputs;
-        std::unordered_map<Node*, autodiff::Adjoints> m_adjoint_map;
+        // Tested before taking m_topology_observer_lock, so edge changes on nodes nobody
+        // observes never lock
+        std::atomic<bool> m_has_topology_observer{false};
+        std::atomic_flag m_topology_observer_lock = ATOMIC_FLAG_INIT;
+        std::weak_ptr<TopologyObserver> m_topology_observer;
+        // Most nodes have no provenance tags, so the set is only allocated once one is added
+        std::unique_ptr<std::unordered_set<std::string>> m_provenance_tags;
+        InputDescriptors m_inputs;
+        OutputDescriptors m_outputs;
         Placement m_placement = Placement::DEFAULT;
         size_t m_placement_index = placement_invalid;
     };
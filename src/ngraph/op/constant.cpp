@@ -157,9 +157,20 @@ vector<string> op::Constant::get_value_strings() const
 shared_ptr<Node> op::Constant::copy_with_new_args(const NodeVector& new_args) const
 {
     check_new_args_count(this, new_args);
+    if (m_data_owner)
+    {
+        return make_shared<Constant>(m_element_type, m_shape, m_external_data, m_data_owner);
+    }
     return make_shared<Constant>(m_element_type, m_shape, m_data->get_ptr());
 }
 
+void op::Constant::set_shared_data(const void* data, shared_ptr<void> data_owner)
+{
+    m_external_data = data;
+    m_data_owner = data_owner;
+    m_data.reset();
+}
+
 shared_ptr<op::Constant> op::ScalarConstantLikeBase::as_constant() const
 {
     return std::make_shared<op::Constant>(m_element_type, m_shape, m_data->get_ptr());
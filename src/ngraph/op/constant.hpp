@@ -118,6 +118,28 @@ namespace ngraph
                 constructor_validate_and_infer_types();
             }
 
+            /// \brief Constructs a tensor constant that uses data in place rather than copying it.
+            ///        This constructor is to support loading constants from a memory mapped model.
+            ///
+            /// \param type The element type of the tensor constant.
+            /// \param shape The shape of the tensor constant.
+            /// \param data A void* to constant data, which must stay unmodified.
+            /// \param data_owner Keeps data alive for as long as this constant, or any copy of it,
+            ///        exists.
+            Constant(const element::Type& type,
+                     const Shape& shape,
+                     const void* data,
+                     std::shared_ptr<void> data_owner)
+                : Node("Constant", {})
+                , m_element_type(type)
+                , m_shape(shape)
+                , m_data(nullptr)
+                , m_external_data(data)
+                , m_data_owner(data_owner)
+            {
+                constructor_validate_and_infer_types();
+            }
+
             virtual ~Constant() override;
 
             void validate_and_infer_types() override
@@ -169,7 +191,7 @@ namespace ngraph
                 }
 
                 std::vector<T> rc;
-                const T* p = reinterpret_cast<const T*>(m_data->get_ptr());
+                const T* p = get_data_ptr<T>();
                 for (size_t i = 0; i < shape_size(m_shape); i++)
                 {
                     rc.push_back(p[i]);
@@ -177,13 +199,23 @@ namespace ngraph
                 return rc;
             }
 
-            const void* get_data_ptr() const { return (m_data ? m_data->get_ptr() : nullptr); }
+            const void* get_data_ptr() const
+            {
+                return (m_data ? m_data->get_ptr() : m_external_data);
+            }
             template <typename T>
             const T* get_data_ptr() const
             {
                 return reinterpret_cast<const T*>(get_data_ptr());
             }
 
+            /// \brief Replaces this constant's copy of its data with data, which must hold the
+            ///        same bytes, and which data_owner keeps alive.
+            void set_shared_data(const void* data, std::shared_ptr<void> data_owner);
+            /// \brief Returns what keeps the data alive when it is not owned by this constant,
+            ///        such as a memory mapped model, or nullptr
+            const std::shared_ptr<void>& get_data_owner() const { return m_data_owner; }
+
             bool is_constant() const override { return true; }
         protected:
             void* get_data_ptr_nc() { return (m_data ? m_data->get_ptr() : nullptr); }
@@ -280,6 +312,9 @@ namespace ngraph
             element::Type m_element_type;
             Shape m_shape{};
             std::unique_ptr<runtime::AlignedBuffer> m_data;
+            // Data used in place when there is no m_data, kept alive by m_data_owner
+            const void* m_external_data{nullptr};
+            std::shared_ptr<void> m_data_owner;
             Constant(const Constant&) = delete;
             Constant operator=(const Constant&) = delete;
         };
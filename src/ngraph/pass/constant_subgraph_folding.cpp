@@ -0,0 +1,281 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "ngraph/graph_util.hpp"
+#include "ngraph/log.hpp"
+#include "ngraph/op/allreduce.hpp"
+#include "ngraph/op/broadcast_distributed.hpp"
+#include "ngraph/op/constant.hpp"
+#include "ngraph/op/experimental/generate_mask.hpp"
+#include "ngraph/op/parameter.hpp"
+#include "ngraph/pass/constant_subgraph_folding.hpp"
+#include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/tensor.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+namespace
+{
+    // One connected set of foldable ops and the ops in it whose values are used outside it
+    struct Subgraph
+    {
+        list<shared_ptr<Node>> nodes;
+        NodeVector roots;
+        // Constant arguments are passed in as parameters over their existing buffers
+        vector<shared_ptr<op::Constant>> constants;
+        ParameterVector parameters;
+        shared_ptr<runtime::Executable> executable;
+        vector<shared_ptr<runtime::Tensor>> inputs;
+        vector<shared_ptr<runtime::Tensor>> outputs;
+        bool failed = false;
+    };
+}
+
+#define TI(x) type_index(typeid(x))
+
+// Ops that must not be evaluated at compile time because they are random or communicate with
+// other processes
+static bool is_deterministic(const Node& node, const unordered_set<type_index>& excluded)
+{
+    static const unordered_set<type_index> nondeterministic{
+        TI(op::AllReduce), TI(op::BroadcastDistributed), TI(op::GenerateMask)};
+    return nondeterministic.count(TI(node)) == 0 && excluded.count(TI(node)) == 0;
+}
+
+static bool is_foldable(const shared_ptr<Node>& node,
+                        const unordered_set<Node*>& foldable,
+                        size_t max_constant_bytes,
+                        const unordered_set<type_index>& excluded,
+                        const runtime::Backend& backend)
+{
+    if (!node->is_op() || node->is_constant() || node->is_parameter() || node->is_output() ||
+        node->get_input_size() == 0 || node->get_output_size() != 1 ||
+        !node->get_control_dependencies().empty() || !is_deterministic(*node, excluded) ||
+        !backend.is_supported(*node))
+    {
+        return false;
+    }
+    if (node->get_output_partial_shape(0).is_dynamic() ||
+        node->get_output_element_type(0).is_dynamic() ||
+        shape_size(node->get_output_shape(0)) * node->get_output_element_type(0).size() >
+            max_constant_bytes)
+    {
+        return false;
+    }
+    for (auto arg : node->get_arguments())
+    {
+        if (!arg->is_constant() && foldable.count(arg.get()) == 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static Node* find_set(unordered_map<Node*, Node*>& parent, Node* node)
+{
+    while (parent[node] != node)
+    {
+        parent[node] = parent[parent[node]];
+        node = parent[node];
+    }
+    return node;
+}
+
+bool pass::ConstantSubgraphFolding::run_on_function(shared_ptr<Function> f)
+{
+    shared_ptr<runtime::Backend> backend;
+    try
+    {
+        backend = runtime::Backend::create(m_host_backend);
+    }
+    catch (const exception& e)
+    {
+        NGRAPH_DEBUG << "ConstantSubgraphFolding: backend " << m_host_backend
+                     << " is not available: " << e.what();
+        return false;
+    }
+
+    auto ordered_ops = f->get_ordered_ops();
+    unordered_set<Node*> foldable;
+    unordered_map<Node*, Node*> parent;
+    for (auto node : ordered_ops)
+    {
+        if (is_foldable(node, foldable, m_max_constant_bytes, m_excluded_op_types, *backend))
+        {
+            foldable.insert(node.get());
+            parent[node.get()] = node.get();
+            for (auto arg : node->get_arguments())
+            {
+                if (foldable.count(arg.get()) != 0)
+                {
+                    parent[find_set(parent, arg.get())] = find_set(parent, node.get());
+                }
+            }
+        }
+    }
+    if (foldable.empty())
+    {
+        return false;
+    }
+
+    // Group the foldable ops by connected component, in topological order
+    vector<Subgraph> subgraphs;
+    unordered_map<Node*, size_t> subgraph_index;
+    for (auto node : ordered_ops)
+    {
+        if (foldable.count(node.get()) == 0)
+        {
+            continue;
+        }
+        Node* set = find_set(parent, node.get());
+        auto it = subgraph_index.find(set);
+        if (it == subgraph_index.end())
+        {
+            it = subgraph_index.insert({set, subgraphs.size()}).first;
+            subgraphs.emplace_back();
+        }
+        Subgraph& subgraph = subgraphs[it->second];
+        subgraph.nodes.push_back(node);
+        for (auto user : node->get_users())
+        {
+            if (foldable.count(user.get()) == 0)
+            {
+                subgraph.roots.push_back(node);
+                break;
+            }
+        }
+    }
+
+    // Compiling is not guaranteed to be thread safe, so only execution is parallel
+    vector<Subgraph*> compiled;
+    for (Subgraph& subgraph : subgraphs)
+    {
+        if (subgraph.roots.empty())
+        {
+            continue;
+        }
+        // Subgraph nodes are in topological order, so every argument is cloned before its
+        // users. Constants become parameters that are fed from their own buffers, so large or
+        // mapped weights are never copied.
+        NodeMap node_map;
+        for (auto node : subgraph.nodes)
+        {
+            NodeVector cloned_args;
+            for (auto arg : node->get_arguments())
+            {
+                auto it = node_map.find(arg.get());
+                if (it == node_map.end())
+                {
+                    auto parameter =
+                        make_shared<op::Parameter>(arg->get_element_type(), arg->get_shape());
+                    subgraph.constants.push_back(static_pointer_cast<op::Constant>(arg));
+                    subgraph.parameters.push_back(parameter);
+                    it = node_map.insert({arg.get(), parameter}).first;
+                }
+                cloned_args.push_back(it->second);
+            }
+            node_map[node.get()] = node->copy_with_new_args(cloned_args);
+        }
+        NodeVector results;
+        for (auto root : subgraph.roots)
+        {
+            results.push_back(node_map.at(root.get()));
+        }
+        try
+        {
+            subgraph.executable =
+                backend->compile(make_shared<Function>(results, subgraph.parameters));
+            for (auto constant : subgraph.constants)
+            {
+                subgraph.inputs.push_back(
+                    backend->create_tensor(constant->get_element_type(),
+                                           constant->get_shape(),
+                                           const_cast<void*>(constant->get_data_ptr())));
+            }
+            for (auto root : subgraph.roots)
+            {
+                subgraph.outputs.push_back(backend->create_tensor(root->get_element_type(),
+                                                                  root->get_shape()));
+            }
+            compiled.push_back(&subgraph);
+        }
+        catch (const exception& e)
+        {
+            NGRAPH_DEBUG << "ConstantSubgraphFolding: skipping subgraph rooted at "
+                         << subgraph.roots.front()->get_name() << ": " << e.what();
+        }
+    }
+
+    size_t thread_count = max(1u, thread::hardware_concurrency());
+    vector<future<void>> workers;
+    atomic<size_t> next{0};
+    for (size_t i = 0; i < min(thread_count, compiled.size()); i++)
+    {
+        workers.push_back(async(launch::async, [&]() {
+            for (size_t j = next++; j < compiled.size(); j = next++)
+            {
+                // A subgraph that fails to execute is left in the graph, like one that fails
+                // to compile
+                try
+                {
+                    compiled[j]->executable->call(compiled[j]->outputs, compiled[j]->inputs);
+                }
+                catch (const exception& e)
+                {
+                    NGRAPH_DEBUG << "ConstantSubgraphFolding: skipping subgraph rooted at "
+                                 << compiled[j]->roots.front()->get_name() << ": " << e.what();
+                    compiled[j]->failed = true;
+                }
+            }
+        }));
+    }
+    for (auto& worker : workers)
+    {
+        worker.get();
+    }
+
+    bool replaced = false;
+    for (Subgraph* subgraph : compiled)
+    {
+        if (subgraph->failed)
+        {
+            continue;
+        }
+        for (size_t i = 0; i < subgraph->roots.size(); i++)
+        {
+            auto root = subgraph->roots[i];
+            auto& tensor = subgraph->outputs[i];
+            vector<char> data(tensor->get_size_in_bytes());
+            tensor->read(data.data(), 0, data.size());
+            replace_node(root,
+                         make_shared<op::Constant>(
+                             root->get_element_type(), root->get_shape(), data.data()));
+            replaced = true;
+        }
+    }
+    return replaced;
+}
@@ -0,0 +1,59 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <string>
+#include <typeindex>
+#include <unordered_set>
+
+#include "ngraph/pass/pass.hpp"
+
+namespace ngraph
+{
+    namespace pass
+    {
+        /// \brief Folds every maximal subgraph whose inputs are all Constants by executing it
+        ///     once and replacing its outputs with Constants.
+        ///
+        /// Unlike ConstantFolding this is not limited to particular ops: any deterministic op
+        /// the host backend supports is folded. Independent subgraphs are compiled on the
+        /// host backend, INTERPRETER by default, and executed in parallel. Ops whose outputs
+        /// would exceed max_constant_bytes are left in the graph, as are subgraphs the host
+        /// backend fails to compile or execute. Random and collective core ops are never
+        /// folded; backends add their own such ops to excluded_op_types.
+        class ConstantSubgraphFolding : public FunctionPass
+        {
+        public:
+            ConstantSubgraphFolding(
+                size_t max_constant_bytes = 16 * 1024 * 1024,
+                const std::string& host_backend = "INTERPRETER",
+                const std::unordered_set<std::type_index>& excluded_op_types = {})
+                : FunctionPass()
+                , m_max_constant_bytes(max_constant_bytes)
+                , m_host_backend(host_backend)
+                , m_excluded_op_types(excluded_op_types)
+            {
+            }
+            virtual bool run_on_function(std::shared_ptr<ngraph::Function> f) override;
+
+        private:
+            size_t m_max_constant_bytes;
+            std::string m_host_backend;
+            std::unordered_set<std::type_index> m_excluded_op_types;
+        };
+    }
+}
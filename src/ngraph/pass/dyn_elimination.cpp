@@ -0,0 +1,191 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <typeindex>
+#include <unordered_map>
+
+#include "ngraph/graph_util.hpp"
+#include "ngraph/op/broadcast.hpp"
+#include "ngraph/op/constant.hpp"
+#include "ngraph/op/experimental/dyn_broadcast.hpp"
+#include "ngraph/op/experimental/dyn_pad.hpp"
+#include "ngraph/op/experimental/dyn_reshape.hpp"
+#include "ngraph/op/experimental/dyn_slice.hpp"
+#include "ngraph/op/experimental/transpose.hpp"
+#include "ngraph/op/pad.hpp"
+#include "ngraph/op/reshape.hpp"
+#include "ngraph/op/slice.hpp"
+#include "ngraph/pass/dyn_elimination.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+// The values of input i of n if it is a Constant, otherwise false
+static bool get_constant_input(const shared_ptr<Node>& n, size_t i, vector<int64_t>& values)
+{
+    auto constant = dynamic_pointer_cast<op::Constant>(n->get_argument(i));
+    if (constant == nullptr)
+    {
+        return false;
+    }
+    values = constant->get_vector<int64_t>();
+    return true;
+}
+
+static shared_ptr<Node> eliminate_dyn_reshape(const shared_ptr<Node>& n)
+{
+    vector<int64_t> pattern;
+    if (!get_constant_input(n, 1, pattern))
+    {
+        return nullptr;
+    }
+    const Shape& arg_shape = n->get_input_shape(0);
+    Shape output_shape;
+    for (int64_t d : pattern)
+    {
+        NGRAPH_CHECK(d >= 0, "DynReshape pattern has a negative dimension");
+        output_shape.push_back(static_cast<size_t>(d));
+    }
+    NGRAPH_CHECK(shape_size(output_shape) == shape_size(arg_shape),
+                 "DynReshape pattern {",
+                 join(output_shape),
+                 "} does not match the element count of {",
+                 join(arg_shape),
+                 "}");
+    return make_shared<op::Reshape>(
+        n->get_argument(0), get_default_order(arg_shape.size()), output_shape);
+}
+
+static shared_ptr<Node> eliminate_transpose(const shared_ptr<Node>& n)
+{
+    vector<int64_t> order;
+    if (!get_constant_input(n, 1, order))
+    {
+        return nullptr;
+    }
+    const Shape& arg_shape = n->get_input_shape(0);
+    AxisVector input_order;
+    Shape output_shape;
+    for (int64_t axis : order)
+    {
+        NGRAPH_CHECK(axis >= 0 && static_cast<size_t>(axis) < arg_shape.size(),
+                     "Transpose input order has an out-of-range axis");
+        input_order.push_back(static_cast<size_t>(axis));
+        output_shape.push_back(arg_shape[axis]);
+    }
+    return make_shared<op::Reshape>(n->get_argument(0), input_order, output_shape);
+}
+
+static shared_ptr<Node> eliminate_dyn_slice(const shared_ptr<Node>& n)
+{
+    vector<int64_t> lower;
+    vector<int64_t> upper;
+    vector<int64_t> strides;
+    if (!get_constant_input(n, 1, lower) || !get_constant_input(n, 2, upper) ||
+        !get_constant_input(n, 3, strides))
+    {
+        return nullptr;
+    }
+    const Shape& arg_shape = n->get_input_shape(0);
+    Coordinate lower_bounds;
+    Coordinate upper_bounds;
+    Strides slice_strides;
+    // Negative bounds count from the end of the axis; bounds are clamped to the axis
+    auto clamp = [](int64_t bound, size_t size) {
+        int64_t dim = static_cast<int64_t>(size);
+        bound = bound < 0 ? bound + dim : bound;
+        return static_cast<size_t>(min(max(bound, int64_t(0)), dim));
+    };
+    for (size_t i = 0; i < arg_shape.size(); i++)
+    {
+        NGRAPH_CHECK(strides[i] > 0, "DynSlice strides must be positive");
+        lower_bounds.push_back(clamp(lower[i], arg_shape[i]));
+        upper_bounds.push_back(max(lower_bounds[i], clamp(upper[i], arg_shape[i])));
+        slice_strides.push_back(static_cast<size_t>(strides[i]));
+    }
+    return make_shared<op::Slice>(n->get_argument(0), lower_bounds, upper_bounds, slice_strides);
+}
+
+static shared_ptr<Node> eliminate_dyn_broadcast(const shared_ptr<Node>& n)
+{
+    vector<int64_t> shape;
+    vector<int64_t> axes;
+    if (!get_constant_input(n, 1, shape) || !get_constant_input(n, 2, axes))
+    {
+        return nullptr;
+    }
+    Shape output_shape;
+    for (int64_t d : shape)
+    {
+        NGRAPH_CHECK(d >= 0, "DynBroadcast shape has a negative dimension");
+        output_shape.push_back(static_cast<size_t>(d));
+    }
+    AxisSet broadcast_axes;
+    for (int64_t axis : axes)
+    {
+        NGRAPH_CHECK(axis >= 0, "DynBroadcast has a negative axis");
+        broadcast_axes.insert(static_cast<size_t>(axis));
+    }
+    return make_shared<op::Broadcast>(n->get_argument(0), output_shape, broadcast_axes);
+}
+
+static shared_ptr<Node> eliminate_dyn_pad(const shared_ptr<Node>& n)
+{
+    vector<int64_t> below;
+    vector<int64_t> above;
+    if (!get_constant_input(n, 1, below) || !get_constant_input(n, 2, above))
+    {
+        return nullptr;
+    }
+    return make_shared<op::Pad>(n->get_argument(0),
+                                n->get_argument(3),
+                                CoordinateDiff(below.begin(), below.end()),
+                                CoordinateDiff(above.begin(), above.end()));
+}
+
+bool pass::DynElimination::run_on_function(shared_ptr<Function> f)
+{
+    using Eliminator = shared_ptr<Node> (*)(const shared_ptr<Node>&);
+    static const unordered_map<type_index, Eliminator> eliminators{
+        {type_index(typeid(op::DynReshape)), eliminate_dyn_reshape},
+        {type_index(typeid(op::DynSlice)), eliminate_dyn_slice},
+        {type_index(typeid(op::DynBroadcast)), eliminate_dyn_broadcast},
+        {type_index(typeid(op::DynPad)), eliminate_dyn_pad},
+        {type_index(typeid(op::Transpose)), eliminate_transpose}};
+
+    bool changes_made = false;
+    for (auto n : f->get_ordered_ops())
+    {
+        // Earlier replacements may have made the shapes of this node's inputs static
+        if (changes_made)
+        {
+            n->revalidate_and_infer_types();
+        }
+        auto it = eliminators.find(type_index(typeid(*n)));
+        if (it == eliminators.end() || n->get_users().empty() ||
+            n->get_input_partial_shape(0).is_dynamic())
+        {
+            continue;
+        }
+        auto replacement = it->second(n);
+        if (replacement != nullptr)
+        {
+            replace_node(n, replacement);
+            changes_made = true;
+        }
+    }
+    return changes_made;
+}
@@ -0,0 +1,42 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include "ngraph/pass/pass.hpp"
+
+namespace ngraph
+{
+    namespace pass
+    {
+        /// \brief Replaces DynReshape, DynSlice, DynBroadcast, DynPad and Transpose with their
+        ///     static counterparts wherever the data input has a static shape and the
+        ///     shape-relevant inputs are Constants.
+        ///
+        /// Run after ShapeSpecialization and ConstantFolding have turned shape computations
+        /// into Constants. Nodes are revalidated in topological order as replacements are made,
+        /// so a chain of dynamic ops is eliminated in a single run.
+        class DynElimination : public FunctionPass
+        {
+        public:
+            DynElimination()
+                : FunctionPass()
+            {
+            }
+            virtual bool run_on_function(std::shared_ptr<ngraph::Function> f) override;
+        };
+    }
+}
@@ -17,11 +17,15 @@
 #include <algorithm>
 #include <iostream>
 #include <regex>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "graph_rewrite.hpp"
 #include "ngraph/log.hpp"
+#include "ngraph/pattern/op/pattern.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -58,6 +62,11 @@ using namespace ngraph;
 // c) there's no linear order of fusions which will give
 //    the correct final fusion. i.e. the same fusion needs to occur before and after some other fusion
 
+// Matchers are dispatched on the type of their pattern's root. A root that is a concrete op only
+// matches graph nodes of exactly the same type (see Matcher::match_node), so each node is only
+// offered to the matchers registered for its type plus the matchers whose root is a pattern op
+// such as Label or Any, which may match anything. Both lists hold indices into the matcher list,
+// and they are merged so that matchers still run in registration order.
 bool pass::GraphRewrite::run_on_function(shared_ptr<Function> f)
 {
     bool rewritten = false;
@@ -72,10 +81,47 @@ bool pass::GraphRewrite::run_on_function(shared_ptr<Function> f)
         // that need multiple passes. See comments above.
         vector<MatchClosure> matchers_to_run{m_matchers};
         m_matchers.clear();
+
+        unordered_map<type_index, vector<size_t>> typed_matchers;
+        vector<size_t> wildcard_matchers;
+        for (size_t i = 0; i < matchers_to_run.size(); i++)
+        {
+            auto pattern = matchers_to_run[i].matcher->get_pattern();
+            if (dynamic_pointer_cast<pattern::op::Pattern>(pattern))
+            {
+                wildcard_matchers.push_back(i);
+            }
+            else
+            {
+                typed_matchers[type_index(typeid(*pattern))].push_back(i);
+            }
+        }
+
+        vector<size_t> node_matchers;
         for (auto node : f->get_ordered_ops())
         {
-            for (auto& closure : matchers_to_run)
+            auto it = typed_matchers.find(type_index(typeid(*node)));
+            if (it == typed_matchers.end() && wildcard_matchers.empty())
+            {
+                continue;
+            }
+            node_matchers.clear();
+            if (it == typed_matchers.end())
+            {
+                node_matchers = wildcard_matchers;
+            }
+            else
+            {
+                merge(it->second.begin(),
+                      it->second.end(),
+                      wildcard_matchers.begin(),
+                      wildcard_matchers.end(),
+                      back_inserter(node_matchers));
+            }
+
+            for (size_t index : node_matchers)
             {
+                auto& closure = matchers_to_run[index];
                 if (is_dyn_func && closure.property[PassProperty::REQUIRE_STATIC_SHAPE])
                 {
                     NGRAPH_DEBUG << "matcher callback requires static shape but the "
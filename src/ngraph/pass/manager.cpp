@@ -19,22 +19,100 @@
 #else
 #include <cxxabi.h>
 #endif
+#include <cstdlib>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
 
 #include "ngraph/function.hpp"
 #include "ngraph/graph_util.hpp"
+#include "ngraph/log.hpp"
 #include "ngraph/node.hpp"
 #include "ngraph/pass/manager.hpp"
 #include "ngraph/pass/pass.hpp"
 #include "ngraph/pass/serialize.hpp"
 #include "ngraph/pass/visualize_tree.hpp"
+#include "ngraph/trace.hpp"
 #include "ngraph/util.hpp"
 
 using namespace std;
 using namespace ngraph;
 
+static string get_pass_name(pass::PassBase* p)
+{
+    string name = typeid(*p).name();
+#ifndef _WIN32
+    int status;
+    char* demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+    if (demangled != nullptr)
+    {
+        name = demangled;
+        free(demangled);
+    }
+#endif
+    return name;
+}
+
+static size_t count_nodes(const vector<shared_ptr<Function>>& functions)
+{
+    size_t count = 0;
+    for (const shared_ptr<Function>& f : functions)
+    {
+        count += f->get_ops().size();
+    }
+    return count;
+}
+
+// Resident set size of the process, or 0 where it is not available
+static int64_t get_resident_bytes()
+{
+    int64_t resident = 0;
+#if defined(__linux__)
+    ifstream statm("/proc/self/statm");
+    int64_t size = 0;
+    if (statm >> size >> resident)
+    {
+        resident *= sysconf(_SC_PAGESIZE);
+    }
+#endif
+    return resident;
+}
+
+static void print_pass_profile(const vector<pass::PassProfile>& profile, size_t total_ms)
+{
+    size_t name_width = 4;
+    for (const pass::PassProfile& p : profile)
+    {
+        name_width = max(name_width, p.name.size());
+    }
+    ios_base::fmtflags flags = cout.flags();
+    streamsize precision = cout.precision();
+    cout << left << setw(name_width + 2) << "pass" << right << setw(12) << "time (ms)" << setw(10)
+         << "nodes" << setw(10) << "delta" << setw(14) << "memory (KB)"
+         << "\n";
+    for (const pass::PassProfile& p : profile)
+    {
+        cout << left << setw(name_width + 2) << p.name << right << setw(12);
+        if (p.skipped)
+        {
+            cout << "skipped";
+        }
+        else
+        {
+            cout << fixed << setprecision(3) << p.milliseconds;
+        }
+        cout << setw(10) << p.node_count << setw(10) << p.node_delta << setw(14)
+             << p.memory_delta / 1024 << "\n";
+    }
+    cout << "passes done in " << total_ms << "ms\n";
+    cout.flags(flags);
+    cout.precision(precision);
+}
+
 pass::Manager::Manager()
 {
     static const auto nevt = std::getenv("NGRAPH_ENABLE_VISUALIZE_TRACING");
@@ -59,7 +137,8 @@ void pass::Manager::initialize_default_passes()
 
 void pass::Manager::run_passes(shared_ptr<Function> func, bool transitive)
 {
-    bool profile_enabled = getenv("NGRAPH_PROFILE_PASS_ENABLE") != nullptr;
+    bool profile_enabled = m_profile || getenv("NGRAPH_PROFILE_PASS_ENABLE") != nullptr;
+    size_t budget = m_pass_config.get_compile_time_budget();
 
     vector<std::pair<shared_ptr<Function>, bool>> fs;
     if (transitive)
@@ -83,13 +162,38 @@ void pass::Manager::run_passes(shared_ptr<Function> func, bool transitive)
     }
     get_state().set_functions(tfs);
 
+    static const uint32_t trace_category = trace::intern("Pass");
+    static const uint32_t trace_nodes = trace::intern("Nodes");
+    static const uint32_t trace_memory = trace::intern("ResidentBytes");
+    m_pass_profile.clear();
+    size_t node_count = profile_enabled ? count_nodes(f_array) : 0;
+    int64_t resident = profile_enabled ? get_resident_bytes() : 0;
+
     size_t index = 0;
     stopwatch pass_timer;
     stopwatch overall_timer;
     overall_timer.start();
     for (shared_ptr<PassBase> pass : m_pass_list)
     {
+        m_pass_profile.emplace_back();
+        PassProfile& profile = m_pass_profile.back();
+        if (profile_enabled)
+        {
+            profile.name = get_pass_name(pass.get());
+        }
+        profile.node_count = node_count;
+        if (budget != 0 && m_optional_passes.count(pass.get()) != 0 &&
+            overall_timer.get_milliseconds() >= budget)
+        {
+            NGRAPH_DEBUG << "Compile time budget of " << budget << "ms spent, skipping "
+                         << get_pass_name(pass.get());
+            profile.skipped = true;
+            index++;
+            continue;
+        }
+
         pass_timer.start();
+        uint64_t trace_start = trace::is_enabled() ? trace::now() : 0;
         pass->set_state(get_state());
         auto module_pass = dynamic_pointer_cast<ModulePass>(pass);
         auto function_pass = dynamic_pointer_cast<FunctionPass>(pass);
@@ -178,20 +282,33 @@ void pass::Manager::run_passes(shared_ptr<Function> func, bool transitive)
         }
         index++;
         pass_timer.stop();
+        profile.milliseconds = pass_timer.get_microseconds() / 1000.0;
         if (profile_enabled)
         {
-            PassBase* p = pass.get();
-            string name = typeid(*p).name();
-#ifndef _WIN32
-            int status;
-            name = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
-#endif
-            cout << setw(7) << pass_timer.get_milliseconds() << "ms " << name << "\n";
+            size_t new_node_count = count_nodes(f_array);
+            int64_t new_resident = get_resident_bytes();
+            profile.node_count = new_node_count;
+            profile.node_delta =
+                static_cast<int64_t>(new_node_count) - static_cast<int64_t>(node_count);
+            profile.memory_delta = new_resident - resident;
+            node_count = new_node_count;
+            resident = new_resident;
+        }
+        if (trace_start != 0)
+        {
+            uint64_t trace_end = trace::now();
+            const string& name = profile_enabled ? profile.name : get_pass_name(pass.get());
+            trace::record(trace_category, trace::intern(name), trace_start, trace_end);
+            if (profile_enabled)
+            {
+                trace::record_counter(trace_category, trace_nodes, trace_end, node_count);
+                trace::record_counter(trace_category, trace_memory, trace_end, resident);
+            }
         }
     }
     if (profile_enabled)
     {
-        cout << "passes done in " << overall_timer.get_milliseconds() << "ms\n";
+        print_pass_profile(m_pass_profile, overall_timer.get_milliseconds());
     }
 }
 
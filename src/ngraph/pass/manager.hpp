@@ -16,8 +16,11 @@
 
 #pragma once
 
+#include <cstdint>
 #include <list>
 #include <memory>
+#include <set>
+#include <string>
 #include <typeinfo>
 #include <vector>
 
@@ -31,6 +34,24 @@ namespace ngraph
     {
         class Manager;
         class ManagerState;
+
+        /// \brief What one pass cost in the last Manager::run_passes
+        struct PassProfile
+        {
+            /// Type name of the pass. Only set when pass profiling is enabled.
+            std::string name;
+            double milliseconds = 0;
+            /// Nodes in all functions after the pass, and the change it made. Only measured
+            /// when pass profiling is enabled.
+            size_t node_count = 0;
+            int64_t node_delta = 0;
+            /// Change in resident memory of the process across the pass, when available and
+            /// pass profiling is enabled
+            int64_t memory_delta = 0;
+            /// True if the pass was optional and skipped because the compile time budget was
+            /// spent
+            bool skipped = false;
+        };
     }
 }
 
@@ -64,8 +85,23 @@ public:
         }
     }
 
+    /// \brief Registers a pass that run_passes skips once the compile time budget set in the
+    ///     PassConfig is spent. Use it for optimizations the backend can do without.
+    template <typename T, class... Args>
+    void register_optional_pass(Args&&... args)
+    {
+        register_pass<T>(std::forward<Args>(args)...);
+        m_optional_passes.insert(m_pass_list.back().get());
+    }
+
     void run_passes(std::shared_ptr<Function>, bool transitive = true);
 
+    /// \brief Measures node count and memory changes of every pass and prints a table at the
+    ///     end of run_passes. Also enabled by NGRAPH_PROFILE_PASS_ENABLE.
+    void set_per_pass_profiling(bool enable) { m_profile = enable; }
+    /// \brief One entry per registered pass, in order, from the last run_passes
+    const std::vector<PassProfile>& get_pass_profile() const { return m_pass_profile; }
+
     ManagerState& get_state();
     PassConfig& get_pass_config() { return m_pass_config; }
     void set_pass_config(const PassConfig& pass_config) { m_pass_config = pass_config; }
@@ -74,6 +110,9 @@ public:
 private:
     std::vector<std::string> m_pass_names;
     std::vector<std::shared_ptr<PassBase>> m_pass_list;
+    std::set<PassBase*> m_optional_passes;
+    std::vector<PassProfile> m_pass_profile;
+    bool m_profile = false;
     ManagerState m_state;
     PassConfig m_pass_config;
     bool m_visualize = false;
@@ -14,14 +14,21 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
 #include <exception>
 #include <sstream>
+#include <unordered_map>
 
 #include "ngraph/log.hpp"
 #include "ngraph/log.hpp"
 #include "ngraph/op/concat.hpp"
 #include "ngraph/op/get_output_element.hpp"
+#include "ngraph/op/lrn.hpp"
 #include "ngraph/op/slice.hpp"
+#include "ngraph/op/softmax.hpp"
+#include "ngraph/op/util/binary_elementwise_arithmetic.hpp"
+#include "ngraph/op/util/binary_elementwise_logical.hpp"
+#include "ngraph/op/util/unary_elementwise_arithmetic.hpp"
 #include "ngraph/pass/liveness.hpp"
 #include "ngraph/pass/manager.hpp"
 #include "ngraph/pass/memory_layout.hpp"
@@ -30,9 +37,10 @@
 using namespace std;
 using namespace ngraph;
 
-pass::MemoryLayout::MemoryLayout(size_t alignment, bool disable_memory_sharing)
+pass::MemoryLayout::MemoryLayout(size_t alignment, bool disable_memory_sharing, Planner planner)
     : m_alignment(alignment)
     , m_disable_memory_sharing(disable_memory_sharing)
+    , m_planner(planner)
 {
     if (m_alignment == 0)
     {
@@ -40,9 +48,192 @@ pass::MemoryLayout::MemoryLayout(size_t alignment, bool disable_memory_sharing)
     }
 }
 
+pass::MemoryLayout::Planner pass::MemoryLayout::get_planner(const PassConfig& config)
+{
+    return config.get_pass_attribute("MemoryLayout::GreedyBySize") ? Planner::GREEDY_BY_SIZE
+                                                                    : Planner::FIRST_FIT;
+}
+
+namespace
+{
+    // Memory shared by a tensor and the tensors computed in place over it, live from the
+    // step that creates it to the last step that uses it
+    struct Buffer
+    {
+        size_t size;
+        size_t first;
+        size_t last;
+        size_t offset;
+    };
+}
+
+static size_t compute_lower_bound(const vector<Buffer>& buffers)
+{
+    // (step, size) events; at equal steps allocations sort before the frees of earlier buffers
+    vector<pair<size_t, int64_t>> events;
+    for (const Buffer& buffer : buffers)
+    {
+        events.push_back({2 * buffer.first, static_cast<int64_t>(buffer.size)});
+        events.push_back({2 * buffer.last + 1, -static_cast<int64_t>(buffer.size)});
+    }
+    sort(events.begin(), events.end());
+    int64_t live = 0;
+    int64_t rc = 0;
+    for (auto& event : events)
+    {
+        live += event.second;
+        rc = max(rc, live);
+    }
+    return static_cast<size_t>(rc);
+}
+
+namespace
+{
+    // Segment tree over steps. A buffer is listed at the nodes whose step ranges its lifetime
+    // covers and, as partial, at every ancestor of those, so a query visits only the buffers
+    // whose lifetimes overlap it.
+    class LifetimeIndex
+    {
+    public:
+        LifetimeIndex(size_t step_count)
+            : m_leaves(1)
+        {
+            while (m_leaves < step_count)
+            {
+                m_leaves <<= 1;
+            }
+            m_cover.resize(2 * m_leaves);
+            m_partial.resize(2 * m_leaves);
+        }
+
+        void insert(size_t index, size_t first, size_t last)
+        {
+            insert(1, 0, m_leaves - 1, index, first, last);
+        }
+
+        // Appends the buffers whose lifetimes overlap [first, last], some possibly repeated
+        void query(size_t first, size_t last, vector<size_t>& result) const
+        {
+            query(1, 0, m_leaves - 1, first, last, result);
+        }
+
+    private:
+        void insert(size_t node, size_t lo, size_t hi, size_t index, size_t first, size_t last)
+        {
+            if (first <= lo && hi <= last)
+            {
+                m_cover[node].push_back(index);
+                return;
+            }
+            m_partial[node].push_back(index);
+            size_t mid = (lo + hi) / 2;
+            if (first <= mid)
+            {
+                insert(2 * node, lo, mid, index, first, last);
+            }
+            if (last > mid)
+            {
+                insert(2 * node + 1, mid + 1, hi, index, first, last);
+            }
+        }
+
+        void query(size_t node,
+                   size_t lo,
+                   size_t hi,
+                   size_t first,
+                   size_t last,
+                   vector<size_t>& result) const
+        {
+            result.insert(result.end(), m_cover[node].begin(), m_cover[node].end());
+            if (first <= lo && hi <= last)
+            {
+                result.insert(result.end(), m_partial[node].begin(), m_partial[node].end());
+                return;
+            }
+            size_t mid = (lo + hi) / 2;
+            if (first <= mid)
+            {
+                query(2 * node, lo, mid, first, last, result);
+            }
+            if (last > mid)
+            {
+                query(2 * node + 1, mid + 1, hi, first, last, result);
+            }
+        }
+
+        size_t m_leaves;
+        vector<vector<size_t>> m_cover;
+        vector<vector<size_t>> m_partial;
+    };
+}
+
+// Places buffers largest first, each at the lowest offset that does not overlap a placed
+// buffer with an overlapping lifetime. Returns the pool size.
+static size_t place_greedy_by_size(vector<Buffer>& buffers)
+{
+    vector<size_t> order(buffers.size());
+    size_t step_count = 0;
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        order[i] = i;
+        step_count = max(step_count, buffers[i].last + 1);
+    }
+    stable_sort(order.begin(), order.end(), [&buffers](size_t a, size_t b) {
+        return buffers[a].size > buffers[b].size;
+    });
+
+    size_t pool_size = 0;
+    LifetimeIndex placed(step_count);
+    vector<size_t> overlapping;
+    vector<pair<size_t, size_t>> taken;
+    for (size_t index : order)
+    {
+        Buffer& buffer = buffers[index];
+        overlapping.clear();
+        placed.query(buffer.first, buffer.last, overlapping);
+        taken.clear();
+        for (size_t other_index : overlapping)
+        {
+            const Buffer& other = buffers[other_index];
+            taken.push_back({other.offset, other.offset + other.size});
+        }
+        sort(taken.begin(), taken.end());
+        size_t offset = 0;
+        for (auto& range : taken)
+        {
+            if (range.first >= offset + buffer.size)
+            {
+                break;
+            }
+            offset = max(offset, range.second);
+        }
+        buffer.offset = offset;
+        pool_size = max(pool_size, offset + buffer.size);
+        placed.insert(index, buffer.first, buffer.last);
+    }
+    return pool_size;
+}
+
+// Every backend computes each output element of these ops from the input elements at the same
+// index only, so the output may overwrite an input of the same shape and element type
+static bool is_pointwise(const Node& node)
+{
+    return (dynamic_cast<const op::util::UnaryElementwiseArithmetic*>(&node) ||
+            dynamic_cast<const op::util::BinaryElementwiseArithmetic*>(&node) ||
+            dynamic_cast<const op::util::BinaryElementwiseLogical*>(&node)) &&
+           !dynamic_cast<const op::Softmax*>(&node) && !dynamic_cast<const op::LRN*>(&node);
+}
+
 bool pass::MemoryLayout::run_on_function(shared_ptr<Function> function)
 {
     MemoryManager mm(m_alignment, m_disable_memory_sharing);
+    bool plan_offline = m_planner == Planner::GREEDY_BY_SIZE && !m_disable_memory_sharing;
+    vector<Buffer> buffers;
+    unordered_map<descriptor::Tensor*, size_t> tensor_buffer;
+    size_t step = 0;
+    // Tensors that share their buffer with a tensor that is still live, which must not be
+    // overwritten when they die
+    std::set<const descriptor::Tensor*> pass_through;
     for (shared_ptr<Node> node : function->get_ordered_ops())
     {
         std::map<descriptor::Tensor*, descriptor::Tensor*> in_place_outputs;
@@ -76,32 +267,100 @@ bool pass::MemoryLayout::run_on_function(shared_ptr<Function> function)
                                          << output->get_name();
                             in_place_outputs.insert({output, input});
                             reused_inputs.insert(input);
+                            if (node->liveness_free_list.count(input) == 0)
+                            {
+                                pass_through.insert(input);
+                                pass_through.insert(output);
+                            }
                         }
                     }
                 }
             }
         }
 
+        // Without backend annotations, a pointwise op writes its output over an input that
+        // dies here, which keeps long elementwise chains in one buffer
+        if (!m_disable_memory_sharing && in_place_outputs.empty() && is_pointwise(*node) &&
+            node->liveness_new_list.count(&node->output(0).get_tensor()) != 0)
+        {
+            auto output = &node->output(0).get_tensor();
+            for (auto& input : node->inputs())
+            {
+                auto input_tensor = &input.get_tensor();
+                if (node->liveness_free_list.count(input_tensor) != 0 &&
+                    pass_through.count(input_tensor) == 0 &&
+                    input.get_element_type() == node->get_output_element_type(0) &&
+                    input.get_shape() == node->get_output_shape(0))
+                {
+                    NGRAPH_DEBUG << "Reusing " << input_tensor->get_name() << " for "
+                                 << output->get_name();
+                    in_place_outputs.insert({output, input_tensor});
+                    reused_inputs.insert(input_tensor);
+                    break;
+                }
+            }
+        }
+
         for (descriptor::Tensor* tensor : node->liveness_new_list)
         {
-            size_t offset = in_place_outputs.count(tensor)
-                                ? in_place_outputs.at(tensor)->get_pool_offset()
-                                : mm.allocate(tensor->size());
-            tensor->set_pool_offset(offset);
+            auto in_place = in_place_outputs.find(tensor);
+            auto input_buffer = in_place != in_place_outputs.end()
+                                    ? tensor_buffer.find(in_place->second)
+                                    : tensor_buffer.end();
+            size_t buffer_index;
+            if (input_buffer != tensor_buffer.end())
+            {
+                buffer_index = input_buffer->second;
+                Buffer& buffer = buffers[buffer_index];
+                buffer.size = max(buffer.size, MemoryManager::align(tensor->size(), m_alignment));
+            }
+            else
+            {
+                buffer_index = buffers.size();
+                buffers.push_back(
+                    {MemoryManager::align(tensor->size(), m_alignment), step, step, 0});
+            }
+            tensor_buffer[tensor] = buffer_index;
+            if (!plan_offline)
+            {
+                size_t offset = in_place != in_place_outputs.end()
+                                    ? in_place->second->get_pool_offset()
+                                    : mm.allocate(tensor->size());
+                tensor->set_pool_offset(offset);
+            }
         }
 
         if (!m_disable_memory_sharing)
         {
-            for (const descriptor::Tensor* tensor : node->liveness_free_list)
+            for (descriptor::Tensor* tensor : node->liveness_free_list)
             {
-                if (reused_inputs.count(tensor) == 0)
+                Buffer& buffer = buffers[tensor_buffer.at(tensor)];
+                buffer.last = max(buffer.last, step);
+                if (reused_inputs.count(tensor) == 0 && !plan_offline)
                 {
                     mm.free(tensor->get_pool_offset());
                 }
             }
         }
+        step++;
+    }
+
+    if (plan_offline)
+    {
+        m_pool_size = place_greedy_by_size(buffers);
+        for (auto& tensor_and_buffer : tensor_buffer)
+        {
+            tensor_and_buffer.first->set_pool_offset(buffers[tensor_and_buffer.second].offset);
+        }
+    }
+    else
+    {
+        m_pool_size = mm.max_allocated();
     }
-    function->set_temporary_pool_size(mm.max_allocated());
+    m_lower_bound = m_disable_memory_sharing ? m_pool_size : compute_lower_bound(buffers);
+    NGRAPH_DEBUG << "MemoryLayout: pool size " << m_pool_size << " bytes, lower bound "
+                 << m_lower_bound << " bytes";
+    function->set_temporary_pool_size(m_pool_size);
 
     return false;
 }
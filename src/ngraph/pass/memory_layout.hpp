@@ -21,6 +21,7 @@
 #include <sstream>
 
 #include "ngraph/pass/pass.hpp"
+#include "ngraph/pass/pass_config.hpp"
 
 namespace ngraph
 {
@@ -35,12 +36,35 @@ namespace ngraph
 class ngraph::pass::MemoryLayout : public FunctionPass
 {
 public:
-    MemoryLayout(size_t alignment = 1, bool disable_memory_sharing = false);
+    /// \brief How tensors are placed in the temporary pool
+    enum class Planner
+    {
+        /// \brief Allocates in execution order from a free list, taking the first hole that fits
+        FIRST_FIT,
+        /// \brief Plans once all lifetimes are known: buffers are placed largest first, each
+        ///     at the lowest offset clear of every buffer whose lifetime overlaps it
+        GREEDY_BY_SIZE
+    };
+
+    MemoryLayout(size_t alignment = 1,
+                 bool disable_memory_sharing = false,
+                 Planner planner = Planner::FIRST_FIT);
     bool run_on_function(std::shared_ptr<ngraph::Function>) override;
 
+    /// \brief Temporary pool size of the last function planned
+    size_t get_pool_size() const { return m_pool_size; }
+    /// \brief Largest total size of the buffers live at once in the last function planned.
+    ///     No plan needs less memory than this.
+    size_t get_lower_bound() const { return m_lower_bound; }
+    /// \brief Returns GREEDY_BY_SIZE if the "MemoryLayout::GreedyBySize" attribute is set
+    static Planner get_planner(const PassConfig& config);
+
 private:
     size_t m_alignment;
     bool m_disable_memory_sharing;
+    Planner m_planner;
+    size_t m_pool_size = 0;
+    size_t m_lower_bound = 0;
 };
 
 class ngraph::pass::MemoryManager
@@ -40,7 +40,7 @@ bool pass::MemoryVisualize::run_on_module(vector<shared_ptr<Function>>& function
     {
         for (shared_ptr<Function> f : functions)
         {
-            list<shared_ptr<Node>> nodes = f->get_ordered_ops();
+            auto nodes = f->get_ordered_ops();
             file << "<!DOCTYPE html>\n<html>\n";
             file << "<head>\n";
             file << "    <style>\n";
@@ -78,6 +78,12 @@ pass::PassConfig::PassConfig()
             }
         }
     }
+    // NGRAPH_PASS_BUDGET_MS=500 stops optional passes once 500ms have been spent in run_passes
+    env_str = getenv("NGRAPH_PASS_BUDGET_MS");
+    if (env_str)
+    {
+        m_compile_time_budget = parse_string<size_t>(env_str);
+    }
 }
 
 void pass::PassConfig::set_pass_enable(const string& name, bool enable)
@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <map>
+#include <string>
 
 namespace ngraph
 {
@@ -36,8 +38,13 @@ public:
     const std::map<std::string, bool>& get_pass_attributes() const { return m_pass_attributes; }
     void set_pass_attribute(const std::string& name, bool enable);
     bool get_pass_attribute(const std::string& name) const;
+    /// \brief Wall time in milliseconds after which pass::Manager::run_passes skips the
+    ///     remaining optional passes, 0 for no limit
+    size_t get_compile_time_budget() const { return m_compile_time_budget; }
+    void set_compile_time_budget(size_t milliseconds) { m_compile_time_budget = milliseconds; }
 
 private:
     std::map<std::string, bool> m_pass_enables;
     std::map<std::string, bool> m_pass_attributes;
+    size_t m_compile_time_budget = 0;
 };
@@ -0,0 +1,48 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include "ngraph/pass/share_constants.hpp"
+#include "ngraph/op/constant.hpp"
+#include "ngraph/runtime/constant_store.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+bool pass::ShareConstants::run_on_function(shared_ptr<Function> f)
+{
+    auto& store = runtime::ConstantStore::get();
+    for (auto node : f->get_ordered_ops())
+    {
+        // ScalarConstantLike computes its data from its argument, so it is left alone
+        if (!node->is_constant() || dynamic_pointer_cast<op::ScalarConstantLikeBase>(node))
+        {
+            continue;
+        }
+        auto constant = static_pointer_cast<op::Constant>(node);
+        const element::Type& et = constant->get_element_type();
+        size_t size = shape_size(constant->get_shape()) * et.size();
+        // Data with an external owner, such as a memory mapped model, is shared in place
+        // rather than copied into the store
+        auto data = constant->get_data_owner()
+                        ? store.adopt(constant->get_data_ptr(),
+                                      size,
+                                      et.c_type_string(),
+                                      constant->get_data_owner())
+                        : store.intern(constant->get_data_ptr(), size, et.c_type_string());
+        constant->set_shared_data(data.get(), data);
+    }
+    return false;
+}
@@ -0,0 +1,376 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <cstring>
+#include <sstream>
+
+#include "ngraph/except.hpp"
+#include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/batch_bucketed_executable.hpp"
+#include "ngraph/runtime/tensor.hpp"
+#include "ngraph/specialize_shapes.hpp"
+#include "ngraph/util.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+// A partial shape whose first dimension, and only that one, is dynamic
+static bool is_batched(const PartialShape& shape)
+{
+    if (shape.rank().is_dynamic() || static_cast<size_t>(shape.rank()) == 0 ||
+        shape[0].is_static())
+    {
+        return false;
+    }
+    for (size_t i = 1; i < static_cast<size_t>(shape.rank()); i++)
+    {
+        if (shape[i].is_dynamic())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static Shape with_batch(const PartialShape& shape, size_t batch)
+{
+    Shape rc(static_cast<size_t>(shape.rank()));
+    rc[0] = batch;
+    for (size_t i = 1; i < rc.size(); i++)
+    {
+        rc[i] = static_cast<size_t>(shape[i]);
+    }
+    return rc;
+}
+
+runtime::BatchBucketedExecutable::BatchBucketedExecutable(
+    const shared_ptr<runtime::Backend>& backend,
+    const shared_ptr<Function>& function,
+    size_t max_cached,
+    bool enable_performance_data)
+    : m_backend(backend)
+    , m_function(function)
+    , m_max_cached(max_cached)
+    , m_enable_performance_data(enable_performance_data)
+{
+    if (m_max_cached == 0)
+    {
+        throw ngraph_error("BatchBucketedExecutable must be allowed to cache a specialization");
+    }
+    bool any_batched = false;
+    for (auto& parameter : m_function->get_parameters())
+    {
+        const PartialShape& shape = parameter->get_output_partial_shape(0);
+        bool batched = is_batched(shape);
+        if (!batched && shape.is_dynamic())
+        {
+            stringstream ss;
+            ss << "Parameter " << parameter->get_name() << " shape " << shape
+               << " may only be dynamic in its first dimension";
+            throw ngraph_error(ss.str());
+        }
+        if (parameter->get_element_type().is_dynamic())
+        {
+            throw ngraph_error("Parameter " + parameter->get_name() +
+                               " must have a static element type");
+        }
+        m_batched_inputs.push_back(batched);
+        any_batched |= batched;
+    }
+    if (!any_batched)
+    {
+        throw ngraph_error("BatchBucketedExecutable needs a Parameter with a dynamic batch size");
+    }
+    for (auto& result : m_function->get_results())
+    {
+        m_batched_outputs.push_back(is_batched(result->get_output_partial_shape(0)));
+    }
+    set_parameters_and_results(*m_function);
+}
+
+size_t runtime::BatchBucketedExecutable::get_bucket(size_t batch)
+{
+    size_t bucket = 1;
+    while (bucket < batch)
+    {
+        bucket <<= 1;
+    }
+    return bucket;
+}
+
+vector<size_t> runtime::BatchBucketedExecutable::get_cached_buckets() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return vector<size_t>(m_lru.begin(), m_lru.end());
+}
+
+vector<runtime::PerformanceCounter>
+    runtime::BatchBucketedExecutable::get_performance_data() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    vector<PerformanceCounter> rc;
+    if (!m_lru.empty())
+    {
+        rc = m_specializations.at(m_lru.front())->executable->get_performance_data();
+    }
+    return rc;
+}
+
+size_t runtime::BatchBucketedExecutable::get_batch(
+    const vector<shared_ptr<runtime::Tensor>>& inputs) const
+{
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        if (m_batched_inputs[i])
+        {
+            return inputs[i]->get_shape()[0];
+        }
+    }
+    throw ngraph_error("BatchBucketedExecutable has no batched input");
+}
+
+void runtime::BatchBucketedExecutable::validate(const vector<shared_ptr<runtime::Tensor>>& outputs,
+                                                const vector<shared_ptr<runtime::Tensor>>& inputs)
+{
+    const ParameterVector& parameters = get_parameters();
+    const ResultVector& results = get_results();
+    if (parameters.size() != inputs.size())
+    {
+        stringstream ss;
+        ss << "Call input count " << inputs.size() << " does not match Function's Parameter count "
+           << parameters.size();
+        throw runtime_error(ss.str());
+    }
+    if (results.size() != outputs.size())
+    {
+        stringstream ss;
+        ss << "Call output count " << outputs.size() << " does not match Function's Result count "
+           << results.size();
+        throw runtime_error(ss.str());
+    }
+
+    size_t batch = get_batch(inputs);
+    for (size_t i = 0; i < parameters.size(); i++)
+    {
+        const PartialShape& shape = parameters[i]->get_output_partial_shape(0);
+        if (parameters[i]->get_element_type() != inputs[i]->get_element_type())
+        {
+            stringstream ss;
+            ss << "Input " << i << " type '" << inputs[i]->get_element_type()
+               << "' does not match Parameter type '" << parameters[i]->get_element_type() << "'";
+            throw runtime_error(ss.str());
+        }
+        if (!PartialShape(inputs[i]->get_shape()).refines(shape) ||
+            (m_batched_inputs[i] && inputs[i]->get_shape()[0] != batch))
+        {
+            stringstream ss;
+            ss << "Input " << i << " shape {" << join(inputs[i]->get_shape())
+               << "} does not match Parameter shape " << shape << " with batch size " << batch;
+            throw runtime_error(ss.str());
+        }
+    }
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const PartialShape& shape = results[i]->get_output_partial_shape(0);
+        if (results[i]->get_element_type() != outputs[i]->get_element_type())
+        {
+            stringstream ss;
+            ss << "Output " << i << " type '" << outputs[i]->get_element_type()
+               << "' does not match Result type '" << results[i]->get_element_type() << "'";
+            throw runtime_error(ss.str());
+        }
+        if (!PartialShape(outputs[i]->get_shape()).refines(shape) ||
+            (m_batched_outputs[i] && outputs[i]->get_shape()[0] != batch))
+        {
+            stringstream ss;
+            ss << "Output " << i << " shape {" << join(outputs[i]->get_shape())
+               << "} does not match Result shape " << shape << " with batch size " << batch;
+            throw runtime_error(ss.str());
+        }
+    }
+}
+
+shared_ptr<runtime::BatchBucketedExecutable::Specialization>
+    runtime::BatchBucketedExecutable::compile_specialization(size_t bucket) const
+{
+    const ParameterVector& parameters = m_function->get_parameters();
+    vector<element::Type> types;
+    vector<PartialShape> shapes;
+    for (size_t i = 0; i < parameters.size(); i++)
+    {
+        const PartialShape& shape = parameters[i]->get_output_partial_shape(0);
+        types.push_back(parameters[i]->get_element_type());
+        shapes.push_back(m_batched_inputs[i] ? PartialShape(with_batch(shape, bucket)) : shape);
+    }
+    auto specialization = make_shared<Specialization>();
+    specialization->function = specialize_shapes(m_function, types, shapes);
+    const ResultVector& results = specialization->function->get_results();
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const Shape& shape = results[i]->get_shape();
+        if (m_batched_outputs[i] && shape[0] != bucket)
+        {
+            stringstream ss;
+            ss << "Result " << i << " shape {" << join(shape) << "} does not keep the batch size "
+               << bucket;
+            throw ngraph_error(ss.str());
+        }
+    }
+    specialization->executable =
+        m_backend->compile(specialization->function, m_enable_performance_data);
+    return specialization;
+}
+
+shared_ptr<runtime::BatchBucketedExecutable::Specialization>
+    runtime::BatchBucketedExecutable::get_specialization(size_t bucket)
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        auto it = m_specializations.find(bucket);
+        if (it != m_specializations.end())
+        {
+            m_lru.remove(bucket);
+            m_lru.push_front(bucket);
+            return it->second;
+        }
+    }
+
+    // Compile without holding the lock so that calls with other buckets keep running. If
+    // another call compiled the same bucket in the meantime its specialization wins.
+    shared_ptr<Specialization> specialization = compile_specialization(bucket);
+
+    lock_guard<mutex> lock(m_mutex);
+    auto it = m_specializations.find(bucket);
+    if (it != m_specializations.end())
+    {
+        m_lru.remove(bucket);
+        m_lru.push_front(bucket);
+        return it->second;
+    }
+    if (m_specializations.size() >= m_max_cached)
+    {
+        // Calls still running on the victim keep it alive through their shared_ptr
+        size_t victim = m_lru.back();
+        m_lru.pop_back();
+        m_backend->remove_compiled_function(m_specializations.at(victim)->executable);
+        m_specializations.erase(victim);
+    }
+    m_lru.push_front(bucket);
+    m_specializations[bucket] = specialization;
+    return specialization;
+}
+
+unique_ptr<runtime::BatchBucketedExecutable::PaddedArguments>
+    runtime::BatchBucketedExecutable::get_padded_arguments(Specialization& specialization)
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if (!specialization.free_arguments.empty())
+        {
+            unique_ptr<PaddedArguments> arguments = move(specialization.free_arguments.back());
+            specialization.free_arguments.pop_back();
+            return arguments;
+        }
+    }
+
+    unique_ptr<PaddedArguments> arguments(new PaddedArguments());
+    auto add = [this](bool batched,
+                      const element::Type& type,
+                      const Shape& shape,
+                      vector<unique_ptr<AlignedBuffer>>& buffers,
+                      vector<shared_ptr<runtime::Tensor>>& tensors) {
+        unique_ptr<AlignedBuffer> buffer;
+        shared_ptr<runtime::Tensor> tensor;
+        if (batched)
+        {
+            buffer.reset(new AlignedBuffer(shape_size(shape) * type.size(), s_alignment));
+            tensor = m_backend->create_tensor(type, shape, buffer->get_ptr());
+        }
+        buffers.push_back(move(buffer));
+        tensors.push_back(tensor);
+    };
+    const ParameterVector& parameters = specialization.function->get_parameters();
+    for (size_t i = 0; i < parameters.size(); i++)
+    {
+        add(m_batched_inputs[i],
+            parameters[i]->get_element_type(),
+            parameters[i]->get_shape(),
+            arguments->input_buffers,
+            arguments->inputs);
+    }
+    const ResultVector& results = specialization.function->get_results();
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        add(m_batched_outputs[i],
+            results[i]->get_element_type(),
+            results[i]->get_shape(),
+            arguments->output_buffers,
+            arguments->outputs);
+    }
+    return arguments;
+}
+
+bool runtime::BatchBucketedExecutable::call(const vector<shared_ptr<runtime::Tensor>>& outputs,
+                                            const vector<shared_ptr<runtime::Tensor>>& inputs)
+{
+    size_t batch = get_batch(inputs);
+    size_t bucket = get_bucket(batch);
+    shared_ptr<Specialization> specialization = get_specialization(bucket);
+    if (batch == bucket)
+    {
+        return specialization->executable->call(outputs, inputs);
+    }
+
+    // Every call pads into a set of bucket-sized tensors of its own, so calls run concurrently
+    unique_ptr<PaddedArguments> arguments = get_padded_arguments(*specialization);
+    vector<shared_ptr<runtime::Tensor>> padded_inputs = inputs;
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        if (m_batched_inputs[i])
+        {
+            AlignedBuffer& buffer = *arguments->input_buffers[i];
+            size_t size = inputs[i]->get_size_in_bytes();
+            inputs[i]->read(buffer.get_ptr(), 0, size);
+            memset(buffer.get_ptr(size), 0, buffer.size() - size);
+            padded_inputs[i] = arguments->inputs[i];
+        }
+    }
+    vector<shared_ptr<runtime::Tensor>> padded_outputs = outputs;
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        if (m_batched_outputs[i])
+        {
+            padded_outputs[i] = arguments->outputs[i];
+        }
+    }
+
+    bool rc = specialization->executable->call(padded_outputs, padded_inputs);
+
+    // The leading rows of a batched result are those of the unpadded batch
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        if (m_batched_outputs[i])
+        {
+            outputs[i]->write(
+                arguments->output_buffers[i]->get_ptr(), 0, outputs[i]->get_size_in_bytes());
+        }
+    }
+
+    lock_guard<mutex> lock(m_mutex);
+    specialization->free_arguments.push_back(move(arguments));
+    return rc;
+}
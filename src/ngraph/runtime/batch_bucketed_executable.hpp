@@ -0,0 +1,112 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ngraph/runtime/aligned_buffer.hpp"
+#include "ngraph/runtime/executable.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        class Backend;
+        class BatchBucketedExecutable;
+    }
+}
+
+/// \brief Runs a Function whose batch dimension is dynamic without compiling it per batch size.
+///
+/// Parameters whose first dimension is dynamic are batched; all their other dimensions must be
+/// static, as must every dimension of the remaining parameters. A call with batch size n runs
+/// the specialization of the Function for the smallest power of two that is at least n. Batched
+/// inputs are zero-padded up to that size and the first n rows of each batched result are
+/// copied out. This is only correct when batch rows do not interact, i.e. row i of every
+/// batched result depends only on row i of the batched inputs.
+///
+/// Specializations are created with specialize_shapes and compiled with the wrapped backend on
+/// first use. At most max_cached of them are kept; the least recently used one is removed from
+/// the backend to make room for a new one. The padded tensors wrap host memory, so the backend
+/// must accept host pointers in create_tensor. Calls may run concurrently.
+class ngraph::runtime::BatchBucketedExecutable : public runtime::Executable
+{
+public:
+    BatchBucketedExecutable(const std::shared_ptr<runtime::Backend>& backend,
+                            const std::shared_ptr<Function>& function,
+                            size_t max_cached = 4,
+                            bool enable_performance_data = false);
+
+    bool call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+              const std::vector<std::shared_ptr<runtime::Tensor>>& inputs) override;
+
+    /// \brief Checks element types and that every shape refines the Function's partial shape,
+    ///     with the same batch size on all batched inputs and outputs.
+    void validate(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                  const std::vector<std::shared_ptr<runtime::Tensor>>& inputs) override;
+
+    /// \brief Performance data of the most recently used specialization
+    std::vector<PerformanceCounter> get_performance_data() const override;
+
+    /// \brief The batch size of the specialization that runs a call with batch size batch
+    static size_t get_bucket(size_t batch);
+
+    /// \brief The batch sizes of the cached specializations, most recently used first
+    std::vector<size_t> get_cached_buckets() const;
+
+private:
+    /// \brief Bucket-sized tensors for the batched inputs and outputs of one call, null
+    ///     elsewhere, and the host buffers behind them
+    struct PaddedArguments
+    {
+        std::vector<std::unique_ptr<AlignedBuffer>> input_buffers;
+        std::vector<std::unique_ptr<AlignedBuffer>> output_buffers;
+        std::vector<std::shared_ptr<runtime::Tensor>> inputs;
+        std::vector<std::shared_ptr<runtime::Tensor>> outputs;
+    };
+
+    struct Specialization
+    {
+        std::shared_ptr<Function> function;
+        std::shared_ptr<Executable> executable;
+        // Padded arguments not in use by a call, guarded by m_mutex
+        std::vector<std::unique_ptr<PaddedArguments>> free_arguments;
+    };
+
+    std::shared_ptr<Specialization> compile_specialization(size_t bucket) const;
+    std::shared_ptr<Specialization> get_specialization(size_t bucket);
+    std::unique_ptr<PaddedArguments> get_padded_arguments(Specialization& specialization);
+    size_t get_batch(const std::vector<std::shared_ptr<runtime::Tensor>>& inputs) const;
+
+    std::shared_ptr<runtime::Backend> m_backend;
+    std::shared_ptr<Function> m_function;
+    size_t m_max_cached;
+    bool m_enable_performance_data;
+    std::vector<bool> m_batched_inputs;
+    std::vector<bool> m_batched_outputs;
+
+    // Guards the cache only; compiling and running a specialization happen outside of it
+    mutable std::mutex m_mutex;
+    std::map<size_t, std::shared_ptr<Specialization>> m_specializations;
+    // Buckets in m_specializations, most recently used first
+    std::list<size_t> m_lru;
+    static constexpr size_t s_alignment = 64;
+};
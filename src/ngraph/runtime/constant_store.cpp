@@ -0,0 +1,161 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <cstring>
+
+#include "ngraph/runtime/aligned_buffer.hpp"
+#include "ngraph/runtime/constant_store.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+// Word at a time multiply-rotate hash; collisions are resolved by comparing contents
+static uint64_t hash_bytes(const void* data, size_t size, const string& layout)
+{
+    const uint64_t k = 0x9E3779B97F4A7C15ULL;
+    uint64_t hash = size * k;
+    auto mix = [&hash, k](uint64_t word) {
+        hash ^= word * k;
+        hash = (hash << 31) | (hash >> 33);
+        hash *= 0xC2B2AE3D27D4EB4FULL;
+    };
+    const char* p = static_cast<const char*>(data);
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, p + i, sizeof(word));
+        mix(word);
+    }
+    if (i < size)
+    {
+        uint64_t tail = 0;
+        memcpy(&tail, p + i, size - i);
+        mix(tail);
+    }
+    for (char c : layout)
+    {
+        mix(static_cast<uint8_t>(c));
+    }
+    return hash;
+}
+
+runtime::ConstantStore& runtime::ConstantStore::get()
+{
+    // Never destroyed, so buffers released during static destruction can still be unregistered
+    static ConstantStore* store = new ConstantStore();
+    return *store;
+}
+
+shared_ptr<void>
+    runtime::ConstantStore::intern(const void* data, size_t size, const string& layout)
+{
+    uint64_t hash = hash_bytes(data, size, layout);
+    if (shared_ptr<void> rc = find(hash, data, size, layout))
+    {
+        return rc;
+    }
+
+    // Copy outside the lock; if another thread interned the same data meanwhile there are
+    // briefly two entries, which is harmless
+    AlignedBuffer* buffer = new AlignedBuffer(size, 64);
+    memcpy(buffer->get_ptr(), data, size);
+    shared_ptr<void> owner(buffer->get_ptr(), [hash, buffer](void* p) {
+        ConstantStore::get().release(p, hash);
+        delete buffer;
+    });
+    return insert(hash, owner, size, layout);
+}
+
+shared_ptr<void> runtime::ConstantStore::adopt(const void* data,
+                                               size_t size,
+                                               const string& layout,
+                                               shared_ptr<void> data_owner)
+{
+    uint64_t hash = hash_bytes(data, size, layout);
+    if (shared_ptr<void> rc = find(hash, data, size, layout))
+    {
+        return rc;
+    }
+
+    // The entry holds data_owner until its last user is gone
+    shared_ptr<void> owner(const_cast<void*>(data), [hash, data_owner](void* p) mutable {
+        ConstantStore::get().release(p, hash);
+        data_owner.reset();
+    });
+    return insert(hash, owner, size, layout);
+}
+
+shared_ptr<void> runtime::ConstantStore::find(uint64_t hash,
+                                              const void* data,
+                                              size_t size,
+                                              const string& layout) const
+{
+    lock_guard<mutex> lock(m_mutex);
+    auto range = m_entries.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        const Entry& entry = it->second;
+        if (entry.size == size && entry.layout == layout &&
+            (entry.data == data || memcmp(entry.data, data, size) == 0))
+        {
+            // An expired entry is about to be released by its deleter, so it is skipped
+            if (shared_ptr<void> owner = entry.owner.lock())
+            {
+                return owner;
+            }
+        }
+    }
+    return nullptr;
+}
+
+shared_ptr<void> runtime::ConstantStore::insert(uint64_t hash,
+                                                shared_ptr<void> owner,
+                                                size_t size,
+                                                const string& layout)
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_entries.insert({hash, Entry{layout, size, owner.get(), owner}});
+    m_byte_count += size;
+    return owner;
+}
+
+void runtime::ConstantStore::release(const void* data, uint64_t hash)
+{
+    lock_guard<mutex> lock(m_mutex);
+    auto range = m_entries.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second.data == data)
+        {
+            m_byte_count -= it->second.size;
+            m_entries.erase(it);
+            break;
+        }
+    }
+}
+
+size_t runtime::ConstantStore::get_entry_count() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+size_t runtime::ConstantStore::get_byte_count() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_byte_count;
+}
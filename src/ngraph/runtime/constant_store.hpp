@@ -0,0 +1,81 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        class ConstantStore;
+    }
+}
+
+/// \brief Process-wide store of read-only constant data, shared by every compiled executable.
+///
+/// Data is keyed on a hash of its contents and a layout string describing how the bytes are
+/// arranged, so identical weights are held once however many executables and backends use
+/// them. Entries are reference counted and freed when the last user releases them.
+class ngraph::runtime::ConstantStore
+{
+public:
+    static ConstantStore& get();
+
+    /// \brief Returns storage holding the size bytes at data, shared with every live result
+    ///     of an earlier call with the same contents and layout
+    std::shared_ptr<void> intern(const void* data, size_t size, const std::string& layout);
+
+    /// \brief Like intern, but when no earlier call matches, data is used in place instead of
+    ///     being copied. data_owner keeps data alive for as long as the result is in use.
+    std::shared_ptr<void> adopt(const void* data,
+                                size_t size,
+                                const std::string& layout,
+                                std::shared_ptr<void> data_owner);
+
+    /// \brief Number of distinct buffers currently held
+    size_t get_entry_count() const;
+    /// \brief Total size in bytes of the buffers currently held
+    size_t get_byte_count() const;
+
+private:
+    struct Entry
+    {
+        std::string layout;
+        size_t size;
+        const void* data;
+        std::weak_ptr<void> owner;
+    };
+
+    ConstantStore() = default;
+    std::shared_ptr<void>
+        find(uint64_t hash, const void* data, size_t size, const std::string& layout) const;
+    std::shared_ptr<void> insert(uint64_t hash,
+                                 std::shared_ptr<void> owner,
+                                 size_t size,
+                                 const std::string& layout);
+    void release(const void* data, uint64_t hash);
+
+    mutable std::mutex m_mutex;
+    std::unordered_multimap<uint64_t, Entry> m_entries;
+    size_t m_byte_count = 0;
+};
@@ -14,9 +14,12 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <cstring>
+
 #include "ngraph/op/allreduce.hpp"
 #include "ngraph/log.hpp"
 #include "ngraph/runtime/cpu/cpu_builder.hpp"
+#include "ngraph/runtime/cpu/op/allreduce_async.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -58,7 +61,52 @@ namespace ngraph
                 functors.emplace_back(functor);
             }
 
+            template <>
+            void Builder::BUILDER_DECL(ngraph::op::AllReduceStart)
+            {
+                auto& functors = external_function->get_functors();
+                auto arg_buffer_index = external_function->get_buffer_index(args[0].get_name());
+                auto out_buffer_index = external_function->get_buffer_index(out[0].get_name());
+                auto count = out[0].get_size();
+                auto data_type = args[0].get_element_type().get_type_enum();
+
+                auto functor = [&, count, data_type, arg_buffer_index, out_buffer_index](
+                    CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
+                    get_distributed_interface()->all_reduce_start(
+                        ctx->buffer_data[arg_buffer_index],
+                        ctx->buffer_data[out_buffer_index],
+                        data_type,
+                        count);
+                };
+                functors.emplace_back(functor);
+            }
+
+            template <>
+            void Builder::BUILDER_DECL(ngraph::op::AllReduceWait)
+            {
+                auto& functors = external_function->get_functors();
+                auto start_buffer_index = external_function->get_buffer_index(args[0].get_name());
+                auto out_buffer_index = external_function->get_buffer_index(out[0].get_name());
+                auto size = out[0].get_size() * out[0].get_element_type().size();
+
+                auto functor = [&, size, start_buffer_index, out_buffer_index](
+                    CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
+                    get_distributed_interface()->all_reduce_wait(
+                        ctx->buffer_data[start_buffer_index]);
+                    // The output normally shares the AllReduceStart's buffer
+                    if (ctx->buffer_data[start_buffer_index] != ctx->buffer_data[out_buffer_index])
+                    {
+                        memcpy(ctx->buffer_data[out_buffer_index],
+                               ctx->buffer_data[start_buffer_index],
+                               size);
+                    }
+                };
+                functors.emplace_back(functor);
+            }
+
             REGISTER_OP_BUILDER(AllReduce);
+            REGISTER_OP_BUILDER(AllReduceStart);
+            REGISTER_OP_BUILDER(AllReduceWait);
         }
     }
 }
@@ -19,7 +19,7 @@
 
 #include "ngraph/op/embedding_lookup.hpp"
 #include "ngraph/runtime/cpu/cpu_builder.hpp"
-#include "ngraph/runtime/reference/embedding_lookup.hpp"
+#include "ngraph/runtime/cpu/kernel/embedding_lookup.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -50,61 +50,21 @@ namespace ngraph
                 auto out_shape = out[0].get_shape();
                 auto element_type = out[0].get_element_type();
                 auto index_element_type = args[0].get_element_type();
+                std::function<decltype(runtime::cpu::kernel::embedding_lookup<float, float>)>
+                    kernel;
                 if (element_type == element::f32)
                 {
                     if (index_element_type == element::f32)
                     {
-                        functor = [&,
-                                   in_shape,
-                                   element_count,
-                                   arg0_buffer_index,
-                                   arg1_buffer_index,
-                                   out_buffer_index](CPURuntimeContext* ctx,
-                                                     CPUExecutionContext* ectx) {
-
-                            ngraph::runtime::reference::embedding<float, float>(
-                                static_cast<float*>(ctx->buffer_data[arg0_buffer_index]),
-                                static_cast<float*>(ctx->buffer_data[arg1_buffer_index]),
-                                static_cast<float*>(ctx->buffer_data[out_buffer_index]),
-                                element_count,
-                                in_shape);
-                        };
+                        kernel = runtime::cpu::kernel::embedding_lookup<float, float>;
                     }
                     else if (index_element_type == element::i32)
                     {
-                        functor = [&,
-                                   in_shape,
-                                   element_count,
-                                   arg0_buffer_index,
-                                   arg1_buffer_index,
-                                   out_buffer_index](CPURuntimeContext* ctx,
-                                                     CPUExecutionContext* ectx) {
-
-                            ngraph::runtime::reference::embedding<float, int>(
-                                static_cast<int*>(ctx->buffer_data[arg0_buffer_index]),
-                                static_cast<float*>(ctx->buffer_data[arg1_buffer_index]),
-                                static_cast<float*>(ctx->buffer_data[out_buffer_index]),
-                                element_count,
-                                in_shape);
-                        };
+                        kernel = runtime::cpu::kernel::embedding_lookup<float, int>;
                     }
                     else if (index_element_type == element::i64)
                     {
-                        functor = [&,
-                                   in_shape,
-                                   element_count,
-                                   arg0_buffer_index,
-                                   arg1_buffer_index,
-                                   out_buffer_index](CPURuntimeContext* ctx,
-                                                     CPUExecutionContext* ectx) {
-
-                            ngraph::runtime::reference::embedding<float, int64_t>(
-                                static_cast<int64_t*>(ctx->buffer_data[arg0_buffer_index]),
-                                static_cast<float*>(ctx->buffer_data[arg1_buffer_index]),
-                                static_cast<float*>(ctx->buffer_data[out_buffer_index]),
-                                element_count,
-                                in_shape);
-                        };
+                        kernel = runtime::cpu::kernel::embedding_lookup<float, int64_t>;
                     }
                     else
                     {
@@ -116,57 +76,15 @@ namespace ngraph
                 {
                     if (index_element_type == element::f32)
                     {
-                        functor = [&,
-                                   in_shape,
-                                   element_count,
-                                   arg0_buffer_index,
-                                   arg1_buffer_index,
-                                   out_buffer_index](CPURuntimeContext* ctx,
-                                                     CPUExecutionContext* ectx) {
-
-                            ngraph::runtime::reference::embedding<int, float>(
-                                static_cast<float*>(ctx->buffer_data[arg0_buffer_index]),
-                                static_cast<int*>(ctx->buffer_data[arg1_buffer_index]),
-                                static_cast<int*>(ctx->buffer_data[out_buffer_index]),
-                                element_count,
-                                in_shape);
-                        };
+                        kernel = runtime::cpu::kernel::embedding_lookup<int, float>;
                     }
                     else if (index_element_type == element::i32)
                     {
-                        functor = [&,
-                                   in_shape,
-                                   element_count,
-                                   arg0_buffer_index,
-                                   arg1_buffer_index,
-                                   out_buffer_index](CPURuntimeContext* ctx,
-                                                     CPUExecutionContext* ectx) {
-
-                            ngraph::runtime::reference::embedding<int, int>(
-                                static_cast<int*>(ctx->buffer_data[arg0_buffer_index]),
-                                static_cast<int*>(ctx->buffer_data[arg1_buffer_index]),
-                                static_cast<int*>(ctx->buffer_data[out_buffer_index]),
-                                element_count,
-                                in_shape);
-                        };
+                        kernel = runtime::cpu::kernel::embedding_lookup<int, int>;
                     }
                     else if (index_element_type == element::i64)
                     {
-                        functor = [&,
-                                   in_shape,
-                                   element_count,
-                                   arg0_buffer_index,
-                                   arg1_buffer_index,
-                                   out_buffer_index](CPURuntimeContext* ctx,
-                                                     CPUExecutionContext* ectx) {
-
-                            ngraph::runtime::reference::embedding<int, int64_t>(
-                                static_cast<int64_t*>(ctx->buffer_data[arg0_buffer_index]),
-                                static_cast<int*>(ctx->buffer_data[arg1_buffer_index]),
-                                static_cast<int*>(ctx->buffer_data[out_buffer_index]),
-                                element_count,
-                                in_shape);
-                        };
+                        kernel = runtime::cpu::kernel::embedding_lookup<int, int64_t>;
                     }
                     else
                     {
@@ -179,6 +97,21 @@ namespace ngraph
                     throw ngraph_error("Unsupported type in CPU Builder for EmbeddingLookup");
                 }
 
+                functor = [&,
+                           kernel,
+                           in_shape,
+                           element_count,
+                           arg0_buffer_index,
+                           arg1_buffer_index,
+                           out_buffer_index](CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
+                    kernel(ctx->buffer_data[arg0_buffer_index],
+                           ctx->buffer_data[arg1_buffer_index],
+                           ctx->buffer_data[out_buffer_index],
+                           element_count,
+                           in_shape,
+                           ectx->arena);
+                };
+
                 functors.emplace_back(functor);
             }
 
@@ -0,0 +1,209 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+
+#include "ngraph/op/abs.hpp"
+#include "ngraph/op/add.hpp"
+#include "ngraph/op/divide.hpp"
+#include "ngraph/op/exp.hpp"
+#include "ngraph/op/maximum.hpp"
+#include "ngraph/op/minimum.hpp"
+#include "ngraph/op/multiply.hpp"
+#include "ngraph/op/negative.hpp"
+#include "ngraph/op/relu.hpp"
+#include "ngraph/op/sigmoid.hpp"
+#include "ngraph/op/sqrt.hpp"
+#include "ngraph/op/subtract.hpp"
+#include "ngraph/op/tanh.hpp"
+#include "ngraph/runtime/cpu/cpu_builder.hpp"
+#include "ngraph/runtime/cpu/kernel/loop_kernel.hpp"
+#include "ngraph/runtime/cpu/op/loop_kernel.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+#define TI(x) type_index(typeid(x))
+
+using runtime::cpu::op::get_goe_input_output;
+
+// Compiles the nodes of a LoopKernel into instructions. Temporary slots are reused once the
+// value they hold has no more readers, so the scratch space is as small as the widest point
+// of the subgraph.
+static runtime::cpu::kernel::LoopKernelProgram
+    compile_loop_kernel(const runtime::cpu::op::LoopKernel* loop_kernel)
+{
+    using runtime::cpu::kernel::LoopKernelOpcode;
+    static const unordered_map<type_index, LoopKernelOpcode> opcodes{
+        {TI(ngraph::op::Abs), LoopKernelOpcode::Abs},
+        {TI(ngraph::op::Add), LoopKernelOpcode::Add},
+        {TI(ngraph::op::Divide), LoopKernelOpcode::Divide},
+        {TI(ngraph::op::Exp), LoopKernelOpcode::Exp},
+        {TI(ngraph::op::Maximum), LoopKernelOpcode::Maximum},
+        {TI(ngraph::op::Minimum), LoopKernelOpcode::Minimum},
+        {TI(ngraph::op::Multiply), LoopKernelOpcode::Multiply},
+        {TI(ngraph::op::Negative), LoopKernelOpcode::Negative},
+        {TI(ngraph::op::Relu), LoopKernelOpcode::Relu},
+        {TI(ngraph::op::Sigmoid), LoopKernelOpcode::Sigmoid},
+        {TI(ngraph::op::Sqrt), LoopKernelOpcode::Sqrt},
+        {TI(ngraph::op::Subtract), LoopKernelOpcode::Subtract},
+        {TI(ngraph::op::Tanh), LoopKernelOpcode::Tanh}};
+
+    const NodeVector& node_list = loop_kernel->get_node_list();
+    const NodeVector& output_nodes = loop_kernel->get_kernel_outputs();
+
+    runtime::cpu::kernel::LoopKernelProgram program;
+    program.input_count = loop_kernel->get_input_size();
+    program.output_count = output_nodes.size();
+
+    unordered_map<const descriptor::Output*, size_t> slots;
+    for (size_t i = 0; i < program.input_count; i++)
+    {
+        slots.emplace(&loop_kernel->get_inputs().at(i).get_output(), i);
+    }
+    for (size_t i = 0; i < program.output_count; i++)
+    {
+        slots.emplace(&output_nodes.at(i)->get_outputs().at(0), program.input_count + i);
+    }
+
+    // Index in node_list of the last reader of each value
+    unordered_map<const descriptor::Output*, size_t> last_reads;
+    for (size_t i = 0; i < node_list.size(); i++)
+    {
+        for (auto& input : node_list[i]->get_inputs())
+        {
+            last_reads[get_goe_input_output(&input.get_output())] = i;
+        }
+    }
+
+    size_t first_temporary = program.input_count + program.output_count;
+    vector<size_t> free_temporaries;
+    for (size_t i = 0; i < node_list.size(); i++)
+    {
+        const Node& node = *node_list[i];
+        auto opcode = opcodes.find(TI(node));
+        if (opcode == opcodes.end())
+        {
+            throw ngraph_error("Unsupported op '" + node.description() + "' in LoopKernel");
+        }
+        if (node.get_output_size() != 1)
+        {
+            throw ngraph_error("no multi-output ops in a LoopKernel");
+        }
+
+        runtime::cpu::kernel::LoopKernelInstruction instruction;
+        instruction.opcode = opcode->second;
+        vector<size_t> arg_slots;
+        for (auto& input : node.get_inputs())
+        {
+            arg_slots.push_back(slots.at(get_goe_input_output(&input.get_output())));
+        }
+        instruction.arg0 = arg_slots.at(0);
+        instruction.arg1 = arg_slots.size() > 1 ? arg_slots.at(1) : arg_slots.at(0);
+
+        // Temporaries whose last reader is this node can hold its result
+        for (auto& input : node.get_inputs())
+        {
+            auto value = get_goe_input_output(&input.get_output());
+            size_t slot = slots.at(value);
+            if (slot >= first_temporary && last_reads.at(value) == i &&
+                find(free_temporaries.begin(), free_temporaries.end(), slot) ==
+                    free_temporaries.end())
+            {
+                free_temporaries.push_back(slot);
+            }
+        }
+
+        const descriptor::Output* result = &node.get_outputs().at(0);
+        auto output_slot = slots.find(result);
+        if (output_slot != slots.end())
+        {
+            instruction.result = output_slot->second;
+        }
+        else if (!free_temporaries.empty())
+        {
+            instruction.result = free_temporaries.back();
+            free_temporaries.pop_back();
+            slots.emplace(result, instruction.result);
+        }
+        else
+        {
+            instruction.result = first_temporary + program.temporary_count++;
+            slots.emplace(result, instruction.result);
+        }
+        program.instructions.push_back(instruction);
+    }
+    return program;
+}
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            template <>
+            void Builder::BUILDER_DECL(ngraph::runtime::cpu::op::LoopKernel)
+            {
+                auto& functors = external_function->get_functors();
+                auto loop_kernel = static_cast<const ngraph::runtime::cpu::op::LoopKernel*>(node);
+                auto program = compile_loop_kernel(loop_kernel);
+
+                // Inputs then outputs, which the kernel reads straight out of buffer_data so
+                // that a call builds no pointer arrays
+                vector<size_t> buffer_indices;
+                for (auto& arg : args)
+                {
+                    buffer_indices.push_back(external_function->get_buffer_index(arg.get_name()));
+                }
+                for (auto& output : out)
+                {
+                    buffer_indices.push_back(
+                        external_function->get_buffer_index(output.get_name()));
+                }
+                size_t count = out[0].get_size();
+
+                std::function<decltype(runtime::cpu::kernel::loop_kernel<float>)> kernel;
+                auto element_type = out[0].get_element_type();
+                if (element_type == element::f32)
+                {
+                    kernel = runtime::cpu::kernel::loop_kernel<float>;
+                }
+                else if (element_type == element::f64)
+                {
+                    kernel = runtime::cpu::kernel::loop_kernel<double>;
+                }
+                else
+                {
+                    throw ngraph_error("Unsupported element type " + element_type.c_type_string() +
+                                       " for LoopKernel");
+                }
+
+                auto functor = [&, kernel, program, buffer_indices, count](
+                    CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
+                    kernel(program,
+                           ctx->buffer_data.data(),
+                           buffer_indices.data(),
+                           count,
+                           ectx->arena);
+                };
+                functors.emplace_back(functor);
+            }
+        }
+    }
+}
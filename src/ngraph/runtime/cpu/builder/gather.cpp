@@ -18,7 +18,7 @@
 
 #include "ngraph/op/gather.hpp"
 #include "ngraph/runtime/cpu/cpu_builder.hpp"
-#include "ngraph/runtime/reference/gather.hpp"
+#include "ngraph/runtime/cpu/kernel/gather.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -50,94 +50,28 @@ namespace ngraph
                 auto indices_shape = args[1].get_shape();
                 auto out_shape = out[0].get_shape();
                 auto element_type = args[0].get_element_type();
+
+                std::function<decltype(runtime::cpu::kernel::gather<float, int64_t>)> kernel;
                 if (element_type == element::f32)
                 {
                     if (is_int64)
                     {
-                        functor = [&,
-                                   params_shape,
-                                   indices_shape,
-                                   out_shape,
-                                   axis,
-                                   params_buffer_index,
-                                   indices_buffer_index,
-                                   out_buffer_index](CPURuntimeContext* ctx,
-                                                     CPUExecutionContext* ectx) {
-                            ngraph::runtime::reference::gather<float, int64_t>(
-                                static_cast<float*>(ctx->buffer_data[params_buffer_index]),
-                                static_cast<int64_t*>(ctx->buffer_data[indices_buffer_index]),
-                                static_cast<float*>(ctx->buffer_data[out_buffer_index]),
-                                params_shape,
-                                indices_shape,
-                                out_shape,
-                                axis);
-                        };
+                        kernel = runtime::cpu::kernel::gather<float, int64_t>;
                     }
                     else
                     {
-                        functor = [&,
-                                   params_shape,
-                                   indices_shape,
-                                   out_shape,
-                                   axis,
-                                   params_buffer_index,
-                                   indices_buffer_index,
-                                   out_buffer_index](CPURuntimeContext* ctx,
-                                                     CPUExecutionContext* ectx) {
-                            ngraph::runtime::reference::gather<float, int32_t>(
-                                static_cast<float*>(ctx->buffer_data[params_buffer_index]),
-                                static_cast<int32_t*>(ctx->buffer_data[indices_buffer_index]),
-                                static_cast<float*>(ctx->buffer_data[out_buffer_index]),
-                                params_shape,
-                                indices_shape,
-                                out_shape,
-                                axis);
-                        };
+                        kernel = runtime::cpu::kernel::gather<float, int32_t>;
                     }
                 }
                 else if (element_type == element::f64)
                 {
                     if (is_int64)
                     {
-                        functor = [&,
-                                   params_shape,
-                                   indices_shape,
-                                   out_shape,
-                                   axis,
-                                   params_buffer_index,
-                                   indices_buffer_index,
-                                   out_buffer_index](CPURuntimeContext* ctx,
-                                                     CPUExecutionContext* ectx) {
-                            ngraph::runtime::reference::gather<double, int64_t>(
-                                static_cast<double*>(ctx->buffer_data[params_buffer_index]),
-                                static_cast<int64_t*>(ctx->buffer_data[indices_buffer_index]),
-                                static_cast<double*>(ctx->buffer_data[out_buffer_index]),
-                                params_shape,
-                                indices_shape,
-                                out_shape,
-                                axis);
-                        };
+                        kernel = runtime::cpu::kernel::gather<double, int64_t>;
                     }
                     else
                     {
-                        functor = [&,
-                                   params_shape,
-                                   indices_shape,
-                                   out_shape,
-                                   axis,
-                                   params_buffer_index,
-                                   indices_buffer_index,
-                                   out_buffer_index](CPURuntimeContext* ctx,
-                                                     CPUExecutionContext* ectx) {
-                            ngraph::runtime::reference::gather<double, int32_t>(
-                                static_cast<double*>(ctx->buffer_data[params_buffer_index]),
-                                static_cast<int32_t*>(ctx->buffer_data[indices_buffer_index]),
-                                static_cast<double*>(ctx->buffer_data[out_buffer_index]),
-                                params_shape,
-                                indices_shape,
-                                out_shape,
-                                axis);
-                        };
+                        kernel = runtime::cpu::kernel::gather<double, int32_t>;
                     }
                 }
                 else
@@ -145,6 +79,25 @@ namespace ngraph
                     throw ngraph_error("Unsupported type in CPU Builder for Gather");
                 }
 
+                functor = [&,
+                           kernel,
+                           params_shape,
+                           indices_shape,
+                           out_shape,
+                           axis,
+                           params_buffer_index,
+                           indices_buffer_index,
+                           out_buffer_index](CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
+                    kernel(ctx->buffer_data[params_buffer_index],
+                           ctx->buffer_data[indices_buffer_index],
+                           ctx->buffer_data[out_buffer_index],
+                           params_shape,
+                           indices_shape,
+                           out_shape,
+                           axis,
+                           ectx->arena);
+                };
+
                 functors.emplace_back(functor);
             }
 
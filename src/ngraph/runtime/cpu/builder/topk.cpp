@@ -18,7 +18,7 @@
 
 #include "ngraph/op/topk.hpp"
 #include "ngraph/runtime/cpu/cpu_builder.hpp"
-#include "ngraph/runtime/reference/topk.hpp"
+#include "ngraph/runtime/cpu/kernel/topk.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -54,102 +54,28 @@ namespace ngraph
                 auto compute_max = topk->get_compute_max();
 
                 auto element_type = args[0].get_element_type();
+
+                std::function<decltype(runtime::cpu::kernel::topk<float, int64_t>)> kernel;
                 if (element_type == element::f32)
                 {
                     if (is_int64)
                     {
-                        functor = [&,
-                                   in_shape,
-                                   out_shape,
-                                   axis,
-                                   k,
-                                   compute_max,
-                                   arg_buffer_index,
-                                   out_indices_buffer_index,
-                                   out_values_buffer_index](CPURuntimeContext* ctx,
-                                                            CPUExecutionContext* ectx) {
-                            ngraph::runtime::reference::topk<float, int64_t>(
-                                static_cast<float*>(ctx->buffer_data[arg_buffer_index]),
-                                static_cast<int64_t*>(ctx->buffer_data[out_indices_buffer_index]),
-                                static_cast<float*>(ctx->buffer_data[out_values_buffer_index]),
-                                in_shape,
-                                out_shape,
-                                axis,
-                                k,
-                                compute_max);
-                        };
+                        kernel = runtime::cpu::kernel::topk<float, int64_t>;
                     }
                     else
                     {
-                        functor = [&,
-                                   in_shape,
-                                   out_shape,
-                                   axis,
-                                   k,
-                                   compute_max,
-                                   arg_buffer_index,
-                                   out_indices_buffer_index,
-                                   out_values_buffer_index](CPURuntimeContext* ctx,
-                                                            CPUExecutionContext* ectx) {
-                            ngraph::runtime::reference::topk<float, int32_t>(
-                                static_cast<float*>(ctx->buffer_data[arg_buffer_index]),
-                                static_cast<int32_t*>(ctx->buffer_data[out_indices_buffer_index]),
-                                static_cast<float*>(ctx->buffer_data[out_values_buffer_index]),
-                                in_shape,
-                                out_shape,
-                                axis,
-                                k,
-                                compute_max);
-                        };
+                        kernel = runtime::cpu::kernel::topk<float, int32_t>;
                     }
                 }
                 else if (element_type == element::f64)
                 {
                     if (is_int64)
                     {
-                        functor = [&,
-                                   in_shape,
-                                   out_shape,
-                                   axis,
-                                   k,
-                                   compute_max,
-                                   arg_buffer_index,
-                                   out_indices_buffer_index,
-                                   out_values_buffer_index](CPURuntimeContext* ctx,
-                                                            CPUExecutionContext* ectx) {
-                            ngraph::runtime::reference::topk<double, int64_t>(
-                                static_cast<double*>(ctx->buffer_data[arg_buffer_index]),
-                                static_cast<int64_t*>(ctx->buffer_data[out_indices_buffer_index]),
-                                static_cast<double*>(ctx->buffer_data[out_values_buffer_index]),
-                                in_shape,
-                                out_shape,
-                                axis,
-                                k,
-                                compute_max);
-                        };
+                        kernel = runtime::cpu::kernel::topk<double, int64_t>;
                     }
                     else
                     {
-                        functor = [&,
-                                   in_shape,
-                                   out_shape,
-                                   axis,
-                                   k,
-                                   compute_max,
-                                   arg_buffer_index,
-                                   out_indices_buffer_index,
-                                   out_values_buffer_index](CPURuntimeContext* ctx,
-                                                            CPUExecutionContext* ectx) {
-                            ngraph::runtime::reference::topk<double, int32_t>(
-                                static_cast<double*>(ctx->buffer_data[arg_buffer_index]),
-                                static_cast<int32_t*>(ctx->buffer_data[out_indices_buffer_index]),
-                                static_cast<double*>(ctx->buffer_data[out_values_buffer_index]),
-                                in_shape,
-                                out_shape,
-                                axis,
-                                k,
-                                compute_max);
-                        };
+                        kernel = runtime::cpu::kernel::topk<double, int32_t>;
                     }
                 }
                 else
@@ -157,6 +83,28 @@ namespace ngraph
                     throw ngraph_error("Unsupported type in CPU Builder for TopK");
                 }
 
+                functor = [&,
+                           kernel,
+                           in_shape,
+                           out_shape,
+                           axis,
+                           k,
+                           compute_max,
+                           arg_buffer_index,
+                           out_indices_buffer_index,
+                           out_values_buffer_index](CPURuntimeContext* ctx,
+                                                    CPUExecutionContext* ectx) {
+                    kernel(ctx->buffer_data[arg_buffer_index],
+                           ctx->buffer_data[out_indices_buffer_index],
+                           ctx->buffer_data[out_values_buffer_index],
+                           in_shape,
+                           out_shape,
+                           axis,
+                           k,
+                           compute_max,
+                           ectx->arena);
+                };
+
                 functors.emplace_back(functor);
             }
 
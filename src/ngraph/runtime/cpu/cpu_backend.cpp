@@ -119,6 +119,12 @@ runtime::cpu::CPU_Executable::CPU_Executable(shared_ptr<Function> func,
     set_parameters_and_results(*func);
 }
 
+size_t runtime::cpu::CPU_Executable::get_max_concurrent_calls() const
+{
+    const FunctionInstance& instance = m_function_instance;
+    return instance.m_call_frame ? instance.m_call_frame->get_num_contexts() : 1;
+}
+
 std::shared_ptr<ngraph::runtime::cpu::CPU_CallFrame> runtime::cpu::CPU_Executable::get_call_frame()
 {
     FunctionInstance& instance = m_function_instance;
@@ -73,11 +73,14 @@ namespace ngraph
                 CPU_Executable(std::shared_ptr<Function> func,
                                ngraph::pass::PassConfig& pass_config,
                                bool performance_counters_enabled);
+
                 bool call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
                           const std::vector<std::shared_ptr<runtime::Tensor>>& inputs) override;
 
                 std::shared_ptr<CPU_CallFrame> get_call_frame();
 
+                size_t get_max_concurrent_calls() const override;
+
                 std::vector<PerformanceCounter> get_performance_data() const override;
 
             private:
@@ -187,6 +187,8 @@ void runtime::cpu::CPU_CallFrame::setup_runtime_context()
         m_ctx_vec.push_back(ctx);
 
         ctx->pc = 0;
+        ctx->traced = false;
+        ctx->rank = -1;
         ctx->op_durations = nullptr;
         if (runtime::cpu::IsTracingEnabled())
         {
@@ -75,6 +75,10 @@ namespace ngraph
                 void setup_cg_runtime_context();
                 void cleanup_runtime_context();
 
+                /// \brief The number of calls that can run concurrently on this call frame,
+                /// set by NGRAPH_CPU_CONCURRENCY
+                size_t get_num_contexts() const { return m_num_ctx; }
+
             protected:
                 CPU_CallFrame(const CPU_CallFrame&) = delete;
                 CPU_CallFrame(CPU_CallFrame&&) = delete;
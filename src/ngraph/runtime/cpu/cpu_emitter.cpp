@@ -112,6 +112,7 @@
 #include "ngraph/runtime/cpu/cpu_kernel_emitters.hpp"
 #include "ngraph/runtime/cpu/cpu_op_annotations.hpp"
 #include "ngraph/runtime/cpu/mkldnn_utils.hpp"
+#include "ngraph/runtime/cpu/op/allreduce_async.hpp"
 #include "ngraph/runtime/cpu/op/batch_mat_mul_transpose.hpp"
 #include "ngraph/runtime/cpu/op/batch_norm_relu.hpp"
 #include "ngraph/runtime/cpu/op/bounded_relu.hpp"
@@ -212,6 +213,31 @@ namespace ngraph
                        << ", " << out[0].get_size() << ");\n";
             }
 
+            template <>
+            void CPU_Emitter::EMITTER_DECL(ngraph::op::AllReduceStart)
+            {
+                writer << "ngraph::get_distributed_interface()->all_reduce_start("
+                       << args[0].get_name() << ", " << out[0].get_name() << ", "
+                       << "ngraph::element::Type_t::" << args[0].get_element_type().get_type_name()
+                       << ", " << out[0].get_size() << ");\n";
+            }
+
+            template <>
+            void CPU_Emitter::EMITTER_DECL(ngraph::op::AllReduceWait)
+            {
+                writer << "ngraph::get_distributed_interface()->all_reduce_wait("
+                       << args[0].get_name() << ");\n";
+                if (args[0].get_name() != out[0].get_name())
+                {
+                    writer << "if (" << args[0].get_name() << " != " << out[0].get_name()
+                           << ")\n";
+                    writer.block_begin();
+                    writer << "memcpy(" << out[0].get_name() << ", " << args[0].get_name() << ", "
+                           << out[0].get_size() * out[0].get_element_type().size() << ");\n";
+                    writer.block_end();
+                }
+            }
+
             template <>
             void CPU_Emitter::EMITTER_DECL(ngraph::op::BroadcastDistributed)
             {
@@ -3670,6 +3696,17 @@ namespace ngraph
                 auto nege =
                     std::bind(emit_prefix_operator, std::string("-"), std::placeholders::_1);
                 auto sube = std::bind(emit_infix_operator, std::string("-"), std::placeholders::_1);
+                auto mule = std::bind(emit_infix_operator, std::string("*"), std::placeholders::_1);
+                auto dive = std::bind(emit_infix_operator, std::string("/"), std::placeholders::_1);
+                auto expe =
+                    std::bind(emit_function_call, std::string("std::exp"), std::placeholders::_1);
+                auto sqrte =
+                    std::bind(emit_function_call, std::string("std::sqrt"), std::placeholders::_1);
+                auto tanhe =
+                    std::bind(emit_function_call, std::string("std::tanh"), std::placeholders::_1);
+                auto sigmoide = [](const std::vector<std::string>& args) {
+                    return "1 / (1 + std::exp(-" + args.at(0) + "))";
+                };
 
                 return std::unordered_map<
                     std::type_index,
@@ -3681,6 +3718,12 @@ namespace ngraph
                     {TI(ngraph::op::Add), adde},
                     {TI(ngraph::op::Negative), nege},
                     {TI(ngraph::op::Subtract), sube},
+                    {TI(ngraph::op::Multiply), mule},
+                    {TI(ngraph::op::Divide), dive},
+                    {TI(ngraph::op::Exp), expe},
+                    {TI(ngraph::op::Sqrt), sqrte},
+                    {TI(ngraph::op::Tanh), tanhe},
+                    {TI(ngraph::op::Sigmoid), sigmoide},
                 };
             }
 
@@ -3688,20 +3731,6 @@ namespace ngraph
                                       std::function<std::string(const std::vector<std::string>&)>>
                 inline_emitters = initialize_inline_emitters();
 
-            // GOEE doesn't see GOEs in subgraphs that are hidden inside LoopKernels
-            // we have to manually propagate the source output
-            static const ngraph::descriptor::Output*
-                get_goe_input_output(ngraph::descriptor::Output* output)
-            {
-                auto it = output;
-                while (auto goe =
-                           std::dynamic_pointer_cast<ngraph::op::GetOutputElement>(it->get_node()))
-                {
-                    it = &goe->get_inputs().at(goe->get_n()).get_output();
-                }
-                return it;
-            }
-
             template <>
             void CPU_Emitter::EMITTER_DECL(ngraph::runtime::cpu::op::LoopKernel)
             {
@@ -3765,7 +3794,8 @@ namespace ngraph
                     {
                         // args are expected to be in a map already
                         sargs.push_back(
-                            loop_symbol_table.at(get_goe_input_output(&input.get_output())));
+                            loop_symbol_table.at(
+                                runtime::cpu::op::get_goe_input_output(&input.get_output())));
                     }
 
                     if (std::dynamic_pointer_cast<ngraph::op::Relu>(op_node))
@@ -14,6 +14,7 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
 #include <thread>
 
 #include "cpu_executor.hpp"
@@ -83,8 +84,10 @@ namespace ngraph
                         int num_threads_per_pool;
 
                         // Eigen threadpool will still be used for reductions
-                        // and other tensor operations that dont use a parallelFor
-                        num_threads_per_pool = GetNumCores();
+                        // and other tensor operations that dont use a parallelFor.
+                        // The pools can all be busy at once, under the inter-op scheduler or
+                        // with concurrent calls, so they split the cores between them.
+                        num_threads_per_pool = std::max(1, GetNumCores() / num_thread_pools);
 
                         // User override
                         char* eigen_tp_count = std::getenv("NGRAPH_CPU_EIGEN_THREAD_COUNT");
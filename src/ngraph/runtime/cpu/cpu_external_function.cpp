@@ -22,6 +22,7 @@
 #include <typeindex>
 #include <typeinfo>
 #include <unordered_map>
+#include <unordered_set>
 
 #define TBB_PREVIEW_FLOW_GRAPH_TRACE 1
 
@@ -29,12 +30,14 @@
 
 #if !defined(NGRAPH_DEX_ONLY)
 #include "ngraph/code_writer.hpp"
+#include "ngraph/codegen/compile_cache.hpp"
 #include "ngraph/codegen/compiler.hpp"
 #include "ngraph/codegen/execution_engine.hpp"
 #endif
 
 #include "ngraph/descriptor/input.hpp"
 #include "ngraph/descriptor/output.hpp"
+#include "ngraph/distributed.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/function.hpp"
 #include "ngraph/graph_util.hpp"
@@ -129,6 +132,7 @@
 #include "ngraph/pass/batch_fusion.hpp"
 #include "ngraph/pass/common_function_collection.hpp"
 #include "ngraph/pass/constant_folding.hpp"
+#include "ngraph/pass/constant_subgraph_folding.hpp"
 #include "ngraph/pass/core_fusion.hpp"
 #include "ngraph/pass/cse.hpp"
 #include "ngraph/pass/dump_sorted.hpp"
@@ -142,6 +146,7 @@
 #include "ngraph/pass/propagate_cacheability.hpp"
 #include "ngraph/pass/reshape_elimination.hpp"
 #include "ngraph/pass/reshape_sinking.hpp"
+#include "ngraph/pass/share_constants.hpp"
 #include "ngraph/pass/zero_dim_tensor_elimination.hpp"
 #include "ngraph/runtime/aligned_buffer.hpp"
 #include "ngraph/runtime/cpu/cpu_backend.hpp"
@@ -152,11 +157,13 @@
 #include "ngraph/runtime/cpu/cpu_executor.hpp"
 #include "ngraph/runtime/cpu/cpu_external_function.hpp"
 #include "ngraph/runtime/cpu/cpu_op_annotations.hpp"
+#include "ngraph/runtime/cpu/cpu_perf_events.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
 #include "ngraph/runtime/cpu/cpu_tracing.hpp"
 #include "ngraph/runtime/cpu/cpu_visualize_tree.hpp"
 #include "ngraph/runtime/cpu/mkldnn_emitter.hpp"
 #include "ngraph/runtime/cpu/mkldnn_utils.hpp"
+#include "ngraph/runtime/cpu/op/allreduce_async.hpp"
 #include "ngraph/runtime/cpu/op/batch_mat_mul_transpose.hpp"
 #include "ngraph/runtime/cpu/op/batch_norm_relu.hpp"
 #include "ngraph/runtime/cpu/op/bounded_relu.hpp"
@@ -174,11 +181,13 @@
 #include "ngraph/runtime/cpu/op/sigmoid.hpp"
 #include "ngraph/runtime/cpu/op/sigmoid_mul.hpp"
 #include "ngraph/runtime/cpu/op/update_slice.hpp"
+#include "ngraph/runtime/cpu/pass/cpu_allreduce_bucketing.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_assignment.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_collapse_dims.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_horizontal_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_layout.hpp"
+#include "ngraph/runtime/cpu/pass/cpu_loop_kernel_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_mat_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_memory_assignment.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_memory_optimization.hpp"
@@ -187,6 +196,7 @@
 #include "ngraph/runtime/cpu/pass/cpu_rnn_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_workspace_insertion.hpp"
 #include "ngraph/runtime/cpu/pass/halide_subgraph_extraction.hpp"
+#include "ngraph/trace.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -206,6 +216,21 @@ using namespace ngraph;
         pass_manager.register_pass<prefix::name>();                                                \
     }
 
+// Same as REGISTER_KNOBBED_PASS for optimizations that are skipped once the compile time
+// budget in the PassConfig is spent
+#define REGISTER_OPTIONAL_KNOBBED_PASS(name, enable_by_default, prefix)                            \
+    if (pass_map.find(STR(name)) != pass_map.end())                                                \
+    {                                                                                              \
+        if (pass_map[STR(name)])                                                                   \
+        {                                                                                          \
+            pass_manager.register_optional_pass<prefix::name>();                                   \
+        }                                                                                          \
+    }                                                                                              \
+    else if (enable_by_default)                                                                    \
+    {                                                                                              \
+        pass_manager.register_optional_pass<prefix::name>();                                       \
+    }
+
 #define REGISTER_KNOBBED_PASS_WITH_ARGS(name, enable_by_default, prefix, ...)                      \
     if (pass_map.find(STR(name)) != pass_map.end())                                                \
     {                                                                                              \
@@ -219,6 +244,19 @@ using namespace ngraph;
         pass_manager.register_pass<prefix::name>(__VA_ARGS__);                                     \
     }
 
+#define REGISTER_OPTIONAL_KNOBBED_PASS_WITH_ARGS(name, enable_by_default, prefix, ...)             \
+    if (pass_map.find(STR(name)) != pass_map.end())                                                \
+    {                                                                                              \
+        if (pass_map[STR(name)])                                                                   \
+        {                                                                                          \
+            pass_manager.register_optional_pass<prefix::name>(__VA_ARGS__);                        \
+        }                                                                                          \
+    }                                                                                              \
+    else if (enable_by_default)                                                                    \
+    {                                                                                              \
+        pass_manager.register_optional_pass<prefix::name>(__VA_ARGS__);                            \
+    }
+
 runtime::cpu::CPU_ExternalFunction::CPU_ExternalFunction(
     const shared_ptr<ngraph::Function>& function, bool release_function)
     : m_function(function)
@@ -295,6 +333,8 @@ static StaticInitializers s_static_initializers(s_output_dir);
 static const runtime::cpu::OpMap dispatcher{
     {TI(ngraph::op::Add), &runtime::cpu::CPU_Emitter::emit<op::Add>},
     {TI(ngraph::op::AllReduce), &runtime::cpu::CPU_Emitter::emit<op::AllReduce>},
+    {TI(ngraph::op::AllReduceStart), &runtime::cpu::CPU_Emitter::emit<op::AllReduceStart>},
+    {TI(ngraph::op::AllReduceWait), &runtime::cpu::CPU_Emitter::emit<op::AllReduceWait>},
     {TI(ngraph::op::BroadcastDistributed),
      &runtime::cpu::CPU_Emitter::emit<op::BroadcastDistributed>},
     {TI(ngraph::op::MatmulBias), &runtime::cpu::CPU_Emitter::emit<op::MatmulBias>},
@@ -644,8 +684,10 @@ using namespace ngraph::runtime;
                 m_active_constants.push_back(node);
                 shared_ptr<descriptor::Tensor> tv = node->get_outputs()[0].get_tensor_ptr();
                 string type = tv->get_element_type().c_type_string();
-                writer << "static " << type << "* " << tv->get_name() << " = ((" << type << "*)("
-                       << c->get_data_ptr() << "));\n";
+                // Constant data is bound after compilation by bind_constants so that the
+                // generated code does not depend on where the data lives, which lets compiled
+                // code be reused through the compile cache
+                writer << "static " << type << "* " << tv->get_name() << " = nullptr;\n";
 
                 auto output_tensor = &node->get_output_tensor();
                 auto tensor_set = get_tensor_set(output_tensor);
@@ -660,6 +702,17 @@ using namespace ngraph::runtime;
         }
     }
 
+    writer << "extern \"C\" void bind_constants(void** data)\n";
+    writer.block_begin();
+    for (size_t i = 0; i < m_active_constants.size(); i++)
+    {
+        auto tv = m_active_constants[i]->get_output_tensor_ptr(0);
+        writer << tv->get_name() << " = static_cast<" << tv->get_element_type().c_type_string()
+               << "*>(data[" << i << "]);\n";
+    }
+    writer.block_end();
+    writer << "\n";
+
     generate_class_declarations(writer);
 
     const char* func_params =
@@ -1064,15 +1117,45 @@ using namespace ngraph::runtime;
 
     m_compiler->set_precompiled_header_source(pch_header_source);
 
-    auto codegen_module = m_compiler->compile(code);
+    // With NGRAPH_CODEGEN_CACHE_DIR set, code compiled by any earlier process is reused
+    unique_ptr<codegen::Module> codegen_module;
+    string cache_key;
+    if (const char* cache_dir = std::getenv("NGRAPH_CODEGEN_CACHE_DIR"))
+    {
+        m_compile_cache.reset(new codegen::CompileCache(cache_dir));
+        cache_key = m_compile_cache->get_key(code, pch_header_source);
+        codegen_module = m_compile_cache->load(cache_key, code);
+        m_execution_engine->set_object_cache(m_compile_cache->get_object_cache());
+    }
 
     if (codegen_module == nullptr)
     {
-        throw runtime_error("function failed to compile");
+        codegen_module = m_compiler->compile(code);
+        if (codegen_module == nullptr)
+        {
+            throw runtime_error("function failed to compile");
+        }
+        if (m_compile_cache)
+        {
+            m_compile_cache->store(cache_key, code, *codegen_module);
+        }
     }
     m_execution_engine->add_module(codegen_module);
     m_execution_engine->finalize();
 
+    auto bind_constants = m_execution_engine->find_function<void(void**)>("bind_constants");
+    if (bind_constants == nullptr)
+    {
+        throw runtime_error("could not find compiled bind constants function");
+    }
+    vector<void*> constant_data;
+    for (auto& node : m_active_constants)
+    {
+        constant_data.push_back(const_cast<void*>(
+            static_pointer_cast<ngraph::op::Constant>(node)->get_data_ptr()));
+    }
+    bind_constants(constant_data.data());
+
     m_compiled_init_ctx_func = m_execution_engine->find_function<InitContextFuncTy>("init_cg_ctx");
 
     if (m_compiled_init_ctx_func == nullptr)
@@ -1144,6 +1227,7 @@ void runtime::cpu::CPU_ExternalFunction::register_common_passes(
     ngraph::pass::Manager& pass_manager, ngraph::pass::PassConfig& pass_config)
 {
     auto pass_map = pass_config.get_enables();
+    pass_manager.set_pass_config(pass_config);
 
     auto dex = is_direct_execution();
     auto is_supported = [dex](const Node& node) {
@@ -1174,23 +1258,26 @@ void runtime::cpu::CPU_ExternalFunction::register_common_passes(
     REGISTER_KNOBBED_PASS_WITH_ARGS(FusedOpDecomposition, true, ngraph::pass, is_supported);
     REGISTER_KNOBBED_PASS(NopElimination, true, ngraph::pass);
     REGISTER_KNOBBED_PASS(ZeroDimTensorElimination, true, ngraph::pass);
-    REGISTER_KNOBBED_PASS(LSTMFusion, true, runtime::cpu::pass);
-    REGISTER_KNOBBED_PASS(RNNFusion, true, runtime::cpu::pass);
-    REGISTER_KNOBBED_PASS(AlgebraicSimplification, true, ngraph::pass);
-    REGISTER_KNOBBED_PASS(MultiLayerRNNFusion, true, runtime::cpu::pass);
-    REGISTER_KNOBBED_PASS(BiDirectionalRnn, true, runtime::cpu::pass);
-    REGISTER_KNOBBED_PASS(CPURnnMatFusion, true, runtime::cpu::pass);
-    REGISTER_KNOBBED_PASS(BatchFusion, true, ngraph::pass);
-    REGISTER_KNOBBED_PASS(CPUBatchFusion, true, runtime::cpu::pass);
-    REGISTER_KNOBBED_PASS(ReshapeSinking, false, ngraph::pass);
-    REGISTER_KNOBBED_PASS(ReshapeElimination, false, ngraph::pass);
-    REGISTER_KNOBBED_PASS(CoreFusion, true, ngraph::pass);
-    REGISTER_KNOBBED_PASS(CPUFusion, true, runtime::cpu::pass);
-    REGISTER_KNOBBED_PASS(CPUQuantFusion, true, runtime::cpu::pass);
-    REGISTER_KNOBBED_PASS(CPUHorizontalFusion, true, runtime::cpu::pass);
-    REGISTER_KNOBBED_PASS(CPUCollapseDims, true, runtime::cpu::pass);
+    REGISTER_OPTIONAL_KNOBBED_PASS(LSTMFusion, true, runtime::cpu::pass);
+    REGISTER_OPTIONAL_KNOBBED_PASS(RNNFusion, true, runtime::cpu::pass);
+    REGISTER_OPTIONAL_KNOBBED_PASS(AlgebraicSimplification, true, ngraph::pass);
+    REGISTER_OPTIONAL_KNOBBED_PASS(MultiLayerRNNFusion, true, runtime::cpu::pass);
+    REGISTER_OPTIONAL_KNOBBED_PASS(BiDirectionalRnn, true, runtime::cpu::pass);
+    REGISTER_OPTIONAL_KNOBBED_PASS(CPURnnMatFusion, true, runtime::cpu::pass);
+    REGISTER_OPTIONAL_KNOBBED_PASS(BatchFusion, true, ngraph::pass);
+    REGISTER_OPTIONAL_KNOBBED_PASS(CPUBatchFusion, true, runtime::cpu::pass);
+    REGISTER_OPTIONAL_KNOBBED_PASS(ReshapeSinking, false, ngraph::pass);
+    REGISTER_OPTIONAL_KNOBBED_PASS(ReshapeElimination, false, ngraph::pass);
+    REGISTER_OPTIONAL_KNOBBED_PASS(CoreFusion, true, ngraph::pass);
+    REGISTER_OPTIONAL_KNOBBED_PASS(CPUFusion, true, runtime::cpu::pass);
+    REGISTER_OPTIONAL_KNOBBED_PASS(CPUQuantFusion, true, runtime::cpu::pass);
+    REGISTER_OPTIONAL_KNOBBED_PASS(CPUHorizontalFusion, true, runtime::cpu::pass);
+    REGISTER_OPTIONAL_KNOBBED_PASS(CPUCollapseDims, true, runtime::cpu::pass);
+    REGISTER_KNOBBED_PASS(CPUAllReduceBucketing, false, runtime::cpu::pass);
 #if defined(NGRAPH_HALIDE)
     REGISTER_KNOBBED_PASS(HalideSubgraphExtraction, true, ngraph::runtime::cpu::pass);
+#else
+    REGISTER_OPTIONAL_KNOBBED_PASS(CPULoopKernelFusion, false, runtime::cpu::pass);
 #endif
 
     NodeVector nv_cwi; // We dont need CPUWorkspaceInsertion to return list of indices
@@ -1198,6 +1285,12 @@ void runtime::cpu::CPU_ExternalFunction::register_common_passes(
     REGISTER_KNOBBED_PASS_WITH_ARGS(CPUAssignment, true, runtime::cpu::pass, this);
     REGISTER_KNOBBED_PASS_WITH_ARGS(
         ConstantFolding, true, ngraph::pass, GetGlobalCFDispatcherCPU());
+    // Collectives that only exist in CPU graphs, added by CPUAllReduceBucketing
+    unordered_set<type_index> cpu_collectives{TI(ngraph::op::AllReduceStart),
+                                              TI(ngraph::op::AllReduceWait)};
+    REGISTER_OPTIONAL_KNOBBED_PASS_WITH_ARGS(
+        ConstantSubgraphFolding, false, ngraph::pass, 16 * 1024 * 1024, "INTERPRETER",
+        cpu_collectives);
     REGISTER_KNOBBED_PASS_WITH_ARGS(CPULayout, true, runtime::cpu::pass, this);
     REGISTER_KNOBBED_PASS_WITH_ARGS(
         CommonSubexpressionElimination, true, ngraph::pass, runtime::cpu::get_cse_handlers_map());
@@ -1206,6 +1299,7 @@ void runtime::cpu::CPU_ExternalFunction::register_common_passes(
     REGISTER_KNOBBED_PASS(GetOutputElementElimination, false, ngraph::pass);
     REGISTER_KNOBBED_PASS_WITH_ARGS(
         PropagateCacheability, true, ngraph::pass, runtime::cpu::get_annotations_factory());
+    REGISTER_KNOBBED_PASS(ShareConstants, true, ngraph::pass);
     bool reuse_memory = pass_config.get_pass_attribute("CPUMemoryAssignment::ReuseMemory") ||
                         pass_config.get_pass_attribute("ReuseMemory");
     pass_manager.register_pass<runtime::cpu::pass::CPUMemoryAssignment>(
@@ -1228,6 +1322,126 @@ bool runtime::cpu::CPU_ExternalFunction::computes_result(Node* node)
     return false;
 }
 
+void runtime::cpu::CPU_ExternalFunction::build_scheduler()
+{
+    // Where each tensor lives, as a memory space and an offset into it. Space 0 is the
+    // intermediate pool, then come the function inputs and then the function outputs. Constants
+    // are never written, so reading them needs no ordering.
+    size_t num_inputs = m_function->get_parameters().size();
+    unordered_map<size_t, pair<size_t, size_t>> buffer_locations;
+    for (const auto& p : intermediates_offsets)
+    {
+        buffer_locations[p.first] = make_pair(0, p.second);
+    }
+    for (const auto& p : function_input_index_offset)
+    {
+        buffer_locations[get<0>(p)] = make_pair(1 + get<1>(p), get<2>(p));
+    }
+    for (const auto& p : function_output_index_offset)
+    {
+        buffer_locations[get<0>(p)] = make_pair(1 + num_inputs + get<1>(p), get<2>(p));
+    }
+
+    struct Access
+    {
+        size_t space;
+        size_t begin;
+        size_t end;
+        bool write;
+    };
+
+    executor::MemoryDependencies memory;
+    vector<vector<size_t>> successors;
+    vector<size_t> costs;
+    unordered_map<Node*, size_t> op_indices;
+    size_t last_collective = functors.size();
+    for (shared_ptr<Node> node : m_function->get_ordered_ops())
+    {
+        if (node->is_parameter() || node->is_constant())
+        {
+            continue;
+        }
+        size_t index = successors.size();
+        op_indices[node.get()] = index;
+        successors.emplace_back();
+
+        vector<Access> op_accesses;
+        size_t bytes = 0;
+        auto add_access = [&](const descriptor::Tensor& tv, bool write) {
+            bytes += tv.size();
+            auto it = buffer_locations.find(get_buffer_index(tv.get_name()));
+            if (it != buffer_locations.end())
+            {
+                op_accesses.push_back({it->second.first,
+                                       it->second.second,
+                                       it->second.second + std::max(tv.size(), size_t(1)),
+                                       write});
+            }
+        };
+        for (const descriptor::Input& input : node->get_inputs())
+        {
+            add_access(input.get_output().get_tensor(), false);
+        }
+        for (const descriptor::Output& output : node->get_outputs())
+        {
+            add_access(output.get_tensor(), true);
+        }
+
+        auto add_edge = [&](size_t from) {
+            if (successors[from].empty() || successors[from].back() != index)
+            {
+                successors[from].push_back(index);
+            }
+        };
+        for (auto arg : node->get_arguments())
+        {
+            auto it = op_indices.find(arg.get());
+            if (it != op_indices.end())
+            {
+                add_edge(it->second);
+            }
+        }
+        for (auto dep : node->get_control_dependencies())
+        {
+            auto it = op_indices.find(dep.get());
+            if (it != op_indices.end())
+            {
+                add_edge(it->second);
+            }
+        }
+        // Ops run in place and the memory planner reuses buffers, so an op must also wait for
+        // the last op that wrote what it touches and, where it writes, the ops that read since
+        for (bool write : {false, true})
+        {
+            for (const Access& access : op_accesses)
+            {
+                if (access.write == write)
+                {
+                    memory.access(index, access.space, access.begin, access.end, write, add_edge);
+                }
+            }
+        }
+        // Collectives must be issued in the same order on every process
+        auto& n = *node;
+        if (TI(n) == TI(op::AllReduce) || TI(n) == TI(op::AllReduceStart) ||
+            TI(n) == TI(op::AllReduceWait) || TI(n) == TI(op::BroadcastDistributed))
+        {
+            if (last_collective != functors.size())
+            {
+                add_edge(last_collective);
+            }
+            last_collective = index;
+        }
+
+        // Bytes touched is a rough stand-in for the work an op does
+        costs.push_back(bytes / 1024 + 1);
+    }
+    NGRAPH_CHECK(successors.size() == functors.size());
+
+    m_scheduler.reset(new executor::CPUScheduler(
+        successors, costs, executor::GetCPUExecutor().get_num_thread_pools()));
+}
+
 void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_config)
 {
     if (m_is_built)
@@ -1413,6 +1627,10 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
 
         m_op_attrs.emplace_back(node->description(), out_names, in_names);
         op_names.push_back(node->get_name());
+        if (trace::is_enabled())
+        {
+            m_op_trace_names.push_back(trace::intern(node->get_name()));
+        }
         handler->second(this, node.get(), in, out);
 
         auto cacheable = true;
@@ -1554,9 +1772,21 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
     //This check ensures we have exactly one functor for Op.
     NGRAPH_CHECK(m_op_attrs.size() == functors.size());
 
+    if (!m_use_tbb && executor::GetCPUExecutor().get_num_thread_pools() > 1)
+    {
+        build_scheduler();
+    }
+
     executor = [&](CPURuntimeContext* ctx, vector<void*>& inputs, vector<void*>& outputs) {
         cpu::Timestamp start_ts, end_ts;
         int profiler_count = 0;
+        const bool perf_events = m_emit_timing && runtime::cpu::IsPerfEventsEnabled();
+        // The first call of an op includes lazy setup such as MKLDNN primitive creation
+        static const uint32_t op_category = trace::intern("Op");
+        static const uint32_t first_call_category = trace::intern("OpFirstCall");
+        ctx->traced = m_op_trace_names.size() == functors.size() && trace::sample();
+        ctx->rank = distributed::get_thread_rank();
+        const uint32_t trace_category = ctx->first_iteration ? first_call_category : op_category;
 
         if (ctx->first_iteration)
         {
@@ -1603,15 +1833,34 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
                             *(ctx->G), [&, functor, index](const tbb::flow::continue_msg& msg) {
                                 if (p(ctx) || ctx->first_iteration)
                                 {
+                                    uint64_t trace_start = ctx->traced ? trace::now() : 0;
+                                    runtime::cpu::PerfEventCounts start_events, end_events;
+                                    bool counted = m_emit_timing &&
+                                                   runtime::cpu::IsPerfEventsEnabled() &&
+                                                   runtime::cpu::ReadPerfEvents(start_events);
                                     if (runtime::cpu::IsTracingEnabled() || m_emit_timing)
                                     {
                                         start_ts = cpu::Clock::now();
                                     }
+                                    distributed::set_thread_rank(ctx->rank);
                                     CPUExecutionContext ectx{0};
                                     executor::GetCPUExecutor().execute(*functor, ctx, &ectx, true);
+                                    if (ctx->traced)
+                                    {
+                                        trace::record(ctx->first_iteration ? first_call_category
+                                                                           : op_category,
+                                                      m_op_trace_names[index],
+                                                      trace_start,
+                                                      trace::now());
+                                    }
                                     if (runtime::cpu::IsTracingEnabled() || m_emit_timing)
                                     {
                                         end_ts = cpu::Clock::now();
+                                        if (counted && runtime::cpu::ReadPerfEvents(end_events))
+                                        {
+                                            runtime::cpu::AccumulatePerfEvents(
+                                                m_perf_counters[index], start_events, end_events);
+                                        }
 
                                         if (runtime::cpu::IsTracingEnabled())
                                         {
@@ -1720,6 +1969,75 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
                 }
             }
 
+            // Ops run concurrently once the first iteration has done their lazy setup, unless
+            // the debugger is stepping or another call is already using the scheduler
+            std::unique_lock<std::mutex> scheduler_lock;
+            if (m_scheduler && !ctx->first_iteration && ctx->pc == 0 &&
+                ctx->breakpoints.empty() && ddebug == nullptr)
+            {
+                scheduler_lock = std::unique_lock<std::mutex>(m_scheduler_mutex, std::try_to_lock);
+            }
+            if (scheduler_lock.owns_lock())
+            {
+                m_scheduler->run([&](size_t index, size_t worker) {
+                    if (!enables[index](ctx))
+                    {
+                        if (runtime::cpu::IsTracingEnabled())
+                        {
+                            ctx->op_durations[index] = 0;
+                        }
+                        if (m_emit_timing)
+                        {
+                            m_perf_counters[index].m_call_count++;
+                        }
+                        return;
+                    }
+                    uint64_t trace_start = ctx->traced ? trace::now() : 0;
+                    runtime::cpu::PerfEventCounts start_events, end_events;
+                    bool counted = perf_events && runtime::cpu::ReadPerfEvents(start_events);
+                    cpu::Timestamp op_start_ts, op_end_ts;
+                    if (runtime::cpu::IsTracingEnabled() || m_emit_timing)
+                    {
+                        op_start_ts = cpu::Clock::now();
+                    }
+                    distributed::set_thread_rank(ctx->rank);
+                    // Worker i runs its ops on Eigen thread pool i
+                    CPUExecutionContext ectx{static_cast<int>(worker)};
+                    executor::GetCPUExecutor().execute(functors[index], ctx, &ectx);
+                    if (ctx->traced)
+                    {
+                        trace::record(
+                            trace_category, m_op_trace_names[index], trace_start, trace::now());
+                    }
+                    if (runtime::cpu::IsTracingEnabled() || m_emit_timing)
+                    {
+                        op_end_ts = cpu::Clock::now();
+                        if (counted && runtime::cpu::ReadPerfEvents(end_events))
+                        {
+                            runtime::cpu::AccumulatePerfEvents(
+                                m_perf_counters[index], start_events, end_events);
+                        }
+                        if (runtime::cpu::IsTracingEnabled())
+                        {
+                            ctx->op_durations[index] =
+                                (std::chrono::duration_cast<cpu::Timescale>(op_end_ts -
+                                                                            op_start_ts))
+                                    .count();
+                        }
+                        if (m_emit_timing)
+                        {
+                            m_perf_counters[index].m_total_microseconds +=
+                                std::chrono::duration_cast<std::chrono::microseconds>(
+                                    op_end_ts - op_start_ts)
+                                    .count();
+                            m_perf_counters[index].m_call_count++;
+                        }
+                    }
+                });
+                profiler_count = static_cast<int>(functors.size());
+                ctx->pc = functors.size();
+            }
+
             for (; ctx->pc < functors.size(); ctx->pc++)
             {
                 auto index = profiler_count++;
@@ -1727,12 +2045,20 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
                 {
                     // Each Op will have exactly one functor, start the clock before the exceution of functor
                     // and collect the profiler_count once the execution complets
+                    uint64_t trace_start = ctx->traced ? trace::now() : 0;
+                    runtime::cpu::PerfEventCounts start_events, end_events;
+                    bool counted = perf_events && runtime::cpu::ReadPerfEvents(start_events);
                     if (runtime::cpu::IsTracingEnabled() || m_emit_timing)
                     {
                         start_ts = cpu::Clock::now();
                     }
                     CPUExecutionContext ectx{0};
                     executor::GetCPUExecutor().execute(functors.at(ctx->pc), ctx, &ectx);
+                    if (ctx->traced)
+                    {
+                        trace::record(
+                            trace_category, m_op_trace_names[index], trace_start, trace::now());
+                    }
                     if (ctx->breakpoints.count(ctx->pc + 1))
                     {
                         ctx->pc++;
@@ -1742,6 +2068,11 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
                     if (runtime::cpu::IsTracingEnabled() || m_emit_timing)
                     {
                         end_ts = cpu::Clock::now();
+                        if (counted && runtime::cpu::ReadPerfEvents(end_events))
+                        {
+                            runtime::cpu::AccumulatePerfEvents(
+                                m_perf_counters[index], start_events, end_events);
+                        }
 
                         if (runtime::cpu::IsTracingEnabled())
                         {
@@ -20,6 +20,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <typeindex>
 #include <typeinfo>
@@ -34,6 +35,7 @@
 #if !defined(NGRAPH_DEX_ONLY)
 
 #include "ngraph/code_writer.hpp"
+#include "ngraph/codegen/compile_cache.hpp"
 #include "ngraph/codegen/compiler.hpp"
 #include "ngraph/codegen/execution_engine.hpp"
 
@@ -45,6 +47,7 @@
 #include "ngraph/pass/pass_config.hpp"
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
 #include "ngraph/runtime/cpu/cpu_layout_descriptor.hpp"
+#include "ngraph/runtime/cpu/cpu_scheduler.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view_wrapper.hpp"
 #include "ngraph/runtime/cpu/mkldnn_emitter.hpp"
 #include "ngraph/runtime/performance_counter.hpp"
@@ -205,6 +208,8 @@ namespace ngraph
                                             ngraph::pass::PassConfig& pass_config);
 
                 bool computes_result(Node* node);
+                // Builds m_scheduler from the data, control and memory dependencies of the ops
+                void build_scheduler();
                 void release_function() { m_function = nullptr; }
 #if !defined(NGRAPH_DEX_ONLY)
                 void emit_debug_function_entry(CodeWriter& writer,
@@ -227,6 +232,8 @@ namespace ngraph
                 std::string emit_op_as_function(const Node&, const std::string& function_name);
                 std::string strip_comments(const std::string&);
 
+                // Owns the context of cached modules, so it must outlive m_execution_engine
+                std::unique_ptr<codegen::CompileCache> m_compile_cache;
                 std::unique_ptr<codegen::Compiler> m_compiler;
                 std::unique_ptr<codegen::ExecutionEngine> m_execution_engine;
 
@@ -277,6 +284,8 @@ namespace ngraph
 
                 std::vector<CPUKernelFunctor> functors;
                 std::vector<std::string> op_names;
+                // trace::intern ids of op_names, filled if tracing is enabled at build time
+                std::vector<uint32_t> m_op_trace_names;
                 std::vector<std::function<bool(CPURuntimeContext*)>> enables;
                 std::list<std::pair<std::function<bool(CPURuntimeContext*)>, std::string>>
                     enable_nodename_list;
@@ -320,6 +329,10 @@ namespace ngraph
                 std::unordered_map<std::string, std::shared_ptr<CPU_ExternalFunction>> callees;
                 bool m_is_built;
                 std::vector<runtime::PerformanceCounter> m_perf_counters;
+                // Runs DEX functors concurrently when there are several thread pools and TBB is
+                // not used. Only one call at a time may use it; the others run sequentially.
+                std::unique_ptr<executor::CPUScheduler> m_scheduler;
+                std::mutex m_scheduler_mutex;
 
 #if defined(NGRAPH_HALIDE)
                 std::unordered_map<std::string, Halide::Func> halide_functions;
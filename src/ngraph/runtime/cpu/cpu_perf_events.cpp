@@ -0,0 +1,147 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <cstdlib>
+#include <mutex>
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "ngraph/log.hpp"
+#include "ngraph/runtime/cpu/cpu_perf_events.hpp"
+
+using namespace ngraph;
+
+bool runtime::cpu::IsPerfEventsEnabled()
+{
+    static bool enabled = (std::getenv("NGRAPH_CPU_PERF_EVENTS") != nullptr);
+    return enabled;
+}
+
+void runtime::cpu::AccumulatePerfEvents(PerformanceCounter& counter,
+                                        const PerfEventCounts& start,
+                                        const PerfEventCounts& end)
+{
+    counter.m_hardware_counters = true;
+    counter.m_cycles += end.Cycles - start.Cycles;
+    counter.m_instructions += end.Instructions - start.Instructions;
+    counter.m_cache_misses += end.CacheMisses - start.CacheMisses;
+    counter.m_branch_misses += end.BranchMisses - start.BranchMisses;
+}
+
+#ifdef __linux__
+
+namespace
+{
+    // The four hardware events of one thread, opened as a group so that a single read returns
+    // consistent values
+    class PerfEventGroup
+    {
+    public:
+        PerfEventGroup()
+        {
+            const uint64_t events[event_count] = {PERF_COUNT_HW_CPU_CYCLES,
+                                                  PERF_COUNT_HW_INSTRUCTIONS,
+                                                  PERF_COUNT_HW_CACHE_MISSES,
+                                                  PERF_COUNT_HW_BRANCH_MISSES};
+            for (size_t i = 0; i < event_count; i++)
+            {
+                m_fds[i] = open_event(events[i], i == 0 ? -1 : m_fds[0]);
+                if (m_fds[i] == -1)
+                {
+                    return;
+                }
+            }
+            m_valid = ioctl(m_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) == 0;
+        }
+
+        ~PerfEventGroup()
+        {
+            for (int fd : m_fds)
+            {
+                if (fd != -1)
+                {
+                    close(fd);
+                }
+            }
+        }
+
+        bool is_valid() const { return m_valid; }
+        bool read_counts(runtime::cpu::PerfEventCounts& counts) const
+        {
+            // Layout of a PERF_FORMAT_GROUP read: the event count followed by one value per event
+            uint64_t values[1 + event_count];
+            if (read(m_fds[0], values, sizeof(values)) != sizeof(values))
+            {
+                return false;
+            }
+            counts.Cycles = values[1];
+            counts.Instructions = values[2];
+            counts.CacheMisses = values[3];
+            counts.BranchMisses = values[4];
+            return true;
+        }
+
+    private:
+        static const size_t event_count = 4;
+
+        static int open_event(uint64_t config, int group_fd)
+        {
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = config;
+            attr.disabled = group_fd == -1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP;
+            return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0));
+        }
+
+        int m_fds[event_count] = {-1, -1, -1, -1};
+        bool m_valid = false;
+    };
+}
+
+bool runtime::cpu::ReadPerfEvents(PerfEventCounts& counts)
+{
+    static thread_local PerfEventGroup group;
+    if (!group.is_valid())
+    {
+        static std::once_flag warned;
+        std::call_once(warned, []() {
+            NGRAPH_WARN << "Hardware performance counters are unavailable, check "
+                           "/proc/sys/kernel/perf_event_paranoid";
+        });
+        return false;
+    }
+    return group.read_counts(counts);
+}
+
+#else
+
+bool runtime::cpu::ReadPerfEvents(PerfEventCounts& counts)
+{
+    return false;
+}
+
+#endif
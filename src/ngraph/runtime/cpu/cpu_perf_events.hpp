@@ -0,0 +1,56 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstdint>
+
+#include "ngraph/runtime/performance_counter.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            struct PerfEventCounts
+            {
+                uint64_t Cycles = 0;
+                uint64_t Instructions = 0;
+                // Last level cache misses
+                uint64_t CacheMisses = 0;
+                uint64_t BranchMisses = 0;
+            };
+
+            /// \brief True if NGRAPH_CPU_PERF_EVENTS asks for hardware counters in per-op
+            ///     performance data
+            bool IsPerfEventsEnabled();
+
+            /// \brief Reads the user-space event counts of the calling thread, opening its
+            ///     counters on first use. Returns false if the counters are unavailable, for
+            ///     instance because kernel.perf_event_paranoid forbids them.
+            ///
+            /// Only the calling thread is counted, so work an op hands to other threads is
+            /// not included.
+            bool ReadPerfEvents(PerfEventCounts& counts);
+
+            /// \brief Adds the events counted between start and end to counter
+            void AccumulatePerfEvents(PerformanceCounter& counter,
+                                      const PerfEventCounts& start,
+                                      const PerfEventCounts& end);
+        }
+    }
+}
@@ -67,6 +67,10 @@ namespace ngraph
                 State* const* states;
                 std::set<size_t> breakpoints;
                 size_t pc;
+                // True while the current call records its ops with ngraph::trace
+                bool traced;
+                // distributed::get_thread_rank() of the calling thread, for ops run elsewhere
+                int rank;
             };
             }
 
@@ -0,0 +1,418 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <deque>
+#include <thread>
+
+#include "ngraph/except.hpp"
+#include "ngraph/runtime/cpu/cpu_scheduler.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+// Idle workers poll the queues this many times before going to sleep, since most ops finish
+// sooner than a sleeping thread can be woken
+#define SPIN_COUNT 64
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace executor
+            {
+                // Threads that run the helper workers of every scheduler, so that compiled
+                // functions do not each keep threads alive. It grows to the most helpers one
+                // run has asked for, and its threads sleep while there is nothing to do.
+                class HelperPool
+                {
+                public:
+                    static HelperPool& get()
+                    {
+                        static HelperPool pool;
+                        return pool;
+                    }
+
+                    ~HelperPool()
+                    {
+                        {
+                            lock_guard<mutex> lock(m_mutex);
+                            m_shutdown = true;
+                        }
+                        m_wake.notify_all();
+                        for (auto& thread : m_threads)
+                        {
+                            thread.join();
+                        }
+                    }
+
+                    void post(CPUScheduler* scheduler, size_t first_worker, size_t last_worker)
+                    {
+                        {
+                            lock_guard<mutex> lock(m_mutex);
+                            while (m_threads.size() < last_worker - first_worker)
+                            {
+                                m_threads.emplace_back(&HelperPool::loop, this);
+                            }
+                            for (size_t worker = first_worker; worker < last_worker; worker++)
+                            {
+                                m_tasks.emplace_back(scheduler, worker);
+                            }
+                        }
+                        m_wake.notify_all();
+                    }
+
+                    // Withdraws the tasks of scheduler that no thread has started, so that a
+                    // run never waits for helpers stuck behind other work, such as the run
+                    // of an outer function blocked on this one
+                    size_t cancel(CPUScheduler* scheduler)
+                    {
+                        lock_guard<mutex> lock(m_mutex);
+                        size_t size = m_tasks.size();
+                        m_tasks.erase(remove_if(m_tasks.begin(),
+                                                m_tasks.end(),
+                                                [scheduler](const pair<CPUScheduler*, size_t>& t) {
+                                                    return t.first == scheduler;
+                                                }),
+                                      m_tasks.end());
+                        return size - m_tasks.size();
+                    }
+
+                private:
+                    void loop()
+                    {
+                        while (true)
+                        {
+                            pair<CPUScheduler*, size_t> task;
+                            {
+                                unique_lock<mutex> lock(m_mutex);
+                                m_wake.wait(lock,
+                                            [this]() { return m_shutdown || !m_tasks.empty(); });
+                                if (m_shutdown)
+                                {
+                                    return;
+                                }
+                                task = m_tasks.front();
+                                m_tasks.pop_front();
+                            }
+                            task.first->work(task.second);
+                            task.first->helper_done();
+                        }
+                    }
+
+                    mutex m_mutex;
+                    condition_variable m_wake;
+                    deque<pair<CPUScheduler*, size_t>> m_tasks;
+                    vector<thread> m_threads;
+                    bool m_shutdown = false;
+                };
+            }
+        }
+    }
+}
+
+runtime::cpu::executor::CPUScheduler::CPUScheduler(const vector<vector<size_t>>& successors,
+                                                   const vector<size_t>& costs,
+                                                   size_t num_workers)
+    : m_successors(successors)
+    , m_predecessor_counts(successors.size(), 0)
+    , m_priorities(successors.size(), 0)
+    , m_pending(new atomic<size_t>[successors.size()])
+{
+    if (costs.size() != successors.size())
+    {
+        throw ngraph_error("CPUScheduler needs a cost for every op");
+    }
+    for (size_t op = 0; op < m_successors.size(); op++)
+    {
+        for (size_t successor : m_successors[op])
+        {
+            // Ops are given in a topological order, which lets priorities be computed in one
+            // backward sweep
+            if (successor <= op || successor >= m_successors.size())
+            {
+                throw ngraph_error("CPUScheduler successors must follow their op");
+            }
+            m_predecessor_counts[successor]++;
+        }
+    }
+    for (size_t op = m_successors.size(); op-- > 0;)
+    {
+        size_t longest_tail = 0;
+        for (size_t successor : m_successors[op])
+        {
+            longest_tail = max(longest_tail, m_priorities[successor]);
+        }
+        m_priorities[op] = costs[op] + longest_tail;
+    }
+    for (size_t op = 0; op < m_successors.size(); op++)
+    {
+        if (m_predecessor_counts[op] == 0)
+        {
+            m_sources.push_back(op);
+        }
+    }
+    stable_sort(m_sources.begin(), m_sources.end(), [this](size_t a, size_t b) {
+        return m_priorities[a] > m_priorities[b];
+    });
+
+    num_workers = max<size_t>(num_workers, 1);
+    for (size_t worker = 0; worker < num_workers; worker++)
+    {
+        m_queues.emplace_back(new Queue());
+    }
+}
+
+void runtime::cpu::executor::CPUScheduler::run(const function<void(size_t, size_t)>& execute)
+{
+    if (m_successors.empty())
+    {
+        return;
+    }
+    m_execute = &execute;
+    for (size_t op = 0; op < m_successors.size(); op++)
+    {
+        m_pending[op] = m_predecessor_counts[op];
+    }
+    m_remaining = m_successors.size();
+    m_failed = false;
+    m_exception = nullptr;
+    for (size_t i = 0; i < m_sources.size(); i++)
+    {
+        push(i % m_queues.size(), m_sources[i]);
+    }
+
+    // The calling thread can finish the run on its own, helpers only join in if the pool has
+    // threads to spare
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_active_helpers = m_queues.size() - 1;
+    }
+    HelperPool::get().post(this, 1, m_queues.size());
+    work(0);
+    size_t cancelled = HelperPool::get().cancel(this);
+    {
+        unique_lock<mutex> lock(m_mutex);
+        m_active_helpers -= cancelled;
+        m_done.wait(lock, [this]() { return m_active_helpers == 0; });
+    }
+    m_execute = nullptr;
+    if (m_exception)
+    {
+        rethrow_exception(m_exception);
+    }
+}
+
+void runtime::cpu::executor::CPUScheduler::helper_done()
+{
+    lock_guard<mutex> lock(m_mutex);
+    if (--m_active_helpers == 0)
+    {
+        m_done.notify_all();
+    }
+}
+
+void runtime::cpu::executor::CPUScheduler::work(size_t worker)
+{
+    size_t op = 0;
+    bool has_op = false;
+    size_t idle = 0;
+    while (m_remaining > 0)
+    {
+        if (!has_op)
+        {
+            has_op = pop(worker, op) || steal(worker, op);
+        }
+        if (!has_op)
+        {
+            if (++idle < SPIN_COUNT)
+            {
+                this_thread::yield();
+            }
+            else
+            {
+                unique_lock<mutex> lock(m_mutex);
+                m_sleeping++;
+                m_wake.wait(lock, [this]() { return m_ready > 0 || m_remaining == 0; });
+                m_sleeping--;
+                idle = 0;
+            }
+            continue;
+        }
+        idle = 0;
+
+        if (!m_failed)
+        {
+            try
+            {
+                (*m_execute)(op, worker);
+            }
+            catch (...)
+            {
+                lock_guard<mutex> lock(m_mutex);
+                if (!m_exception)
+                {
+                    m_exception = current_exception();
+                }
+                m_failed = true;
+            }
+        }
+
+        // Keep the most critical newly ready op on this worker and queue the others
+        size_t completed = op;
+        has_op = false;
+        for (size_t successor : m_successors[completed])
+        {
+            if (m_pending[successor].fetch_sub(1) != 1)
+            {
+                continue;
+            }
+            if (!has_op)
+            {
+                op = successor;
+                has_op = true;
+            }
+            else if (m_priorities[successor] > m_priorities[op])
+            {
+                push(worker, op);
+                op = successor;
+            }
+            else
+            {
+                push(worker, successor);
+            }
+        }
+        if (--m_remaining == 0)
+        {
+            lock_guard<mutex> lock(m_mutex);
+            m_wake.notify_all();
+        }
+    }
+}
+
+void runtime::cpu::executor::MemoryDependencies::access(
+    size_t op,
+    size_t space,
+    size_t begin,
+    size_t end,
+    bool write,
+    const function<void(size_t)>& add_predecessor)
+{
+    Ranges& ranges = m_spaces[space];
+    split(ranges, begin);
+    split(ranges, end);
+    auto it = ranges.lower_bound(begin);
+    size_t position = begin;
+    while (position < end)
+    {
+        // Bytes nothing has touched yet get a range of their own
+        if (it == ranges.end() || it->first > position)
+        {
+            size_t gap_end = it == ranges.end() ? end : min(end, it->first);
+            it = ranges.insert(it, {position, Range{gap_end, false, 0, {}}});
+        }
+        Range& range = it->second;
+        // The readers since the last write already wait for it
+        if (range.written && range.writer != op && (!write || range.readers.empty()))
+        {
+            add_predecessor(range.writer);
+        }
+        if (write)
+        {
+            for (size_t reader : range.readers)
+            {
+                if (reader != op)
+                {
+                    add_predecessor(reader);
+                }
+            }
+            range.written = true;
+            range.writer = op;
+            range.readers.clear();
+        }
+        else if (range.readers.empty() || range.readers.back() != op)
+        {
+            range.readers.push_back(op);
+        }
+        position = range.end;
+        ++it;
+    }
+}
+
+void runtime::cpu::executor::MemoryDependencies::split(Ranges& ranges, size_t position)
+{
+    auto it = ranges.upper_bound(position);
+    if (it == ranges.begin())
+    {
+        return;
+    }
+    --it;
+    if (it->first < position && position < it->second.end)
+    {
+        Range tail = it->second;
+        it->second.end = position;
+        ranges.insert(next(it), {position, move(tail)});
+    }
+}
+
+bool runtime::cpu::executor::CPUScheduler::pop(size_t worker, size_t& op)
+{
+    Queue& queue = *m_queues[worker];
+    lock_guard<mutex> lock(queue.mutex);
+    if (queue.ops.empty())
+    {
+        return false;
+    }
+    pop_heap(queue.ops.begin(), queue.ops.end(), [this](size_t a, size_t b) {
+        return m_priorities[a] < m_priorities[b];
+    });
+    op = queue.ops.back();
+    queue.ops.pop_back();
+    m_ready--;
+    return true;
+}
+
+bool runtime::cpu::executor::CPUScheduler::steal(size_t worker, size_t& op)
+{
+    for (size_t i = 1; i < m_queues.size(); i++)
+    {
+        if (pop((worker + i) % m_queues.size(), op))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void runtime::cpu::executor::CPUScheduler::push(size_t worker, size_t op)
+{
+    {
+        Queue& queue = *m_queues[worker];
+        lock_guard<mutex> lock(queue.mutex);
+        queue.ops.push_back(op);
+        push_heap(queue.ops.begin(), queue.ops.end(), [this](size_t a, size_t b) {
+            return m_priorities[a] < m_priorities[b];
+        });
+    }
+    m_ready++;
+    if (m_sleeping > 0)
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_wake.notify_one();
+    }
+}
@@ -0,0 +1,141 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace executor
+            {
+                /// \brief Runs the ops of a function on several threads, each op as soon as the
+                ///     ops it depends on have finished.
+                ///
+                /// Every worker keeps its ready ops in a queue ordered by critical path length,
+                /// the estimated work on the longest path from the op to the end of the
+                /// function, and steals the most critical op of another worker when its own
+                /// queue is empty. The calling thread is worker 0. The other workers run on
+                /// helper threads shared by all schedulers in the process, which sleep while
+                /// no run needs them.
+                class CPUScheduler
+                {
+                public:
+                    /// \param successors successors[i] lists the ops that wait for op i
+                    /// \param costs Estimated work of each op, in any unit
+                    /// \param num_workers Threads executing ops, including the calling thread
+                    CPUScheduler(const std::vector<std::vector<size_t>>& successors,
+                                 const std::vector<size_t>& costs,
+                                 size_t num_workers);
+
+                    /// \brief Calls execute(op, worker) once for every op and returns when all
+                    ///     calls have returned. If a call throws, the remaining ops are skipped
+                    ///     and the exception is rethrown. Runs must not overlap.
+                    void run(const std::function<void(size_t, size_t)>& execute);
+
+                    size_t get_priority(size_t op) const { return m_priorities[op]; }
+                    size_t get_num_workers() const { return m_queues.size(); }
+                private:
+                    friend class HelperPool;
+
+                    struct Queue
+                    {
+                        std::mutex mutex;
+                        // Max-heap on priority
+                        std::vector<size_t> ops;
+                    };
+
+                    void work(size_t worker);
+                    void helper_done();
+                    bool pop(size_t worker, size_t& op);
+                    bool steal(size_t worker, size_t& op);
+                    void push(size_t worker, size_t op);
+
+                    std::vector<std::vector<size_t>> m_successors;
+                    std::vector<size_t> m_predecessor_counts;
+                    std::vector<size_t> m_priorities;
+                    std::vector<size_t> m_sources;
+                    std::vector<std::unique_ptr<Queue>> m_queues;
+
+                    // State of the current run
+                    const std::function<void(size_t, size_t)>* m_execute = nullptr;
+                    std::unique_ptr<std::atomic<size_t>[]> m_pending;
+                    std::atomic<size_t> m_remaining{0};
+                    std::atomic<size_t> m_ready{0};
+                    std::atomic<bool> m_failed{false};
+                    std::exception_ptr m_exception;
+
+                    // Workers wait on m_wake when idle during a run; run waits on m_done for
+                    // the helpers it posted to finish
+                    std::mutex m_mutex;
+                    std::condition_variable m_wake;
+                    std::condition_variable m_done;
+                    std::atomic<size_t> m_sleeping{0};
+                    size_t m_active_helpers = 0;
+                };
+
+                /// \brief Finds the ops that an op must wait for because of the memory it
+                ///     touches, when ops run in place and buffers are reused.
+                ///
+                /// For every byte range of every memory space it keeps the last op that wrote
+                /// the range and the ops that read it since, so an op depends only on those
+                /// rather than on every earlier op that touched the same bytes.
+                class MemoryDependencies
+                {
+                public:
+                    /// \brief Records that op reads or writes [begin, end) of space, and calls
+                    ///     add_predecessor with each earlier op it must wait for. Ops are
+                    ///     recorded in execution order, and the reads of an op before its
+                    ///     writes.
+                    void access(size_t op,
+                                size_t space,
+                                size_t begin,
+                                size_t end,
+                                bool write,
+                                const std::function<void(size_t)>& add_predecessor);
+
+                private:
+                    struct Range
+                    {
+                        size_t end;
+                        bool written;
+                        size_t writer;
+                        std::vector<size_t> readers;
+                    };
+                    using Ranges = std::map<size_t, Range>;
+
+                    static void split(Ranges& ranges, size_t position);
+
+                    // Disjoint ranges of each space, keyed by their first byte
+                    std::unordered_map<size_t, Ranges> m_spaces;
+                };
+            }
+        }
+    }
+}
@@ -0,0 +1,55 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include "ngraph/runtime/cpu/kernel/gather.hpp"
+#include "ngraph/shape.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace kernel
+            {
+                template <typename ElementType, typename IndicesType>
+                void embedding_lookup(void* indices,
+                                      void* weights,
+                                      void* output,
+                                      size_t indices_count,
+                                      const Shape& weights_shape,
+                                      int arena)
+                {
+                    // output[i, :] = weights[indices[i], :]
+                    size_t vector_length = weights_shape.at(1);
+                    const IndicesType* indices_ptr = static_cast<const IndicesType*>(indices);
+                    auto row_offset = [=](Eigen::Index i) {
+                        return static_cast<size_t>(indices_ptr[i]) * vector_length;
+                    };
+
+                    gather_rows(static_cast<const ElementType*>(weights),
+                                static_cast<ElementType*>(output),
+                                indices_count,
+                                vector_length,
+                                row_offset,
+                                arena);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,148 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstring>
+
+#define EIGEN_USE_THREADS
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
+#include "ngraph/shape.hpp"
+#include "ngraph/strides.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace kernel
+            {
+                // Number of rows ahead of the current row whose first cache line is prefetched
+                static const Eigen::Index gather_prefetch_distance = 4;
+
+                // Copies row_count rows of row_size elements into the dense output, where
+                // row_offset(i) is the element offset of the i-th source row. Rows are split
+                // across the arena's thread pool and upcoming source rows are prefetched, since
+                // the rows of a large table are rarely in cache.
+                template <typename ElementType, typename RowOffset>
+                void gather_rows(const ElementType* input,
+                                 ElementType* output,
+                                 size_t row_count,
+                                 size_t row_size,
+                                 RowOffset row_offset,
+                                 int arena)
+                {
+                    if (row_count == 0 || row_size == 0)
+                    {
+                        return;
+                    }
+                    size_t row_bytes = row_size * sizeof(ElementType);
+                    auto copy_rows = [&](Eigen::Index first, Eigen::Index last) {
+                        for (Eigen::Index i = first; i < last; i++)
+                        {
+#if defined(__GNUC__)
+                            if (i + gather_prefetch_distance < last)
+                            {
+                                __builtin_prefetch(input +
+                                                   row_offset(i + gather_prefetch_distance));
+                            }
+#endif
+                            memcpy(output + i * row_size, input + row_offset(i), row_bytes);
+                        }
+                    };
+
+                    Eigen::TensorOpCost cost(row_bytes, row_bytes, 0);
+                    ngraph::runtime::cpu::executor::GetCPUExecutor()
+                        .get_device(arena)
+                        .parallelFor(row_count, cost, copy_rows);
+                }
+
+                template <typename ElementType, typename IndicesType>
+                void gather(void* inputs,
+                            void* indices,
+                            void* output,
+                            const Shape& inputs_shape,
+                            const Shape& indices_shape,
+                            const Shape& output_shape,
+                            size_t axis,
+                            int arena)
+                {
+                    // output[outer, index..., inner] = inputs[outer, indices[index...], inner]
+                    size_t outer_size = shape_size(Shape(inputs_shape.begin(),
+                                                         inputs_shape.begin() + axis));
+                    size_t axis_size = inputs_shape[axis];
+                    size_t inner_size = shape_size(Shape(inputs_shape.begin() + axis + 1,
+                                                         inputs_shape.end()));
+                    size_t indices_count = shape_size(indices_shape);
+
+                    const IndicesType* indices_ptr = static_cast<const IndicesType*>(indices);
+                    auto row_offset = [=](Eigen::Index i) {
+                        size_t outer = i / indices_count;
+                        size_t index = static_cast<size_t>(indices_ptr[i % indices_count]);
+                        return (outer * axis_size + index) * inner_size;
+                    };
+
+                    gather_rows(static_cast<const ElementType*>(inputs),
+                                static_cast<ElementType*>(output),
+                                outer_size * indices_count,
+                                inner_size,
+                                row_offset,
+                                arena);
+                }
+
+                template <typename ElementType, typename IndicesType>
+                void gather_nd(void* inputs,
+                               void* indices,
+                               void* output,
+                               const Shape& inputs_shape,
+                               const Shape& indices_shape,
+                               const Shape& output_shape,
+                               int arena)
+                {
+                    // output[leaf..., inner] = inputs[indices[leaf...], inner]
+                    size_t slice_rank = indices_shape.back();
+                    size_t leaf_count = shape_size(Shape(indices_shape.begin(),
+                                                         indices_shape.begin() +
+                                                             indices_shape.size() - 1));
+                    size_t inner_size =
+                        shape_size(Shape(inputs_shape.begin() + slice_rank, inputs_shape.end()));
+                    Strides inputs_strides = row_major_strides(inputs_shape);
+
+                    const IndicesType* indices_ptr = static_cast<const IndicesType*>(indices);
+                    auto row_offset = [=, &inputs_strides](Eigen::Index i) {
+                        const IndicesType* index = indices_ptr + i * slice_rank;
+                        size_t offset = 0;
+                        for (size_t k = 0; k < slice_rank; k++)
+                        {
+                            offset += static_cast<size_t>(index[k]) * inputs_strides[k];
+                        }
+                        return offset;
+                    };
+
+                    gather_rows(static_cast<const ElementType*>(inputs),
+                                static_cast<ElementType*>(output),
+                                leaf_count,
+                                inner_size,
+                                row_offset,
+                                arena);
+                }
+            }
+        }
+    }
+}
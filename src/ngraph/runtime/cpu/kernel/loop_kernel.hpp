@@ -0,0 +1,239 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#define EIGEN_USE_THREADS
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace kernel
+            {
+                enum class LoopKernelOpcode
+                {
+                    Abs,
+                    Add,
+                    Divide,
+                    Exp,
+                    Maximum,
+                    Minimum,
+                    Multiply,
+                    Negative,
+                    Relu,
+                    Sigmoid,
+                    Sqrt,
+                    Subtract,
+                    Tanh
+                };
+
+                struct LoopKernelInstruction
+                {
+                    LoopKernelOpcode opcode;
+                    size_t result;
+                    size_t arg0;
+                    // Unused by unary opcodes
+                    size_t arg1;
+                };
+
+                /// \brief A fused elementwise subgraph compiled to instructions over slots.
+                ///
+                /// Slots [0, input_count) are the kernel inputs, the next output_count slots
+                /// are its outputs and the remaining temporary_count slots hold intermediate
+                /// values. Temporaries only hold one block of elements at a time, so they stay
+                /// in cache and the intermediate tensors are never written to memory.
+                struct LoopKernelProgram
+                {
+                    size_t input_count = 0;
+                    size_t output_count = 0;
+                    size_t temporary_count = 0;
+                    std::vector<LoopKernelInstruction> instructions;
+                };
+
+                /// \brief Per-thread buffers for the temporaries and slot pointers of a block.
+                template <typename ElementType>
+                struct LoopKernelScratch
+                {
+                    std::vector<ElementType> temporaries;
+                    std::vector<ElementType*> slots;
+                };
+
+                // Elements per block; each instruction runs over a whole block before the
+                // next one starts, so its loop can be vectorized
+                constexpr size_t loop_kernel_block_size = 512;
+
+                template <typename ElementType>
+                void loop_kernel_instruction(const LoopKernelInstruction& instruction,
+                                             ElementType* const* slots,
+                                             size_t count)
+                {
+                    ElementType* r = slots[instruction.result];
+                    const ElementType* a = slots[instruction.arg0];
+                    const ElementType* b = slots[instruction.arg1];
+                    switch (instruction.opcode)
+                    {
+                    case LoopKernelOpcode::Abs:
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            r[i] = a[i] < ElementType(0) ? -a[i] : a[i];
+                        }
+                        break;
+                    case LoopKernelOpcode::Add:
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            r[i] = a[i] + b[i];
+                        }
+                        break;
+                    case LoopKernelOpcode::Divide:
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            r[i] = a[i] / b[i];
+                        }
+                        break;
+                    case LoopKernelOpcode::Exp:
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            r[i] = std::exp(a[i]);
+                        }
+                        break;
+                    case LoopKernelOpcode::Maximum:
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            r[i] = a[i] > b[i] ? a[i] : b[i];
+                        }
+                        break;
+                    case LoopKernelOpcode::Minimum:
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            r[i] = a[i] < b[i] ? a[i] : b[i];
+                        }
+                        break;
+                    case LoopKernelOpcode::Multiply:
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            r[i] = a[i] * b[i];
+                        }
+                        break;
+                    case LoopKernelOpcode::Negative:
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            r[i] = -a[i];
+                        }
+                        break;
+                    case LoopKernelOpcode::Relu:
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            r[i] = a[i] > ElementType(0) ? a[i] : ElementType(0);
+                        }
+                        break;
+                    case LoopKernelOpcode::Sigmoid:
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            r[i] = ElementType(1) / (ElementType(1) + std::exp(-a[i]));
+                        }
+                        break;
+                    case LoopKernelOpcode::Sqrt:
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            r[i] = std::sqrt(a[i]);
+                        }
+                        break;
+                    case LoopKernelOpcode::Subtract:
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            r[i] = a[i] - b[i];
+                        }
+                        break;
+                    case LoopKernelOpcode::Tanh:
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            r[i] = std::tanh(a[i]);
+                        }
+                        break;
+                    }
+                }
+
+                /// \brief Runs program over count elements in a single parallel pass.
+                /// \param buffer_indices The indices in buffer_data of the program inputs
+                ///     followed by its outputs
+                template <typename ElementType>
+                void loop_kernel(const LoopKernelProgram& program,
+                                 void* const* buffer_data,
+                                 const size_t* buffer_indices,
+                                 size_t count,
+                                 int arena)
+                {
+                    size_t blocks = (count + loop_kernel_block_size - 1) / loop_kernel_block_size;
+                    size_t io_count = program.input_count + program.output_count;
+                    size_t slot_count = io_count + program.temporary_count;
+                    size_t temporary_size = program.temporary_count * loop_kernel_block_size;
+                    auto run_blocks = [&](Eigen::Index first, Eigen::Index last) {
+                        // Scratch space only grows, so after the first call on a thread no
+                        // shard allocates
+                        static thread_local LoopKernelScratch<ElementType> scratch;
+                        if (scratch.temporaries.size() < temporary_size)
+                        {
+                            scratch.temporaries.resize(temporary_size);
+                        }
+                        if (scratch.slots.size() < slot_count)
+                        {
+                            scratch.slots.resize(slot_count);
+                        }
+                        ElementType** slots = scratch.slots.data();
+                        for (size_t t = 0; t < program.temporary_count; t++)
+                        {
+                            slots[io_count + t] = &scratch.temporaries[t * loop_kernel_block_size];
+                        }
+                        for (Eigen::Index block = first; block < last; block++)
+                        {
+                            size_t offset = block * loop_kernel_block_size;
+                            size_t n = std::min(loop_kernel_block_size, count - offset);
+                            for (size_t i = 0; i < io_count; i++)
+                            {
+                                slots[i] =
+                                    static_cast<ElementType*>(buffer_data[buffer_indices[i]]) +
+                                    offset;
+                            }
+                            for (auto& instruction : program.instructions)
+                            {
+                                loop_kernel_instruction(instruction, slots, n);
+                            }
+                        }
+                    };
+
+                    // Per block: every input is read and every output written once, and each
+                    // instruction is a handful of cycles per element
+                    Eigen::TensorOpCost cost(
+                        program.input_count * loop_kernel_block_size * sizeof(ElementType),
+                        program.output_count * loop_kernel_block_size * sizeof(ElementType),
+                        program.instructions.size() * loop_kernel_block_size);
+                    ngraph::runtime::cpu::executor::GetCPUExecutor().get_device(arena).parallelFor(
+                        blocks, cost, run_blocks);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,173 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#define EIGEN_USE_THREADS
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
+#include "ngraph/shape.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace kernel
+            {
+                // Orders positions along the top-k axis so that the selected values come first.
+                // Equal values are ordered by position, which matches reference::topk.
+                template <typename ElementType>
+                class TopKCompare
+                {
+                public:
+                    TopKCompare(const ElementType* values, size_t stride, bool compute_max)
+                        : m_values(values)
+                        , m_stride(stride)
+                        , m_compute_max(compute_max)
+                    {
+                    }
+
+                    bool operator()(size_t a, size_t b) const
+                    {
+                        ElementType value_a = m_values[a * m_stride];
+                        ElementType value_b = m_values[b * m_stride];
+// this is intentional to be able to compare floats directly
+// without using relative or absolute tolerance
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+                        if (value_a == value_b)
+                        {
+                            return a < b;
+                        }
+#pragma GCC diagnostic pop
+                        return m_compute_max ? value_a > value_b : value_a < value_b;
+                    }
+
+                private:
+                    const ElementType* m_values;
+                    size_t m_stride;
+                    bool m_compute_max;
+                };
+
+                template <typename ElementType, typename IndexType>
+                void topk(void* input,
+                          void* out_indices,
+                          void* out_values,
+                          const Shape& in_shape,
+                          const Shape& out_shape,
+                          size_t axis,
+                          size_t k,
+                          bool compute_max,
+                          int arena)
+                {
+                    // Every (outer, inner) pair is an independent slice along "axis"
+                    size_t outer_size =
+                        shape_size(Shape(in_shape.begin(), in_shape.begin() + axis));
+                    size_t axis_size = in_shape[axis];
+                    size_t inner_size =
+                        shape_size(Shape(in_shape.begin() + axis + 1, in_shape.end()));
+                    size_t slice_count = outer_size * inner_size;
+                    if (slice_count == 0 || k == 0)
+                    {
+                        return;
+                    }
+
+                    const ElementType* in = static_cast<const ElementType*>(input);
+                    IndexType* indices = static_cast<IndexType*>(out_indices);
+                    ElementType* values = static_cast<ElementType*>(out_values);
+
+                    // A bounded heap of the k best candidates needs one pass and O(k) memory,
+                    // which wins when k is much smaller than the axis. Otherwise select with
+                    // nth_element over all positions and sort only the selected prefix.
+                    bool use_heap = k * 16 <= axis_size;
+
+                    auto compute_slices = [&](Eigen::Index first, Eigen::Index last) {
+                        std::vector<size_t> workspace;
+                        workspace.reserve(use_heap ? k : axis_size);
+                        for (Eigen::Index slice = first; slice < last; slice++)
+                        {
+                            size_t outer = slice / inner_size;
+                            size_t inner = slice % inner_size;
+                            const ElementType* in_slice =
+                                in + outer * axis_size * inner_size + inner;
+                            size_t out_offset = outer * k * inner_size + inner;
+                            TopKCompare<ElementType> compare(in_slice, inner_size, compute_max);
+
+                            workspace.clear();
+                            if (use_heap)
+                            {
+                                // The heap's front is the worst of the current candidates
+                                for (size_t i = 0; i < axis_size; i++)
+                                {
+                                    if (workspace.size() < k)
+                                    {
+                                        workspace.push_back(i);
+                                        std::push_heap(
+                                            workspace.begin(), workspace.end(), compare);
+                                    }
+                                    else if (compare(i, workspace.front()))
+                                    {
+                                        std::pop_heap(
+                                            workspace.begin(), workspace.end(), compare);
+                                        workspace.back() = i;
+                                        std::push_heap(
+                                            workspace.begin(), workspace.end(), compare);
+                                    }
+                                }
+                                std::sort_heap(workspace.begin(), workspace.end(), compare);
+                            }
+                            else
+                            {
+                                workspace.resize(axis_size);
+                                std::iota(workspace.begin(), workspace.end(), 0);
+                                if (k < axis_size)
+                                {
+                                    std::nth_element(workspace.begin(),
+                                                     workspace.begin() + k,
+                                                     workspace.end(),
+                                                     compare);
+                                }
+                                std::sort(workspace.begin(), workspace.begin() + k, compare);
+                            }
+
+                            for (size_t j = 0; j < k; j++)
+                            {
+                                size_t position = workspace[j];
+                                values[out_offset] = in_slice[position * inner_size];
+                                indices[out_offset] = static_cast<IndexType>(position);
+                                out_offset += inner_size;
+                            }
+                        }
+                    };
+
+                    Eigen::TensorOpCost cost(axis_size * sizeof(ElementType),
+                                             k * (sizeof(ElementType) + sizeof(IndexType)),
+                                             axis_size * 4);
+                    ngraph::runtime::cpu::executor::GetCPUExecutor()
+                        .get_device(arena)
+                        .parallelFor(slice_count, cost, compute_slices);
+                }
+            }
+        }
+    }
+}
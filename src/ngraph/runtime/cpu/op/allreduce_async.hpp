@@ -0,0 +1,57 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <memory>
+
+#include "ngraph/op/op.hpp"
+
+namespace ngraph
+{
+    namespace op
+    {
+        /// \brief Starts summing its argument across all ranks without waiting for the result.
+        ///
+        /// The output holds the reduced value only once the matching AllReduceWait has run, and
+        /// must not be read before then.
+        class AllReduceStart : public Op
+        {
+        public:
+            AllReduceStart(const std::shared_ptr<Node>& arg);
+
+            void validate_and_infer_types() override;
+
+            virtual std::shared_ptr<Node>
+                copy_with_new_args(const NodeVector& new_args) const override;
+        };
+
+        /// \brief Completes an AllReduceStart, producing its reduced value.
+        ///
+        /// The second argument is the AllReduceStart's argument. Taking it as an input keeps
+        /// its buffer alive until the reduction has finished reading it.
+        class AllReduceWait : public Op
+        {
+        public:
+            AllReduceWait(const std::shared_ptr<Node>& start, const std::shared_ptr<Node>& arg);
+
+            void validate_and_infer_types() override;
+
+            virtual std::shared_ptr<Node>
+                copy_with_new_args(const NodeVector& new_args) const override;
+        };
+    }
+}
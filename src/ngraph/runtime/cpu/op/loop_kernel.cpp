@@ -16,6 +16,7 @@
 
 #include "ngraph/runtime/cpu/op/loop_kernel.hpp"
 #include "ngraph/log.hpp"
+#include "ngraph/op/get_output_element.hpp"
 #include "ngraph/util.hpp"
 
 using namespace std;
@@ -89,3 +90,13 @@ ngraph::runtime::cpu::op::LoopKernel::LoopKernel(const NodeVector& node_list,
         set_output_type(i, o->get_element_type(), o->get_shape());
     }
 }
+
+const descriptor::Output*
+    ngraph::runtime::cpu::op::get_goe_input_output(const descriptor::Output* output)
+{
+    while (auto goe = dynamic_pointer_cast<ngraph::op::GetOutputElement>(output->get_node()))
+    {
+        output = &goe->get_inputs().at(goe->get_n()).get_output();
+    }
+    return output;
+}
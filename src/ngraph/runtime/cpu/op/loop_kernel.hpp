@@ -44,6 +44,10 @@ namespace ngraph
                     NodeVector m_node_list;
                     NodeVector m_output_nodes;
                 };
+
+                /// \brief GOEE doesn't see GOEs in subgraphs that are hidden inside LoopKernels,
+                /// so this follows them manually back to the output that produces the value
+                const descriptor::Output* get_goe_input_output(const descriptor::Output* output);
             }
         }
     }
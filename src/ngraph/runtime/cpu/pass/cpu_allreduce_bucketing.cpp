@@ -0,0 +1,161 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
+#include "ngraph/graph_util.hpp"
+#include "ngraph/log.hpp"
+#include "ngraph/op/allreduce.hpp"
+#include "ngraph/op/concat.hpp"
+#include "ngraph/op/reshape.hpp"
+#include "ngraph/op/slice.hpp"
+#include "ngraph/runtime/cpu/op/allreduce_async.hpp"
+#include "ngraph/runtime/cpu/pass/cpu_allreduce_bucketing.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+namespace
+{
+    struct Bucket
+    {
+        // Position of the first member among all AllReduce ops, in topological order
+        size_t first;
+        // Latest AllReduce that any member's argument depends on, or -1
+        int64_t depends_on;
+        size_t bytes;
+        vector<shared_ptr<Node>> members;
+    };
+}
+
+static shared_ptr<Node> flatten(const shared_ptr<Node>& node)
+{
+    const Shape& shape = node->get_shape();
+    if (shape.size() == 1)
+    {
+        return node;
+    }
+    AxisVector order(shape.size());
+    iota(order.begin(), order.end(), 0);
+    return make_shared<op::Reshape>(node, order, Shape{shape_size(shape)});
+}
+
+bool runtime::cpu::pass::CPUAllReduceBucketing::run_on_function(shared_ptr<Function> function)
+{
+    // For every node, the index of the latest AllReduce (in topological order) that it
+    // depends on. An AllReduce may only join a bucket if its argument depends on none of the
+    // bucket's members, otherwise the fused reduction would depend on itself.
+    unordered_map<Node*, int64_t> latest_allreduce;
+    vector<Bucket> buckets;
+    int64_t allreduce_count = 0;
+    for (auto node : function->get_ordered_ops())
+    {
+        int64_t depends_on = -1;
+        for (auto arg : node->get_arguments())
+        {
+            depends_on = max(depends_on, latest_allreduce[arg.get()]);
+        }
+        for (auto dep : node->get_control_dependencies())
+        {
+            depends_on = max(depends_on, latest_allreduce[dep.get()]);
+        }
+
+        auto allreduce = dynamic_pointer_cast<op::AllReduce>(node);
+        if (!allreduce || node->is_dynamic())
+        {
+            latest_allreduce[node.get()] = depends_on;
+            continue;
+        }
+
+        size_t index = allreduce_count++;
+        latest_allreduce[node.get()] = index;
+        size_t bytes = shape_size(node->get_shape()) * node->get_element_type().size();
+        if (!buckets.empty())
+        {
+            Bucket& bucket = buckets.back();
+            if (node->get_element_type() == bucket.members[0]->get_element_type() &&
+                depends_on < static_cast<int64_t>(bucket.first) &&
+                bucket.bytes + bytes <= m_bucket_size)
+            {
+                bucket.members.push_back(node);
+                bucket.bytes += bytes;
+                bucket.depends_on = max(bucket.depends_on, depends_on);
+                continue;
+            }
+        }
+        buckets.push_back(Bucket{index, depends_on, bytes, {node}});
+    }
+
+    vector<shared_ptr<Node>> starts;
+    vector<shared_ptr<Node>> waits;
+    for (Bucket& bucket : buckets)
+    {
+        shared_ptr<Node> flat;
+        if (bucket.members.size() == 1)
+        {
+            flat = bucket.members[0]->get_argument(0);
+        }
+        else
+        {
+            NodeVector args;
+            for (auto member : bucket.members)
+            {
+                args.push_back(flatten(member->get_argument(0)));
+            }
+            flat = make_shared<op::Concat>(args, 0);
+        }
+        auto start = make_shared<op::AllReduceStart>(flat);
+        auto wait = make_shared<op::AllReduceWait>(start, flat);
+        starts.push_back(start);
+        waits.push_back(wait);
+
+        if (bucket.members.size() == 1)
+        {
+            replace_node(bucket.members[0], wait);
+            continue;
+        }
+        size_t offset = 0;
+        for (auto member : bucket.members)
+        {
+            const Shape& shape = member->get_shape();
+            size_t size = shape_size(shape);
+            shared_ptr<Node> replacement =
+                make_shared<op::Slice>(wait, Coordinate{offset}, Coordinate{offset + size});
+            if (shape.size() != 1)
+            {
+                replacement = make_shared<op::Reshape>(replacement, AxisVector{0}, shape);
+            }
+            replace_node(member, replacement);
+            offset += size;
+        }
+        NGRAPH_DEBUG << "AllReduce bucket of " << bucket.members.size() << " ops, "
+                     << bucket.bytes << " bytes";
+    }
+
+    // Defer each wait until the next bucket has been started. The next bucket's arguments must
+    // not depend on this bucket, which holds whenever they only depend on earlier AllReduces.
+    for (size_t i = 0; i + 1 < buckets.size(); i++)
+    {
+        if (buckets[i + 1].depends_on < static_cast<int64_t>(buckets[i].first))
+        {
+            waits[i]->add_control_dependency(starts[i + 1]);
+        }
+    }
+
+    return !buckets.empty();
+}
@@ -0,0 +1,51 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include "ngraph/pass/pass.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace pass
+            {
+                /// \brief Fuses AllReduce ops into flat buckets of at most bucket_size bytes and
+                /// runs each bucket as an AllReduceStart/AllReduceWait pair.
+                ///
+                /// A bucket is started as soon as the last of its arguments has been computed.
+                /// Its wait is scheduled after the next bucket has been started, so that each
+                /// reduction overlaps with the computation of the following bucket's arguments.
+                class CPUAllReduceBucketing : public ngraph::pass::FunctionPass
+                {
+                public:
+                    CPUAllReduceBucketing(size_t bucket_size = 25 * 1024 * 1024)
+                        : m_bucket_size(bucket_size)
+                    {
+                    }
+
+                    bool run_on_function(std::shared_ptr<ngraph::Function> function) override;
+
+                private:
+                    size_t m_bucket_size;
+                };
+            }
+        }
+    }
+}
@@ -52,6 +52,7 @@
 #include "ngraph/op/softmax.hpp"
 #include "ngraph/runtime/cpu/cpu_op_annotations.hpp"
 #include "ngraph/runtime/cpu/mkldnn_utils.hpp"
+#include "ngraph/runtime/cpu/op/allreduce_async.hpp"
 #include "ngraph/runtime/cpu/op/batch_norm_relu.hpp"
 #include "ngraph/runtime/cpu/op/bounded_relu.hpp"
 #include "ngraph/runtime/cpu/op/conv_add.hpp"
@@ -219,6 +220,17 @@ namespace ngraph
                     goe->set_op_annotations(op_annotations);
                 }
 
+                template <>
+                void CPUAssignment::ASSIGN_DECL(ngraph::op::AllReduceWait)
+                {
+                    auto wait = static_cast<ngraph::op::AllReduceWait*>(node);
+                    auto op_annotations =
+                        std::make_shared<ngraph::runtime::cpu::CPUOpAnnotations>();
+                    // The reduction completes in the AllReduceStart's output buffer
+                    op_annotations->add_in_place_oi_pair({0, 0, false});
+                    wait->set_op_annotations(op_annotations);
+                }
+
                 template <>
                 void CPUAssignment::ASSIGN_DECL(ngraph::op::ConvolutionAdd)
                 {
@@ -997,6 +1009,8 @@ static const runtime::cpu::pass::AssignOpMap s_dispatcher{
      &runtime::cpu::pass::CPUAssignment::assign<ngraph::op::GetOutputElement>},
     {TI(ngraph::op::DeconvolutionBias),
      &runtime::cpu::pass::CPUAssignment::assign<ngraph::op::DeconvolutionBias>},
+    {TI(ngraph::op::AllReduceWait),
+     &runtime::cpu::pass::CPUAssignment::assign<ngraph::op::AllReduceWait>},
 };
 
 bool runtime::cpu::pass::CPUAssignment::run_on_call_graph(
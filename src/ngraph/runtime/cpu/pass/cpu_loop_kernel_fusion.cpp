@@ -23,12 +23,18 @@
 #include "ngraph/log.hpp"
 #include "ngraph/op/abs.hpp"
 #include "ngraph/op/add.hpp"
+#include "ngraph/op/divide.hpp"
+#include "ngraph/op/exp.hpp"
 #include "ngraph/op/get_output_element.hpp"
 #include "ngraph/op/maximum.hpp"
 #include "ngraph/op/minimum.hpp"
+#include "ngraph/op/multiply.hpp"
 #include "ngraph/op/negative.hpp"
 #include "ngraph/op/relu.hpp"
+#include "ngraph/op/sigmoid.hpp"
+#include "ngraph/op/sqrt.hpp"
 #include "ngraph/op/subtract.hpp"
+#include "ngraph/op/tanh.hpp"
 #include "ngraph/op/util/binary_elementwise_arithmetic.hpp"
 #include "ngraph/op/util/unary_elementwise_arithmetic.hpp"
 #include "ngraph/runtime/cpu/op/loop_kernel.hpp"
@@ -56,31 +62,25 @@ public:
     {
         for (auto n : f->get_ordered_ops())
         {
+            m_positions.insert(std::make_pair(n, m_positions.size()));
             if (is_fusible(n))
             {
-                auto arg_from_fusible_group = collect_fusible_args(n);
+                auto group_head = find_group(n);
                 // create a new group
-                if (!arg_from_fusible_group)
+                if (!group_head)
                 {
                     m_heads.insert(std::make_pair(n, n));
-                    m_graphs.insert(std::make_pair(n, LKGraph{{n}, n->get_arguments()}));
+                    m_graphs.insert(std::make_pair(n, LKGraph{{n}, {}}));
+                    add_inputs(n, n);
                     NGRAPH_DEBUG << "Created a new group for " << n->get_name();
                     log_group(n);
                 }
                 else
                 {
-                    auto smallest_head = m_heads.at(arg_from_fusible_group);
-                    auto& lkgraph = m_graphs.at(smallest_head);
-                    lkgraph.m_nodes.push_back(n);
-                    for (auto arg : n->get_arguments())
-                    {
-                        if (is_leaf(arg))
-                        {
-                            lkgraph.m_inputs.push_back(arg);
-                        }
-                    }
-                    m_heads.insert(std::make_pair(n, smallest_head));
-                    log_group(smallest_head);
+                    m_graphs.at(group_head).m_nodes.push_back(n);
+                    m_heads.insert(std::make_pair(n, group_head));
+                    add_inputs(n, group_head);
+                    log_group(group_head);
                 }
             }
         }
@@ -94,7 +94,16 @@ public:
         for (auto e : m_graphs)
         {
             auto& lkg = e.second;
-            NodeVector member_outputs = ngraph::get_subgraph_outputs(lkg.m_nodes, NodeVector{});
+            // A member with several users outside the group is listed once per user
+            NodeVector member_outputs;
+            for (auto output : ngraph::get_subgraph_outputs(lkg.m_nodes, NodeVector{}))
+            {
+                if (std::find(member_outputs.begin(), member_outputs.end(), output) ==
+                    member_outputs.end())
+                {
+                    member_outputs.push_back(output);
+                }
+            }
             auto lk = std::make_shared<runtime::cpu::op::LoopKernel>(
                 lkg.m_nodes, member_outputs, lkg.m_inputs);
             lks.push_back(lk);
@@ -107,20 +116,141 @@ private:
     {
         static const std::set<std::type_index> fusible_ops_set{TI(ngraph::op::Abs),
                                                                TI(ngraph::op::Add),
+                                                               TI(ngraph::op::Divide),
+                                                               TI(ngraph::op::Exp),
+                                                               TI(ngraph::op::Maximum),
+                                                               TI(ngraph::op::Minimum),
+                                                               TI(ngraph::op::Multiply),
                                                                TI(ngraph::op::Negative),
-                                                               TI(ngraph::op::Subtract),
                                                                TI(ngraph::op::Relu),
-                                                               TI(ngraph::op::Minimum),
-                                                               TI(ngraph::op::Maximum)};
+                                                               TI(ngraph::op::Sigmoid),
+                                                               TI(ngraph::op::Sqrt),
+                                                               TI(ngraph::op::Subtract),
+                                                               TI(ngraph::op::Tanh)};
 
         const Node& node = *n;
-        return fusible_ops_set.count(TI(node)) != 0;
+        // The LoopKernel builder runs f32 and f64 kernels
+        return fusible_ops_set.count(TI(node)) != 0 && n->get_output_size() == 1 &&
+               (n->get_element_type() == element::f32 || n->get_element_type() == element::f64);
+    }
+
+    // Returns the head of the group that n should join, or nullptr if it should start a new
+    // one. n joins the groups of its arguments, merging them if there are several, as long as
+    // every input of the result that is not a member is ordered before the result's head. Such
+    // inputs cannot depend on any member, so the fused graph stays acyclic.
+    std::shared_ptr<Node> find_group(std::shared_ptr<Node> n)
+    {
+        std::vector<std::shared_ptr<Node>> heads;
+        for (auto arg : n->get_arguments())
+        {
+            auto head = m_heads.find(arg);
+            if (head != m_heads.end() && head->second->get_shape() == n->get_shape() &&
+                head->second->get_element_type() == n->get_element_type() &&
+                std::find(heads.begin(), heads.end(), head->second) == heads.end())
+            {
+                heads.push_back(head->second);
+            }
+        }
+        if (heads.empty())
+        {
+            return nullptr;
+        }
+        if (heads.size() > 1 && can_join(n, heads))
+        {
+            return merge_groups(heads);
+        }
+        for (auto head : heads)
+        {
+            if (can_join(n, {head}))
+            {
+                return head;
+            }
+        }
+        return nullptr;
+    }
+
+    bool can_join(std::shared_ptr<Node> n, const std::vector<std::shared_ptr<Node>>& heads) const
+    {
+        std::set<std::shared_ptr<Node>> head_set(heads.begin(), heads.end());
+        size_t first_position = m_positions.at(heads.at(0));
+        NodeVector inputs = n->get_arguments();
+        for (auto head : heads)
+        {
+            first_position = std::min(first_position, m_positions.at(head));
+            auto& group_inputs = m_graphs.at(head).m_inputs;
+            inputs.insert(inputs.end(), group_inputs.begin(), group_inputs.end());
+        }
+        for (auto input : inputs)
+        {
+            auto input_head = m_heads.find(input);
+            bool is_member = input_head != m_heads.end() && head_set.count(input_head->second);
+            if (!is_member && m_positions.at(input) >= first_position)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
 
-        // return (std::dynamic_pointer_cast<op::util::BinaryElementwiseArithmetic>(n) ||
-        //         std::dynamic_pointer_cast<op::util::UnaryElementwiseArithmetic>(n));
+    // Merges the groups into the one with the earliest head and returns its head
+    std::shared_ptr<Node> merge_groups(const std::vector<std::shared_ptr<Node>>& heads)
+    {
+        auto first = *std::min_element(
+            heads.begin(), heads.end(), [this](std::shared_ptr<Node> a, std::shared_ptr<Node> b) {
+                return m_positions.at(a) < m_positions.at(b);
+            });
+        auto& merged = m_graphs.at(first);
+        for (auto head : heads)
+        {
+            if (head == first)
+            {
+                continue;
+            }
+            auto& graph = m_graphs.at(head);
+            for (auto member : graph.m_nodes)
+            {
+                m_heads[member] = first;
+                merged.m_nodes.push_back(member);
+            }
+            m_graphs.erase(head);
+        }
+        // Keep members in topological order and drop inputs that are now members
+        std::sort(merged.m_nodes.begin(),
+                  merged.m_nodes.end(),
+                  [this](std::shared_ptr<Node> a, std::shared_ptr<Node> b) {
+                      return m_positions.at(a) < m_positions.at(b);
+                  });
+        NodeVector inputs;
+        for (auto member : merged.m_nodes)
+        {
+            for (auto arg : member->get_arguments())
+            {
+                auto arg_head = m_heads.find(arg);
+                bool is_member = arg_head != m_heads.end() && arg_head->second == first;
+                if (!is_member && std::find(inputs.begin(), inputs.end(), arg) == inputs.end())
+                {
+                    inputs.push_back(arg);
+                }
+            }
+        }
+        merged.m_inputs = inputs;
+        return first;
+    }
+
+    void add_inputs(std::shared_ptr<Node> n, std::shared_ptr<Node> head)
+    {
+        auto& inputs = m_graphs.at(head).m_inputs;
+        for (auto arg : n->get_arguments())
+        {
+            auto arg_head = m_heads.find(arg);
+            bool is_member = arg_head != m_heads.end() && arg_head->second == head;
+            if (!is_member && std::find(inputs.begin(), inputs.end(), arg) == inputs.end())
+            {
+                inputs.push_back(arg);
+            }
+        }
     }
 
-    bool is_leaf(std::shared_ptr<Node> src) { return src->is_parameter() || src->is_constant(); }
     void prune_graphs(size_t min_nodes_to_fuse)
     {
         for (auto it = m_graphs.begin(); it != m_graphs.end();)
@@ -143,33 +273,9 @@ private:
         NGRAPH_DEBUG << "Inputs: " << m_graphs.at(head).m_inputs << std::endl;
     }
 
-    std::shared_ptr<Node> collect_fusible_args(std::shared_ptr<Node> n)
-    {
-        std::shared_ptr<Node> arg_from_fusible_group;
-        for (auto arg : n->get_arguments())
-        {
-            // an argument is fusible and a part of some group
-            NGRAPH_DEBUG << "Considering " << arg->get_name();
-            if (m_heads.count(arg) != 0)
-            {
-                if (!arg_from_fusible_group)
-                {
-                    arg_from_fusible_group = arg;
-                }
-                else
-                {
-                    if (!is_leaf(arg) && m_heads.at(arg) != m_heads.at(arg_from_fusible_group))
-                    {
-                        return {nullptr};
-                    }
-                }
-            }
-        }
-        return arg_from_fusible_group;
-    }
-
     std::unordered_map<std::shared_ptr<Node>, LKGraph> m_graphs;
     std::unordered_map<std::shared_ptr<Node>, std::shared_ptr<Node>> m_heads;
+    std::unordered_map<std::shared_ptr<Node>, size_t> m_positions;
 };
 
 bool ngraph::runtime::cpu::pass::CPULoopKernelFusion::run_on_function(
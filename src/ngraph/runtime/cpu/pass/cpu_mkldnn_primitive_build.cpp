@@ -923,7 +923,10 @@ namespace ngraph
                         std::stringstream ss;
                         if (c)
                         {
-                            ss << "((" << type << "*)(" << c->get_data_ptr() << "))\n";
+                            // The constant's variable in the generated code, set by
+                            // bind_constants, keeps data addresses out of the source
+                            ss << "((" << type << "*)(" << c->get_output_tensor_ptr(0)->get_name()
+                               << "))";
                         }
                         else
                         {
@@ -0,0 +1,300 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <sstream>
+
+#include "ngraph/graph_util.hpp"
+#include "ngraph/op/constant.hpp"
+#include "ngraph/op/experimental/dyn_broadcast.hpp"
+#include "ngraph/op/experimental/dyn_pad.hpp"
+#include "ngraph/op/experimental/dyn_reshape.hpp"
+#include "ngraph/op/experimental/dyn_slice.hpp"
+#include "ngraph/op/experimental/shape_of.hpp"
+#include "ngraph/op/experimental/transpose.hpp"
+#include "ngraph/pass/constant_folding.hpp"
+#include "ngraph/pass/dyn_elimination.hpp"
+#include "ngraph/pass/manager.hpp"
+#include "ngraph/pass/shape_relevance.hpp"
+#include "ngraph/pass/shape_specialization.hpp"
+#include "ngraph/runtime/dynamic/dynamic_backend.hpp"
+#include "ngraph/runtime/tensor.hpp"
+#include "ngraph/specialize_shapes.hpp"
+#include "ngraph/util.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+runtime::dynamic::DynamicBackend::DynamicBackend(
+    const shared_ptr<runtime::Backend>& wrapped_backend)
+    : m_wrapped_backend(wrapped_backend)
+{
+}
+
+shared_ptr<runtime::Tensor>
+    runtime::dynamic::DynamicBackend::create_tensor(const element::Type& element_type,
+                                                    const Shape& shape)
+{
+    return m_wrapped_backend->create_tensor(element_type, shape);
+}
+
+shared_ptr<runtime::Tensor> runtime::dynamic::DynamicBackend::create_tensor(
+    const element::Type& element_type, const Shape& shape, void* memory_pointer)
+{
+    return m_wrapped_backend->create_tensor(element_type, shape, memory_pointer);
+}
+
+shared_ptr<runtime::Executable>
+    runtime::dynamic::DynamicBackend::compile(shared_ptr<Function> func,
+                                              bool enable_performance_data)
+{
+    return make_shared<DynamicExecutable>(func, m_wrapped_backend, enable_performance_data);
+}
+
+bool runtime::dynamic::DynamicBackend::is_supported(const Node& node) const
+{
+    // Nodes that specialization eliminates never reach the wrapped backend
+    return node.is_constant() || dynamic_cast<const op::ShapeOf*>(&node) != nullptr ||
+           dynamic_cast<const op::DynReshape*>(&node) != nullptr ||
+           dynamic_cast<const op::DynSlice*>(&node) != nullptr ||
+           dynamic_cast<const op::DynBroadcast*>(&node) != nullptr ||
+           dynamic_cast<const op::DynPad*>(&node) != nullptr ||
+           dynamic_cast<const op::Transpose*>(&node) != nullptr ||
+           m_wrapped_backend->is_supported(node);
+}
+
+bool runtime::dynamic::DynamicBackend::is_supported_property(const Property prop) const
+{
+    return m_wrapped_backend->is_supported_property(prop);
+}
+
+runtime::dynamic::DynamicExecutable::DynamicExecutable(
+    const shared_ptr<Function>& func,
+    const shared_ptr<runtime::Backend>& wrapped_backend,
+    bool enable_performance_data,
+    size_t max_cached)
+    : m_function(func)
+    , m_wrapped_backend(wrapped_backend)
+    , m_enable_performance_data(enable_performance_data)
+    , m_max_cached(max_cached)
+{
+    if (m_max_cached == 0)
+    {
+        throw ngraph_error("DynamicExecutable must be allowed to cache a specialization");
+    }
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ShapeRelevance>();
+    pass_manager.run_passes(m_function);
+    for (auto& parameter : m_function->get_parameters())
+    {
+        m_shape_relevant.push_back(parameter->is_relevant_to_shapes());
+    }
+    set_parameters_and_results(*m_function);
+}
+
+void runtime::dynamic::DynamicExecutable::validate(
+    const vector<shared_ptr<runtime::Tensor>>& outputs,
+    const vector<shared_ptr<runtime::Tensor>>& inputs)
+{
+    const ParameterVector& parameters = get_parameters();
+    const ResultVector& results = get_results();
+    if (parameters.size() != inputs.size())
+    {
+        stringstream ss;
+        ss << "Call input count " << inputs.size() << " does not match Function's Parameter count "
+           << parameters.size();
+        throw runtime_error(ss.str());
+    }
+    if (results.size() != outputs.size())
+    {
+        stringstream ss;
+        ss << "Call output count " << outputs.size() << " does not match Function's Result count "
+           << results.size();
+        throw runtime_error(ss.str());
+    }
+
+    for (size_t i = 0; i < parameters.size(); i++)
+    {
+        if (!parameters[i]->get_element_type().compatible(inputs[i]->get_element_type()))
+        {
+            stringstream ss;
+            ss << "Input " << i << " type '" << inputs[i]->get_element_type()
+               << "' does not match Parameter type '" << parameters[i]->get_element_type() << "'";
+            throw runtime_error(ss.str());
+        }
+        const PartialShape& shape = parameters[i]->get_output_partial_shape(0);
+        if (!PartialShape(inputs[i]->get_shape()).refines(shape))
+        {
+            stringstream ss;
+            ss << "Input " << i << " shape {" << join(inputs[i]->get_shape())
+               << "} does not match Parameter shape " << shape;
+            throw runtime_error(ss.str());
+        }
+    }
+}
+
+shared_ptr<Function> runtime::dynamic::DynamicExecutable::specialize(
+    const vector<shared_ptr<runtime::Tensor>>& inputs) const
+{
+    vector<element::Type> types;
+    vector<PartialShape> shapes;
+    for (auto& input : inputs)
+    {
+        types.push_back(input->get_element_type());
+        shapes.push_back(input->get_shape());
+    }
+    auto specialized = specialize_shapes(m_function, types, shapes);
+
+    // Shape-relevant parameters become Constants holding this call's values. The Parameters
+    // stay in the Function, unused, so that the specialization takes the same inputs.
+    const ParameterVector& parameters = specialized->get_parameters();
+    for (size_t i = 0; i < parameters.size(); i++)
+    {
+        if (m_shape_relevant[i])
+        {
+            vector<char> data(inputs[i]->get_size_in_bytes());
+            inputs[i]->read(data.data(), 0, data.size());
+            auto constant =
+                make_shared<op::Constant>(types[i], inputs[i]->get_shape(), data.data());
+            for (auto& input : parameters[i]->output(0).get_target_inputs())
+            {
+                input.replace_source_output(constant->output(0));
+            }
+        }
+    }
+
+    // Each round folds the shape computations that the previous round made static
+    bool changes_made = true;
+    while (specialized->is_dynamic() && changes_made)
+    {
+        changes_made = pass::ShapeSpecialization().run_on_function(specialized);
+        specialized->validate_nodes_and_infer_types();
+        changes_made |= pass::ConstantFolding().run_on_function(specialized);
+        specialized->validate_nodes_and_infer_types();
+        changes_made |= pass::DynElimination().run_on_function(specialized);
+        specialized->validate_nodes_and_infer_types();
+    }
+    if (specialized->is_dynamic())
+    {
+        throw ngraph_error("Unable to resolve the dynamic shapes of " + m_function->get_name() +
+                           " for the given inputs");
+    }
+    return specialized;
+}
+
+shared_ptr<runtime::Executable> runtime::dynamic::DynamicExecutable::get_specialization(
+    const vector<shared_ptr<runtime::Tensor>>& inputs)
+{
+    stringstream key;
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        key << inputs[i]->get_element_type().c_type_string() << "{"
+            << join(inputs[i]->get_shape()) << "}";
+        if (m_shape_relevant[i])
+        {
+            vector<char> data(inputs[i]->get_size_in_bytes());
+            inputs[i]->read(data.data(), 0, data.size());
+            key << "=";
+            key.write(data.data(), data.size());
+        }
+        key << ";";
+    }
+
+    string k = key.str();
+    {
+        lock_guard<mutex> lock(m_mutex);
+        auto it = m_specializations.find(k);
+        if (it != m_specializations.end())
+        {
+            m_lru.remove(k);
+            m_lru.push_front(k);
+            m_last_used = it->second;
+            return it->second;
+        }
+    }
+
+    // Specialize and compile without holding the lock so that calls with cached shapes keep
+    // running. Nothing is cached unless both succeed. If another call compiled the same
+    // shapes in the meantime its executable wins.
+    auto executable = m_wrapped_backend->compile(specialize(inputs), m_enable_performance_data);
+
+    lock_guard<mutex> lock(m_mutex);
+    auto it = m_specializations.find(k);
+    if (it == m_specializations.end())
+    {
+        if (m_specializations.size() >= m_max_cached)
+        {
+            const string& victim = m_lru.back();
+            m_wrapped_backend->remove_compiled_function(m_specializations.at(victim));
+            m_specializations.erase(victim);
+            m_lru.pop_back();
+        }
+        it = m_specializations.insert({k, executable}).first;
+    }
+    else
+    {
+        m_lru.remove(k);
+    }
+    m_lru.push_front(k);
+    m_last_used = it->second;
+    return it->second;
+}
+
+bool runtime::dynamic::DynamicExecutable::call(const vector<shared_ptr<runtime::Tensor>>& outputs,
+                                               const vector<shared_ptr<runtime::Tensor>>& inputs)
+{
+    shared_ptr<Executable> executable = get_specialization(inputs);
+    const ResultVector& results = executable->get_results();
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        if (results[i]->get_shape() != outputs[i]->get_shape())
+        {
+            stringstream ss;
+            ss << "Output " << i << " shape {" << join(outputs[i]->get_shape())
+               << "} does not match Result shape {" << join(results[i]->get_shape()) << "}";
+            throw runtime_error(ss.str());
+        }
+    }
+    return executable->call(outputs, inputs);
+}
+
+vector<Shape> runtime::dynamic::DynamicExecutable::get_result_shapes(
+    const vector<shared_ptr<runtime::Tensor>>& inputs)
+{
+    vector<Shape> rc;
+    for (auto& result : get_specialization(inputs)->get_results())
+    {
+        rc.push_back(result->get_shape());
+    }
+    return rc;
+}
+
+vector<runtime::PerformanceCounter>
+    runtime::dynamic::DynamicExecutable::get_performance_data() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    vector<PerformanceCounter> rc;
+    if (m_last_used != nullptr)
+    {
+        rc = m_last_used->get_performance_data();
+    }
+    return rc;
+}
+
+size_t runtime::dynamic::DynamicExecutable::get_specialization_count() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_specializations.size();
+}
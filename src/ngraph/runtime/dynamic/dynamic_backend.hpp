@@ -0,0 +1,123 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ngraph/runtime/backend.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace dynamic
+        {
+            class DynamicBackend;
+            class DynamicExecutable;
+        }
+    }
+}
+
+/// \brief Runs Functions with dynamic shapes and shape-computing ops on a static backend.
+///
+/// DynReshape, DynSlice, DynBroadcast, DynPad, Transpose and ShapeOf are resolved at call time:
+/// the Function is specialized to the shapes of the inputs and to the values of the inputs
+/// that ShapeRelevance marks as determining shapes, the shape subgraph is folded, the dynamic
+/// ops are replaced by static ones and the result is compiled by the wrapped backend. Compiled
+/// specializations are cached, so calls with shapes and shape values seen before run at the
+/// speed of the wrapped backend. Each executable keeps at most max_cached specializations and
+/// removes the least recently used one from the wrapped backend to make room for a new one.
+class ngraph::runtime::dynamic::DynamicBackend : public ngraph::runtime::Backend
+{
+public:
+    DynamicBackend(const std::shared_ptr<runtime::Backend>& wrapped_backend);
+
+    std::shared_ptr<ngraph::runtime::Tensor>
+        create_tensor(const ngraph::element::Type& element_type,
+                      const ngraph::Shape& shape) override;
+
+    std::shared_ptr<ngraph::runtime::Tensor>
+        create_tensor(const ngraph::element::Type& element_type,
+                      const ngraph::Shape& shape,
+                      void* memory_pointer) override;
+
+    std::shared_ptr<Executable> compile(std::shared_ptr<ngraph::Function> func,
+                                        bool enable_performance_data = false) override;
+
+    bool is_supported(const ngraph::Node& node) const override;
+
+    bool is_supported_property(const Property prop) const override;
+
+private:
+    std::shared_ptr<runtime::Backend> m_wrapped_backend;
+};
+
+class ngraph::runtime::dynamic::DynamicExecutable : public ngraph::runtime::Executable
+{
+public:
+    DynamicExecutable(const std::shared_ptr<ngraph::Function>& func,
+                      const std::shared_ptr<runtime::Backend>& wrapped_backend,
+                      bool enable_performance_data = false,
+                      size_t max_cached = 64);
+
+    /// \brief Output tensors must have the shapes returned by get_result_shapes(inputs)
+    bool call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+              const std::vector<std::shared_ptr<runtime::Tensor>>& inputs) override;
+
+    /// \brief Checks input element types and that input shapes refine the Parameter shapes.
+    ///     Output shapes can only be checked once the call has specialized the Function.
+    void validate(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                  const std::vector<std::shared_ptr<runtime::Tensor>>& inputs) override;
+
+    /// \brief The shapes of the results of a call with these inputs, specializing and
+    ///     compiling the Function for them if that has not been done yet
+    std::vector<Shape>
+        get_result_shapes(const std::vector<std::shared_ptr<runtime::Tensor>>& inputs);
+
+    /// \brief Performance data of the most recently used specialization
+    std::vector<PerformanceCounter> get_performance_data() const override;
+
+    /// \brief The number of cached specializations
+    size_t get_specialization_count() const;
+
+private:
+    /// \brief Looks up the specialization for these inputs, compiling it without holding
+    ///     m_mutex if it is not cached
+    std::shared_ptr<Executable>
+        get_specialization(const std::vector<std::shared_ptr<runtime::Tensor>>& inputs);
+    std::shared_ptr<Function>
+        specialize(const std::vector<std::shared_ptr<runtime::Tensor>>& inputs) const;
+
+    std::shared_ptr<ngraph::Function> m_function;
+    std::shared_ptr<runtime::Backend> m_wrapped_backend;
+    bool m_enable_performance_data;
+    size_t m_max_cached;
+    // Parameters whose values, not just shapes, determine the shapes in the Function
+    std::vector<bool> m_shape_relevant;
+
+    mutable std::mutex m_mutex;
+    // Keyed on the input element types and shapes and the values of shape-relevant inputs
+    std::map<std::string, std::shared_ptr<Executable>> m_specializations;
+    // Keys of m_specializations, most recently used first
+    std::list<std::string> m_lru;
+    std::shared_ptr<Executable> m_last_used;
+};
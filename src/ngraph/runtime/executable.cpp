@@ -14,8 +14,10 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
 #include <sstream>
 
+#include "ngraph/distributed.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/runtime/executable.hpp"
 #include "ngraph/runtime/tensor.hpp"
@@ -25,11 +27,30 @@ using namespace std;
 using namespace ngraph;
 
 runtime::Executable::Executable()
+    : m_async_queue(make_shared<AsyncQueue>())
 {
 }
 
 runtime::Executable::~Executable()
 {
+    // Every queued call holds a reference to this Executable, so none are left to run. The last
+    // reference may have been dropped by a worker, which cannot join itself.
+    {
+        lock_guard<mutex> lock(m_async_queue->mutex);
+        m_async_queue->stop = true;
+    }
+    m_async_queue->condition.notify_all();
+    for (thread& worker : m_async_workers)
+    {
+        if (worker.get_id() == this_thread::get_id())
+        {
+            worker.detach();
+        }
+        else
+        {
+            worker.join();
+        }
+    }
 }
 
 bool runtime::Executable::call_with_validate(const vector<shared_ptr<runtime::Tensor>>& outputs,
@@ -116,3 +137,60 @@ vector<runtime::PerformanceCounter> runtime::Executable::get_performance_data()
 {
     return vector<PerformanceCounter>();
 }
+
+future<bool> runtime::Executable::begin_call(const vector<shared_ptr<runtime::Tensor>>& outputs,
+                                             const vector<shared_ptr<runtime::Tensor>>& inputs)
+{
+    validate(outputs, inputs);
+
+    AsyncCall async_call;
+    async_call.executable = shared_from_this();
+    async_call.outputs = outputs;
+    async_call.inputs = inputs;
+    async_call.rank = distributed::get_thread_rank();
+    future<bool> rc = async_call.result.get_future();
+    {
+        lock_guard<mutex> lock(m_async_queue->mutex);
+        if (m_async_workers.empty())
+        {
+            size_t worker_count = max<size_t>(1, get_max_concurrent_calls());
+            for (size_t i = 0; i < worker_count; i++)
+            {
+                m_async_workers.emplace_back(&Executable::async_call_worker, m_async_queue);
+            }
+        }
+        m_async_queue->calls.push_back(move(async_call));
+    }
+    m_async_queue->condition.notify_one();
+    return rc;
+}
+
+void runtime::Executable::async_call_worker(shared_ptr<AsyncQueue> queue)
+{
+    while (true)
+    {
+        AsyncCall async_call;
+        {
+            unique_lock<mutex> lock(queue->mutex);
+            queue->condition.wait(lock, [&queue] { return queue->stop || !queue->calls.empty(); });
+            if (queue->calls.empty())
+            {
+                // Stopped and drained
+                break;
+            }
+            async_call = move(queue->calls.front());
+            queue->calls.pop_front();
+        }
+        distributed::set_thread_rank(async_call.rank);
+        try
+        {
+            async_call.result.set_value(
+                async_call.executable->call(async_call.outputs, async_call.inputs));
+        }
+        catch (...)
+        {
+            async_call.result.set_exception(current_exception());
+        }
+        // Releasing async_call may destroy the Executable, after which only queue is touched
+    }
+}
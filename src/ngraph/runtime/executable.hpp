@@ -16,7 +16,12 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 #include "ngraph/function.hpp"
 #include "ngraph/runtime/performance_counter.hpp"
@@ -32,7 +37,7 @@ namespace ngraph
     }
 }
 
-class ngraph::runtime::Executable
+class ngraph::runtime::Executable : public std::enable_shared_from_this<Executable>
 {
 public:
     Executable();
@@ -51,6 +56,25 @@ public:
     bool call_with_validate(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
                             const std::vector<std::shared_ptr<runtime::Tensor>>& inputs);
 
+    /// \brief Queues a call and returns without waiting for it to run.
+    ///
+    /// Calls are dispatched in order onto up to get_max_concurrent_calls() worker threads owned
+    /// by this Executable, so the caller can prepare the tensors of the next call while earlier
+    /// ones run. The tensors must not be touched until the returned future is ready. Each
+    /// queued call holds a reference to the Executable, which must be owned by a shared_ptr as
+    /// returned by Backend::compile, so releasing it does not cancel calls still queued.
+    /// \param outputs vector of runtime::Tensor used as outputs
+    /// \param inputs vector of runtime::Tensor used as inputs
+    /// \returns A future holding the result of call(), or the exception it threw. Arguments
+    ///     that fail validate() throw from begin_call itself.
+    std::future<bool> begin_call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                                 const std::vector<std::shared_ptr<runtime::Tensor>>& inputs);
+
+    /// \brief The number of calls that may run at the same time on this Executable. The
+    ///     default of 1 is correct for any backend; backends that keep several execution
+    ///     contexts return their context count.
+    virtual size_t get_max_concurrent_calls() const { return 1; }
+
     /// \brief Collect performance information gathered on a Function.
     /// \returns Vector of PerformanceCounter information.
     virtual std::vector<PerformanceCounter> get_performance_data() const;
@@ -58,8 +82,8 @@ public:
     /// \brief Validates a Function.
     /// \param outputs vector of runtime::Tensor used as outputs
     /// \param inputs vector of runtime::Tensor used as inputs
-    void validate(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
-                  const std::vector<std::shared_ptr<runtime::Tensor>>& inputs);
+    virtual void validate(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                          const std::vector<std::shared_ptr<runtime::Tensor>>& inputs);
 
     /// \brief Query the input Parameters
     /// \returns an ngraph::op::ParameterVector of all input parameters
@@ -76,6 +100,31 @@ protected:
     void set_parameters_and_results(const Function& func);
 
 private:
+    struct AsyncCall
+    {
+        std::shared_ptr<Executable> executable;
+        std::vector<std::shared_ptr<runtime::Tensor>> outputs;
+        std::vector<std::shared_ptr<runtime::Tensor>> inputs;
+        std::promise<bool> result;
+        // distributed::get_thread_rank() of the thread that queued the call
+        int rank;
+    };
+
+    // Shared with the worker threads, which may outlive the Executable by a few instructions
+    // when one of them drops its last reference
+    struct AsyncQueue
+    {
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::deque<AsyncCall> calls;
+        bool stop = false;
+    };
+
+    static void async_call_worker(std::shared_ptr<AsyncQueue> queue);
+
     ngraph::ParameterVector m_parameters;
     ngraph::ResultVector m_results;
+
+    std::shared_ptr<AsyncQueue> m_async_queue;
+    std::vector<std::thread> m_async_workers;
 };
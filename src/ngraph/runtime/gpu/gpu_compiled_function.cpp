@@ -176,7 +176,10 @@ void runtime::gpu::GPUCompiledFunction::compile()
     pass_manager.register_pass<ngraph::pass::AssignLayout<descriptor::layout::DenseTensorLayout>>();
     pass_manager.register_pass<ngraph::pass::GetOutputElementElimination>();
     pass_manager.register_pass<ngraph::pass::Liveness>();
-    pass_manager.register_pass<ngraph::pass::MemoryLayout>(get_memory_alignment());
+    pass_manager.register_pass<ngraph::pass::MemoryLayout>(
+        get_memory_alignment(),
+        false,
+        ngraph::pass::MemoryLayout::get_planner(pass_manager.get_pass_config()));
     pass_manager.register_pass<runtime::gpu::pass::TensorMemoryReservation>(
         *allocator, m_tensor_memory_buffers);
     string dump_filename = file_util::path_join(get_output_dir(), m_function_name + "_ops.txt");
@@ -14,6 +14,8 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <mutex>
+
 #include "ngraph/runtime/interpreter/int_executable.hpp"
 #include "ngraph/descriptor/layout/dense_tensor_layout.hpp"
 #include "ngraph/except.hpp"
@@ -27,7 +29,9 @@
 #include "ngraph/pass/liveness.hpp"
 #include "ngraph/pass/manager.hpp"
 #include "ngraph/pass/memory_layout.hpp"
+#include "ngraph/pass/share_constants.hpp"
 #include "ngraph/runtime/backend_manager.hpp"
+#include "ngraph/trace.hpp"
 #include "ngraph/util.hpp"
 
 using namespace std;
@@ -43,174 +47,320 @@ runtime::interpreter::INTExecutable::INTExecutable(const shared_ptr<Function>& f
     pass::Manager pass_manager;
     pass_manager.register_pass<pass::LikeReplacement>();
     pass_manager.register_pass<pass::FusedOpDecomposition>();
+    pass_manager.register_pass<pass::ShareConstants>();
     pass_manager.register_pass<pass::AssignLayout<DenseTensorLayout>>();
     pass_manager.register_pass<pass::Liveness>();
+    pass_manager.register_pass<pass::MemoryLayout>(
+        get_alignment(), false, pass::MemoryLayout::get_planner(pass_manager.get_pass_config()));
     pass_manager.run_passes(function);
 
-    for (const shared_ptr<Node>& node : function->get_ordered_ops())
-    {
-        m_wrapped_nodes.emplace_back(node);
-    }
     set_parameters_and_results(*function);
-}
 
-bool runtime::interpreter::INTExecutable::call(const vector<shared_ptr<runtime::Tensor>>& outputs,
-                                               const vector<shared_ptr<runtime::Tensor>>& inputs)
-{
-    // convert inputs to HostTensor
-    vector<shared_ptr<HostTensor>> func_inputs;
-    for (auto tensor : inputs)
+    m_temporary_pool.reset(
+        new runtime::AlignedBuffer(function->get_temporary_pool_size(), get_alignment()));
+
+    // Every tensor is resolved once here. Caller supplied tensors are recorded as bindings,
+    // everything else is backed by a HostTensor owned by this executable.
+    unordered_map<descriptor::Tensor*, size_t> input_index;
+    unordered_map<descriptor::Tensor*, size_t> output_index;
+    for (auto param : get_parameters())
     {
-        auto host_tensor = static_pointer_cast<runtime::HostTensor>(tensor);
-        func_inputs.push_back(host_tensor);
+        for (size_t i = 0; i < param->get_output_size(); ++i)
+        {
+            descriptor::Tensor* tensor = &param->output(i).get_tensor();
+            input_index.insert({tensor, input_index.size()});
+        }
     }
-    if (m_nan_check_enabled)
+    for (auto result : get_results())
     {
-        perform_nan_check(func_inputs);
+        descriptor::Tensor* tensor = &result->output(0).get_tensor();
+        output_index.insert({tensor, output_index.size()});
     }
 
-    // convert outputs to HostTensor
-    vector<shared_ptr<HostTensor>> func_outputs;
-    for (auto tensor : outputs)
+    unordered_map<descriptor::Tensor*, HostTensor*> tensor_map;
+    m_trace_ops = trace::is_enabled();
+    for (const shared_ptr<Node>& node : function->get_ordered_ops())
     {
-        auto host_tensor = static_pointer_cast<runtime::HostTensor>(tensor);
-        func_outputs.push_back(host_tensor);
-    }
+        if (node->is_parameter())
+        {
+            continue;
+        }
+        NodeWrapper wrapped(node);
+        m_steps.emplace_back(wrapped, get_kernel(wrapped));
+        ExecutionStep& step = m_steps.back();
+        if (m_trace_ops)
+        {
+            step.trace_name = trace::intern(node->get_name());
+        }
 
-    // map function params -> HostTensor
-    unordered_map<descriptor::Tensor*, shared_ptr<HostTensor>> tensor_map;
-    size_t input_count = 0;
-    for (auto param : get_parameters())
-    {
-        for (size_t i = 0; i < param->get_output_size(); ++i)
+        for (auto input : node->inputs())
         {
-            descriptor::Tensor* tensor = &param->output(i).get_tensor();
-            tensor_map.insert({tensor, func_inputs[input_count++]});
+            descriptor::Tensor* tensor = &input.get_tensor();
+            auto it = tensor_map.find(tensor);
+            if (it == tensor_map.end())
+            {
+                m_input_bindings.push_back(
+                    {m_steps.size() - 1, step.inputs.size(), input_index.at(tensor)});
+                step.inputs.push_back(nullptr);
+            }
+            else
+            {
+                step.inputs.push_back(it->second);
+            }
+        }
+
+        // Intermediate outputs are placed in the temporary pool at the offsets planned by
+        // MemoryLayout. Tensors outside of the plan, such as Constant outputs, get their
+        // own buffer. Either way they are created once here and reused by every call that
+        // runs on the first call frame.
+        for (size_t i = 0; i < node->get_output_size(); ++i)
+        {
+            descriptor::Tensor* tensor = &node->output(i).get_tensor();
+            HostTensor* host_tensor = nullptr;
+            auto it = output_index.find(tensor);
+            if (it != output_index.end())
+            {
+                m_output_bindings.push_back({m_steps.size() - 1, i, it->second});
+            }
+            else
+            {
+                void* memory_pointer = nullptr;
+                size_t pool_offset = NOT_IN_POOL;
+                if (node->liveness_new_list.count(tensor) != 0)
+                {
+                    pool_offset = tensor->get_pool_offset();
+                    memory_pointer = m_temporary_pool->get_ptr(pool_offset);
+                }
+                m_intermediate_tensors.push_back(
+                    make_shared<runtime::HostTensor>(node->get_output_element_type(i),
+                                                     node->get_output_shape(i),
+                                                     memory_pointer,
+                                                     tensor->get_name()));
+                m_intermediate_offsets.push_back(pool_offset);
+                host_tensor = m_intermediate_tensors.back().get();
+                tensor_map.insert({tensor, host_tensor});
+            }
+            step.outputs.push_back(host_tensor);
         }
     }
+    m_step_totals.resize(m_steps.size());
+}
 
-    // map function outputs -> HostTensor
-    for (size_t output_count = 0; output_count < get_results().size(); ++output_count)
+bool runtime::interpreter::INTExecutable::call(const vector<shared_ptr<runtime::Tensor>>& outputs,
+                                               const vector<shared_ptr<runtime::Tensor>>& inputs)
+{
+    if (m_nan_check_enabled)
     {
-        auto output = get_results()[output_count];
-        if (!dynamic_pointer_cast<op::Result>(output))
+        vector<HostTensor*> func_inputs;
+        for (auto tensor : inputs)
         {
-            throw ngraph_error("One of function's outputs isn't op::Result");
+            func_inputs.push_back(static_cast<HostTensor*>(tensor.get()));
         }
-        descriptor::Tensor* tensor = &output->output(0).get_tensor();
-        tensor_map.insert({tensor, func_outputs[output_count]});
+        perform_nan_check(func_inputs);
     }
 
-    // for each ordered op in the graph
-    for (const NodeWrapper& wrapped : m_wrapped_nodes)
+    unique_ptr<CallFrame> frame;
+    bool use_template_memory = false;
     {
-        auto op = wrapped.get_node();
-        auto type_id = wrapped.get_typeid();
-        if (type_id == OP_TYPEID::Parameter)
+        lock_guard<mutex> lock(m_frames_mutex);
+        if (!m_idle_frames.empty())
         {
-            continue;
+            frame = move(m_idle_frames.back());
+            m_idle_frames.pop_back();
         }
-
-        // get op inputs from map
-        vector<shared_ptr<HostTensor>> op_inputs;
-        for (auto input : op->inputs())
+        else if (!m_template_memory_in_use)
         {
-            descriptor::Tensor* tensor = &input.get_tensor();
-            op_inputs.push_back(tensor_map.at(tensor));
+            m_template_memory_in_use = true;
+            use_template_memory = true;
         }
+    }
+    if (!frame)
+    {
+        frame = make_call_frame(use_template_memory);
+    }
+    try
+    {
+        run_steps(frame->steps, outputs, inputs);
+    }
+    catch (...)
+    {
+        release_call_frame(move(frame));
+        throw;
+    }
+    release_call_frame(move(frame));
+
+    return true;
+}
 
-        // get op outputs from map or create
-        vector<shared_ptr<HostTensor>> op_outputs;
-        for (size_t i = 0; i < op->get_output_size(); ++i)
+unique_ptr<runtime::interpreter::INTExecutable::CallFrame>
+    runtime::interpreter::INTExecutable::make_call_frame(bool use_template_memory) const
+{
+    unique_ptr<CallFrame> frame(new CallFrame);
+    frame->steps = m_steps;
+    if (use_template_memory)
+    {
+        return frame;
+    }
+
+    frame->pool.reset(new AlignedBuffer(m_temporary_pool->size(), get_alignment()));
+    unordered_map<HostTensor*, HostTensor*> tensor_map;
+    for (size_t i = 0; i < m_intermediate_tensors.size(); ++i)
+    {
+        const shared_ptr<HostTensor>& tensor = m_intermediate_tensors[i];
+        size_t pool_offset = m_intermediate_offsets[i];
+        frame->intermediate_tensors.push_back(make_shared<HostTensor>(
+            tensor->get_element_type(),
+            tensor->get_shape(),
+            pool_offset == NOT_IN_POOL ? nullptr : frame->pool->get_ptr(pool_offset),
+            tensor->get_name()));
+        tensor_map.insert({tensor.get(), frame->intermediate_tensors.back().get()});
+    }
+    for (ExecutionStep& step : frame->steps)
+    {
+        for (HostTensor*& tensor : step.inputs)
         {
-            descriptor::Tensor* tensor = &op->output(i).get_tensor();
-            shared_ptr<HostTensor> host_tensor;
             auto it = tensor_map.find(tensor);
-            if (it == tensor_map.end())
+            if (it != tensor_map.end())
             {
-                const Shape& shape = op->get_output_shape(i);
-                const element::Type& type = op->get_output_element_type(i);
-                string name = op->output(i).get_tensor().get_name();
-                host_tensor = make_shared<runtime::HostTensor>(type, shape, name);
-                tensor_map.insert({tensor, host_tensor});
+                tensor = it->second;
             }
-            else
+        }
+        for (HostTensor*& tensor : step.outputs)
+        {
+            auto it = tensor_map.find(tensor);
+            if (it != tensor_map.end())
             {
-                host_tensor = it->second;
+                tensor = it->second;
             }
-            op_outputs.push_back(host_tensor);
         }
+    }
+    return frame;
+}
 
-        // get op type
-        element::Type type;
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wswitch-enum"
-        switch (type_id)
+void runtime::interpreter::INTExecutable::release_call_frame(unique_ptr<CallFrame> frame)
+{
+    lock_guard<mutex> lock(m_frames_mutex);
+    if (m_performance_counters_enabled)
+    {
+        for (size_t i = 0; i < frame->steps.size(); ++i)
         {
-        case OP_TYPEID::Convert:
-        case OP_TYPEID::Quantize:
-        case OP_TYPEID::Dequantize:
-        case OP_TYPEID::ArgMin:
-        case OP_TYPEID::ArgMax: type = op->get_input_element_type(0); break;
-        case OP_TYPEID::Equal:
-        case OP_TYPEID::Greater:
-        case OP_TYPEID::GreaterEq:
-        case OP_TYPEID::Less:
-        case OP_TYPEID::LessEq:
-        case OP_TYPEID::NotEqual:
-            // Get the type of the second input, not the first
-            // All BinaryElementwiseComparision ops have the same type for inputs
-            // Select has bool for first input and the type we are interested in for the second
-            type = op->get_input_element_type(1);
-            break;
-        case OP_TYPEID::TopK: type = op->get_output_element_type(1); break;
-        default: type = op->get_output_element_type(0); break;
+            stopwatch& timer = frame->steps[i].timer;
+            m_step_totals[i].first += chrono::nanoseconds(timer.get_total_nanoseconds());
+            m_step_totals[i].second += timer.get_call_count();
+            timer = stopwatch();
         }
-#pragma GCC diagnostic pop
+    }
+    m_idle_frames.push_back(move(frame));
+}
+
+void runtime::interpreter::INTExecutable::run_steps(
+    vector<ExecutionStep>& steps,
+    const vector<shared_ptr<runtime::Tensor>>& outputs,
+    const vector<shared_ptr<runtime::Tensor>>& inputs)
+{
+    // bind the caller's tensors into the precompiled steps
+    for (const ExternalBinding& binding : m_input_bindings)
+    {
+        steps[binding.step].inputs[binding.argument] =
+            static_cast<HostTensor*>(inputs[binding.index].get());
+    }
+    for (const ExternalBinding& binding : m_output_bindings)
+    {
+        steps[binding.step].outputs[binding.argument] =
+            static_cast<HostTensor*>(outputs[binding.index].get());
+    }
 
+    static const uint32_t trace_category = trace::intern("Op");
+    bool traced = m_trace_ops && trace::sample();
+    for (ExecutionStep& step : steps)
+    {
+        uint64_t trace_start = traced ? trace::now() : 0;
         if (m_performance_counters_enabled)
         {
-            m_timer_map[op].start();
+            step.timer.start();
         }
-        generate_calls(type, wrapped, op_outputs, op_inputs);
+        (this->*step.kernel)(step.wrapped_node, step.outputs, step.inputs);
         if (m_performance_counters_enabled)
         {
-            m_timer_map[op].stop();
+            step.timer.stop();
+        }
+        if (traced)
+        {
+            trace::record(trace_category, step.trace_name, trace_start, trace::now());
         }
         if (m_nan_check_enabled)
         {
-            perform_nan_check(op_outputs, op.get());
+            perform_nan_check(step.outputs, step.wrapped_node.get_node().get());
         }
     }
 
-    return true;
 }
 
-void runtime::interpreter::INTExecutable::generate_calls(const element::Type& type,
-                                                         const NodeWrapper& op,
-                                                         const vector<shared_ptr<HostTensor>>& out,
-                                                         const vector<shared_ptr<HostTensor>>& in)
+element::Type runtime::interpreter::INTExecutable::get_dispatch_type(const NodeWrapper& wrapped)
 {
-    stringstream ss;
-    switch (type.get_type_enum())
+    auto op = wrapped.get_node();
+    element::Type type;
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wswitch-enum"
+    switch (wrapped.get_typeid())
+    {
+    case OP_TYPEID::Convert:
+    case OP_TYPEID::Quantize:
+    case OP_TYPEID::Dequantize:
+    case OP_TYPEID::ArgMin:
+    case OP_TYPEID::ArgMax: type = op->get_input_element_type(0); break;
+    case OP_TYPEID::Equal:
+    case OP_TYPEID::Greater:
+    case OP_TYPEID::GreaterEq:
+    case OP_TYPEID::Less:
+    case OP_TYPEID::LessEq:
+    case OP_TYPEID::NotEqual:
+        // Get the type of the second input, not the first
+        // All BinaryElementwiseComparision ops have the same type for inputs
+        // Select has bool for first input and the type we are interested in for the second
+        type = op->get_input_element_type(1);
+        break;
+    case OP_TYPEID::TopK: type = op->get_output_element_type(1); break;
+    default: type = op->get_output_element_type(0); break;
+    }
+#pragma GCC diagnostic pop
+    return type;
+}
+
+runtime::interpreter::INTExecutable::KernelFunction
+    runtime::interpreter::INTExecutable::get_kernel(const NodeWrapper& op)
+{
+    KernelFunction kernel = &INTExecutable::unsupported_kernel;
+    switch (get_dispatch_type(op).get_type_enum())
     {
-    case element::Type_t::boolean: op_engine<char>(op, out, in); break;
-    case element::Type_t::f32: op_engine<float>(op, out, in); break;
-    case element::Type_t::f64: op_engine<double>(op, out, in); break;
-    case element::Type_t::i8: op_engine<int8_t>(op, out, in); break;
-    case element::Type_t::i16: op_engine<int16_t>(op, out, in); break;
-    case element::Type_t::i32: op_engine<int32_t>(op, out, in); break;
-    case element::Type_t::i64: op_engine<int64_t>(op, out, in); break;
-    case element::Type_t::u8: op_engine<uint8_t>(op, out, in); break;
-    case element::Type_t::u16: op_engine<uint16_t>(op, out, in); break;
-    case element::Type_t::u32: op_engine<uint32_t>(op, out, in); break;
-    case element::Type_t::u64: op_engine<uint64_t>(op, out, in); break;
+    case element::Type_t::boolean: kernel = &INTExecutable::op_engine<char>; break;
+    case element::Type_t::f32: kernel = &INTExecutable::op_engine<float>; break;
+    case element::Type_t::f64: kernel = &INTExecutable::op_engine<double>; break;
+    case element::Type_t::i8: kernel = &INTExecutable::op_engine<int8_t>; break;
+    case element::Type_t::i16: kernel = &INTExecutable::op_engine<int16_t>; break;
+    case element::Type_t::i32: kernel = &INTExecutable::op_engine<int32_t>; break;
+    case element::Type_t::i64: kernel = &INTExecutable::op_engine<int64_t>; break;
+    case element::Type_t::u8: kernel = &INTExecutable::op_engine<uint8_t>; break;
+    case element::Type_t::u16: kernel = &INTExecutable::op_engine<uint16_t>; break;
+    case element::Type_t::u32: kernel = &INTExecutable::op_engine<uint32_t>; break;
+    case element::Type_t::u64: kernel = &INTExecutable::op_engine<uint64_t>; break;
     case element::Type_t::undefined:
     case element::Type_t::dynamic:
     case element::Type_t::bf16:
-        ss << "unsupported element type " << type << " op " << op.get_node()->get_name();
-        throw ngraph_error(ss.str());
+    case element::Type_t::f16: break;
     }
+    return kernel;
+}
+
+void runtime::interpreter::INTExecutable::unsupported_kernel(const NodeWrapper& op,
+                                                             const vector<HostTensor*>& outputs,
+                                                             const vector<HostTensor*>& inputs)
+{
+    // Unsupported types are reported when the op is executed, not when it is compiled
+    stringstream ss;
+    ss << "unsupported element type " << get_dispatch_type(op) << " op "
+       << op.get_node()->get_name();
+    throw ngraph_error(ss.str());
 }
 
 void runtime::interpreter::INTExecutable::set_nan_check(bool enable)
@@ -222,18 +372,25 @@ vector<runtime::PerformanceCounter>
     runtime::interpreter::INTExecutable::get_performance_data() const
 {
     vector<runtime::PerformanceCounter> rc;
-    for (const pair<shared_ptr<const Node>, stopwatch> p : m_timer_map)
+    lock_guard<mutex> lock(m_frames_mutex);
+    for (size_t i = 0; i < m_step_totals.size(); ++i)
     {
-        rc.emplace_back(p.first, p.second.get_total_microseconds(), p.second.get_call_count());
+        if (m_step_totals[i].second > 0)
+        {
+            rc.emplace_back(
+                m_steps[i].wrapped_node.get_node(),
+                chrono::duration_cast<chrono::microseconds>(m_step_totals[i].first).count(),
+                m_step_totals[i].second);
+        }
     }
     return rc;
 }
 
 void runtime::interpreter::INTExecutable::perform_nan_check(
-    const vector<shared_ptr<HostTensor>>& tensors, const Node* op)
+    const vector<HostTensor*>& tensors, const Node* op)
 {
     size_t arg_number = 1;
-    for (const shared_ptr<HostTensor>& tensor : tensors)
+    for (HostTensor* tensor : tensors)
     {
         const element::Type& type = tensor->get_element_type();
         if (type == element::f32)
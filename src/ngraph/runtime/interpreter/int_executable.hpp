@@ -16,8 +16,11 @@
 
 #pragma once
 
+#include <chrono>
 #include <initializer_list>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -170,27 +173,99 @@ public:
     std::vector<PerformanceCounter> get_performance_data() const override;
 
 private:
+    using KernelFunction = void (INTExecutable::*)(const NodeWrapper&,
+                                                   const std::vector<HostTensor*>&,
+                                                   const std::vector<HostTensor*>&);
+
+    /// \brief A single precompiled op invocation. The argument vectors hold the op's tensors
+    /// in input/output order. Entries that refer to the caller's tensors are filled in from
+    /// m_input_bindings and m_output_bindings at the start of each call.
+    struct ExecutionStep
+    {
+        ExecutionStep(const NodeWrapper& node, KernelFunction kernel)
+            : wrapped_node{node}
+            , kernel{kernel}
+        {
+        }
+
+        NodeWrapper wrapped_node;
+        KernelFunction kernel;
+        std::vector<HostTensor*> inputs;
+        std::vector<HostTensor*> outputs;
+        stopwatch timer;
+        /// \brief trace::intern id of the node name, set if tracing was enabled at compile time
+        uint32_t trace_name = 0;
+    };
+
+    /// \brief An ExecutionStep argument that is bound to the call's index'th input or output
+    struct ExternalBinding
+    {
+        size_t step;
+        size_t argument;
+        size_t index;
+    };
+
+    /// \brief The steps and intermediate tensors of one call in flight. A call checks a frame
+    /// out of m_idle_frames, so concurrent calls never share binding slots, timers or
+    /// intermediate memory.
+    struct CallFrame
+    {
+        std::vector<ExecutionStep> steps;
+        std::unique_ptr<AlignedBuffer> pool;
+        std::vector<std::shared_ptr<HostTensor>> intermediate_tensors;
+    };
+
+    /// \brief Copies the step template. The first frame runs on the template's own
+    /// intermediate tensors, later ones get a temporary pool and tensors of their own.
+    std::unique_ptr<CallFrame> make_call_frame(bool use_template_memory) const;
+    /// \brief Returns frame to m_idle_frames, adding its step timers to the totals
+    void release_call_frame(std::unique_ptr<CallFrame> frame);
+
+    /// \brief Binds the caller's tensors into steps and runs them in order
+    void run_steps(std::vector<ExecutionStep>& steps,
+                   const std::vector<std::shared_ptr<Tensor>>& outputs,
+                   const std::vector<std::shared_ptr<Tensor>>& inputs);
+
     int get_alignment() const { return 64; }
     bool m_is_compiled = false;
     bool m_nan_check_enabled = false;
     bool m_performance_counters_enabled = false;
-    std::unordered_map<std::shared_ptr<const Node>, stopwatch> m_timer_map;
-    std::vector<NodeWrapper> m_wrapped_nodes;
+    bool m_trace_ops = false;
+    /// \brief The step template, only written while compiling. Calls run on copies of it.
+    std::vector<ExecutionStep> m_steps;
+    std::vector<ExternalBinding> m_input_bindings;
+    std::vector<ExternalBinding> m_output_bindings;
     std::unordered_map<const Node*, std::shared_ptr<RNGState>> m_states;
     std::set<std::string> m_unsupported_op_name_list;
 
-    static void perform_nan_check(const std::vector<std::shared_ptr<HostTensor>>&,
-                                  const Node* op = nullptr);
+    /// \brief Backing store for the intermediate tensors the step template refers to, sized by
+    /// pass::MemoryLayout. Only the first call frame uses it.
+    std::unique_ptr<AlignedBuffer> m_temporary_pool;
+    std::vector<std::shared_ptr<HostTensor>> m_intermediate_tensors;
+    /// \brief Offset of each intermediate tensor in m_temporary_pool, or NOT_IN_POOL
+    std::vector<size_t> m_intermediate_offsets;
+    static constexpr size_t NOT_IN_POOL = std::numeric_limits<size_t>::max();
+
+    /// \brief Guards the frames and the performance totals below
+    mutable std::mutex m_frames_mutex;
+    std::vector<std::unique_ptr<CallFrame>> m_idle_frames;
+    bool m_template_memory_in_use = false;
+    /// \brief Time and count of every step, summed over the calls that have finished
+    std::vector<std::pair<std::chrono::nanoseconds, size_t>> m_step_totals;
+
+    static void perform_nan_check(const std::vector<HostTensor*>&, const Node* op = nullptr);
+
+    static element::Type get_dispatch_type(const NodeWrapper& op);
+    static KernelFunction get_kernel(const NodeWrapper& op);
 
-    void generate_calls(const element::Type& type,
-                        const NodeWrapper& op,
-                        const std::vector<std::shared_ptr<HostTensor>>& outputs,
-                        const std::vector<std::shared_ptr<HostTensor>>& inputs);
+    void unsupported_kernel(const NodeWrapper& op,
+                            const std::vector<HostTensor*>& outputs,
+                            const std::vector<HostTensor*>& inputs);
 
     template <typename T>
     void op_engine(const NodeWrapper& node_wrapper,
-                   const std::vector<std::shared_ptr<HostTensor>>& out,
-                   const std::vector<std::shared_ptr<HostTensor>>& args)
+                   const std::vector<HostTensor*>& out,
+                   const std::vector<HostTensor*>& args)
     {
         const Node& node = *node_wrapper.get_node();
 
@@ -786,13 +861,13 @@ private:
 
             std::vector<std::shared_ptr<Tensor>> outputs;
             std::vector<std::shared_ptr<Tensor>> inputs;
-            for (const std::shared_ptr<HostTensor>& t : out)
+            for (HostTensor* t : out)
             {
                 auto backend_tensor = backend->create_tensor(
                     t->get_element_type(), t->get_shape(), t->get_data_ptr());
                 outputs.push_back(backend_tensor);
             }
-            for (const std::shared_ptr<HostTensor>& t : args)
+            for (HostTensor* t : args)
             {
                 auto backend_tensor = backend->create_tensor(
                     t->get_element_type(), t->get_shape(), t->get_data_ptr());
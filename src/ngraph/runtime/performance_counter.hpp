@@ -17,6 +17,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 
 #include "ngraph/node.hpp"
@@ -41,9 +42,21 @@ namespace ngraph
                 return m_call_count == 0 ? 0 : m_total_microseconds / m_call_count;
             }
             size_t call_count() const { return m_call_count; }
+            /// \brief True if the backend collected hardware event counts for this op
+            bool has_hardware_counters() const { return m_hardware_counters; }
+            /// \brief Hardware event totals over all calls
+            uint64_t cycles() const { return m_cycles; }
+            uint64_t instructions() const { return m_instructions; }
+            uint64_t cache_misses() const { return m_cache_misses; }
+            uint64_t branch_misses() const { return m_branch_misses; }
             std::shared_ptr<const Node> m_node;
             size_t m_total_microseconds;
             size_t m_call_count;
+            bool m_hardware_counters = false;
+            uint64_t m_cycles = 0;
+            uint64_t m_instructions = 0;
+            uint64_t m_cache_misses = 0;
+            uint64_t m_branch_misses = 0;
         };
     }
 }
@@ -19,6 +19,7 @@
 #include <cmath>
 
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/reference/strided_iterator.hpp"
 #include "ngraph/shape_util.hpp"
 
 namespace ngraph
@@ -34,16 +35,19 @@ namespace ngraph
                            const Shape& out_shape,
                            const AxisSet& broadcast_axes)
             {
-                CoordinateTransform input_transform(in_shape);
-                CoordinateTransform output_transform(out_shape);
-
-                for (const Coordinate& output_coord : output_transform)
+                // Broadcast axes do not advance through the input
+                Strides in_row_major_strides = row_major_strides(in_shape);
+                Strides in_strides(out_shape.size(), 0);
+                size_t in_axis = 0;
+                for (size_t i = 0; i < out_shape.size(); i++)
                 {
-                    Coordinate input_coord = reduce(output_coord, broadcast_axes);
-
-                    out[output_transform.index(output_coord)] =
-                        arg[input_transform.index(input_coord)];
+                    if (broadcast_axes.count(i) == 0)
+                    {
+                        in_strides[i] = in_row_major_strides.at(in_axis++);
+                    }
                 }
+
+                strided_copy(arg, out, out_shape, in_strides);
             }
         }
     }
@@ -19,6 +19,7 @@
 #include <cmath>
 #include <utility>
 
+#include "ngraph/check.hpp"
 #include "ngraph/coordinate_transform.hpp"
 #include "ngraph/shape_util.hpp"
 
@@ -37,83 +38,33 @@ namespace ngraph
                      const Shape& out_shape,
                      size_t reduction_axes_count)
             {
-                // Get the sizes of the dot axes. It's easiest to pull them from arg1 because they're
-                // right up front.
-                Shape dot_axis_sizes(reduction_axes_count);
-                std::copy(arg1_shape.begin(),
-                          arg1_shape.begin() + reduction_axes_count,
-                          dot_axis_sizes.begin());
-
-                CoordinateTransform arg0_transform(arg0_shape);
-                CoordinateTransform arg1_transform(arg1_shape);
-                CoordinateTransform output_transform(out_shape);
-
-                // Create coordinate transforms for arg0 and arg1 that throw away the dotted axes.
+                // The dotted axes are the innermost axes of arg0 and the outermost axes of arg1,
+                // so both arguments are row-major matrices once the projected axes and the dotted
+                // axes are each flattened. The output is the row-major product of those matrices.
                 size_t arg0_projected_rank = arg0_shape.size() - reduction_axes_count;
-                size_t arg1_projected_rank = arg1_shape.size() - reduction_axes_count;
-
-                Shape arg0_projected_shape(arg0_projected_rank);
-                std::copy(arg0_shape.begin(),
-                          arg0_shape.begin() + arg0_projected_rank,
-                          arg0_projected_shape.begin());
 
-                Shape arg1_projected_shape(arg1_projected_rank);
-                std::copy(arg1_shape.begin() + reduction_axes_count,
-                          arg1_shape.end(),
-                          arg1_projected_shape.begin());
+                size_t arg0_projected_size = shape_size(Shape(
+                    arg0_shape.begin(), arg0_shape.begin() + arg0_projected_rank));
+                size_t dot_axes_size = shape_size(
+                    Shape(arg1_shape.begin(), arg1_shape.begin() + reduction_axes_count));
+                size_t arg1_projected_size = shape_size(
+                    Shape(arg1_shape.begin() + reduction_axes_count, arg1_shape.end()));
 
-                CoordinateTransform arg0_projected_transform(arg0_projected_shape);
-                CoordinateTransform arg1_projected_transform(arg1_projected_shape);
+                NGRAPH_CHECK(arg0_projected_size * arg1_projected_size == shape_size(out_shape));
 
-                // Create a coordinate transform that allows us to iterate over all possible values
-                // for the dotted axes.
-                CoordinateTransform dot_axes_transform(dot_axis_sizes);
-
-                for (const Coordinate& arg0_projected_coord : arg0_projected_transform)
+                for (size_t i = 0; i < arg0_projected_size; i++)
                 {
-                    for (const Coordinate& arg1_projected_coord : arg1_projected_transform)
+                    const T* arg0_row = arg0 + i * dot_axes_size;
+                    T* out_row = out + i * arg1_projected_size;
+                    for (size_t j = 0; j < arg1_projected_size; j++)
                     {
-                        // The output coordinate is just the concatenation of the projected coordinates.
-                        Coordinate out_coord(arg0_projected_coord.size() +
-                                             arg1_projected_coord.size());
-
-                        auto out_coord_it = std::copy(arg0_projected_coord.begin(),
-                                                      arg0_projected_coord.end(),
-                                                      out_coord.begin());
-                        std::copy(
-                            arg1_projected_coord.begin(), arg1_projected_coord.end(), out_coord_it);
-
-                        // Zero out to start the sum.
+                        // Zero out to start the sum, then walk along the dotted axes.
                         T sum = 0;
-
-                        size_t out_index = output_transform.index(out_coord);
-
-                        // Walk along the dotted axes.
-                        Coordinate arg0_coord(arg0_shape.size());
-                        Coordinate arg1_coord(arg1_shape.size());
-                        auto arg0_it = std::copy(arg0_projected_coord.begin(),
-                                                 arg0_projected_coord.end(),
-                                                 arg0_coord.begin());
-                        for (const Coordinate& dot_axis_positions : dot_axes_transform)
+                        for (size_t k = 0; k < dot_axes_size; k++)
                         {
-                            // In order to find the points to multiply together, we need to inject our current
-                            // positions along the dotted axes back into the projected arg0 and arg1 coordinates.
-                            std::copy(
-                                dot_axis_positions.begin(), dot_axis_positions.end(), arg0_it);
-
-                            auto arg1_it = std::copy(dot_axis_positions.begin(),
-                                                     dot_axis_positions.end(),
-                                                     arg1_coord.begin());
-                            std::copy(
-                                arg1_projected_coord.begin(), arg1_projected_coord.end(), arg1_it);
-
-                            // Multiply and add to the sum.
-                            sum += arg0[arg0_transform.index(arg0_coord)] *
-                                   arg1[arg1_transform.index(arg1_coord)];
+                            sum += arg0_row[k] * arg1[k * arg1_projected_size + j];
                         }
-
-                        // Write the sum back.
-                        out[out_index] = sum;
+                        out_row[j] = sum;
                     }
                 }
             }
@@ -21,6 +21,7 @@
 #include "ngraph/axis_vector.hpp"
 #include "ngraph/check.hpp"
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/reference/strided_iterator.hpp"
 
 namespace ngraph
 {
@@ -35,29 +36,21 @@ namespace ngraph
                          const AxisVector& in_axis_order,
                          const Shape& out_shape)
             {
-                // Unfortunately we don't yet have a constructor for CoordinateTransform that lets us pass only source_space_shape
-                // and source_axis_order so we have to construct the defaults here.
-                Shape in_start_corner(in_shape.size(), 0); // (0,...0)
-                Strides in_strides(in_shape.size(), 1);    // (1,...,1)
+                NGRAPH_CHECK(in_axis_order.size() == in_shape.size());
 
-                CoordinateTransform input_transform(
-                    in_shape, in_start_corner, in_shape, in_strides, in_axis_order);
-                CoordinateTransform output_transform(out_shape);
-
-                NGRAPH_CHECK(shape_size(input_transform.get_target_shape()) ==
-                             shape_size(output_transform.get_target_shape()));
-
-                CoordinateTransform::Iterator output_it = output_transform.begin();
-
-                for (const Coordinate& input_coord : input_transform)
+                // Walk the input in the permuted axis order, writing the output sequentially
+                Strides in_row_major_strides = row_major_strides(in_shape);
+                Shape transposed_shape(in_shape.size());
+                Strides in_strides(in_shape.size());
+                for (size_t i = 0; i < in_shape.size(); i++)
                 {
-                    const Coordinate& output_coord = *output_it;
+                    transposed_shape[i] = in_shape[in_axis_order[i]];
+                    in_strides[i] = in_row_major_strides[in_axis_order[i]];
+                }
 
-                    out[output_transform.index(output_coord)] =
-                        arg[input_transform.index(input_coord)];
+                NGRAPH_CHECK(shape_size(transposed_shape) == shape_size(out_shape));
 
-                    ++output_it;
-                }
+                strided_copy(arg, out, transposed_shape, in_strides);
             }
         }
     }
@@ -20,6 +20,8 @@
 
 #include "ngraph/check.hpp"
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/reference/strided_iterator.hpp"
+#include "ngraph/util.hpp"
 
 namespace ngraph
 {
@@ -36,22 +38,24 @@ namespace ngraph
                        const Strides& strides,
                        const Shape& out_shape)
             {
-                CoordinateTransform input_transform(arg_shape, lower_bounds, upper_bounds, strides);
-                CoordinateTransform output_transform(out_shape);
-
-                CoordinateTransform::Iterator output_it = output_transform.begin();
-
-                NGRAPH_CHECK(shape_size(input_transform.get_target_shape()) ==
-                             shape_size(output_transform.get_target_shape()));
-
-                for (const Coordinate& in_coord : input_transform)
+                NGRAPH_CHECK(lower_bounds.size() == arg_shape.size() &&
+                             upper_bounds.size() == arg_shape.size() &&
+                             strides.size() == arg_shape.size());
+
+                Strides arg_row_major_strides = row_major_strides(arg_shape);
+                Shape slice_shape(arg_shape.size());
+                Strides arg_strides(arg_shape.size());
+                size_t arg_offset = 0;
+                for (size_t i = 0; i < arg_shape.size(); i++)
                 {
-                    const Coordinate& out_coord = *output_it;
+                    slice_shape[i] = ceil_div(upper_bounds[i] - lower_bounds[i], strides[i]);
+                    arg_strides[i] = arg_row_major_strides[i] * strides[i];
+                    arg_offset += arg_row_major_strides[i] * lower_bounds[i];
+                }
 
-                    out[output_transform.index(out_coord)] = arg[input_transform.index(in_coord)];
+                NGRAPH_CHECK(shape_size(slice_shape) == shape_size(out_shape));
 
-                    ++output_it;
-                }
+                strided_copy(arg, out, slice_shape, arg_strides, arg_offset);
             }
         }
     }
@@ -0,0 +1,177 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "ngraph/coordinate.hpp"
+#include "ngraph/shape.hpp"
+#include "ngraph/strides.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace reference
+        {
+            /// \brief Walks an iteration space in row-major order while tracking the element
+            /// offset of N tensors, each addressed through its own per-axis element strides.
+            ///
+            /// Axes of extent 1 are dropped and adjacent axes that are contiguous for every
+            /// tensor are collapsed into one. The innermost remaining axis is not walked by the
+            /// iterator; it is exposed as a run of run_length() elements so that kernels can
+            /// process it with a plain loop. A stride of 0 repeats the same element, which is
+            /// how broadcast and reduction axes are expressed.
+            template <size_t N>
+            class StridedIterator
+            {
+            public:
+                /// \param shape The iteration space.
+                /// \param strides For each tensor, the element stride of every axis of shape.
+                /// \param offsets For each tensor, the element offset of the first position.
+                StridedIterator(const Shape& shape,
+                                const std::array<Strides, N>& strides,
+                                const std::array<size_t, N>& offsets = std::array<size_t, N>{})
+                    : m_offsets(offsets)
+                    , m_is_end(shape_size(shape) == 0)
+                {
+                    for (size_t axis = shape.size(); axis-- > 0;)
+                    {
+                        if (shape[axis] == 1)
+                        {
+                            continue;
+                        }
+                        bool contiguous = !m_shape.empty();
+                        for (size_t k = 0; k < N && contiguous; k++)
+                        {
+                            contiguous = strides[k][axis] == m_strides[k].back() * m_shape.back();
+                        }
+                        if (contiguous)
+                        {
+                            m_shape.back() *= shape[axis];
+                        }
+                        else
+                        {
+                            m_shape.push_back(shape[axis]);
+                            for (size_t k = 0; k < N; k++)
+                            {
+                                m_strides[k].push_back(strides[k][axis]);
+                            }
+                        }
+                    }
+
+                    // Axes were collected innermost first
+                    std::reverse(m_shape.begin(), m_shape.end());
+                    for (size_t k = 0; k < N; k++)
+                    {
+                        std::reverse(m_strides[k].begin(), m_strides[k].end());
+                    }
+
+                    m_run_length = 1;
+                    m_run_strides.fill(0);
+                    if (!m_shape.empty())
+                    {
+                        m_run_length = m_shape.back();
+                        m_shape.pop_back();
+                        for (size_t k = 0; k < N; k++)
+                        {
+                            m_run_strides[k] = m_strides[k].back();
+                            m_strides[k].pop_back();
+                        }
+                    }
+                    m_coordinate.assign(m_shape.size(), 0);
+                }
+
+                /// \brief Advance to the start of the next run
+                void operator++()
+                {
+                    for (size_t axis = m_shape.size(); axis-- > 0;)
+                    {
+                        for (size_t k = 0; k < N; k++)
+                        {
+                            m_offsets[k] += m_strides[k][axis];
+                        }
+                        if (++m_coordinate[axis] < m_shape[axis])
+                        {
+                            return;
+                        }
+                        for (size_t k = 0; k < N; k++)
+                        {
+                            m_offsets[k] -= m_strides[k][axis] * m_shape[axis];
+                        }
+                        m_coordinate[axis] = 0;
+                    }
+                    m_is_end = true;
+                }
+
+                bool is_end() const { return m_is_end; }
+                /// \brief Element offset of the first element of the current run in tensor k
+                size_t offset(size_t k) const { return m_offsets[k]; }
+                /// \brief Number of elements in every run
+                size_t run_length() const { return m_run_length; }
+                /// \brief Element stride between consecutive run elements in tensor k
+                size_t run_stride(size_t k) const { return m_run_strides[k]; }
+            private:
+                Shape m_shape;
+                std::array<Strides, N> m_strides;
+                std::array<size_t, N> m_offsets;
+                std::array<size_t, N> m_run_strides;
+                size_t m_run_length;
+                Coordinate m_coordinate;
+                bool m_is_end;
+            };
+
+            /// \brief Copy the elements of arg, addressed through arg_strides over shape, into
+            /// out, which is dense and row-major over shape.
+            template <typename T>
+            void strided_copy(const T* arg,
+                              T* out,
+                              const Shape& shape,
+                              const Strides& arg_strides,
+                              size_t arg_offset = 0)
+            {
+                StridedIterator<2> it(
+                    shape, {{arg_strides, row_major_strides(shape)}}, {{arg_offset, 0}});
+                for (; !it.is_end(); ++it)
+                {
+                    const T* src = arg + it.offset(0);
+                    T* dst = out + it.offset(1);
+                    size_t count = it.run_length();
+                    size_t stride = it.run_stride(0);
+                    if (stride == 1)
+                    {
+                        std::copy(src, src + count, dst);
+                    }
+                    else if (stride == 0)
+                    {
+                        std::fill(dst, dst + count, *src);
+                    }
+                    else
+                    {
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            dst[i] = src[i * stride];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -17,8 +17,10 @@
 #pragma once
 
 #include <cmath>
+#include <vector>
 
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/reference/strided_iterator.hpp"
 #include "ngraph/shape_util.hpp"
 
 namespace ngraph
@@ -34,26 +36,42 @@ namespace ngraph
                      const Shape& out_shape,
                      const AxisSet& reduction_axes)
             {
-                CoordinateTransform output_transform(out_shape);
-                std::vector<T> c(shape_size(out_shape));
-
-                for (const Coordinate& output_coord : output_transform)
+                size_t out_size = shape_size(out_shape);
+                std::vector<T> c(out_size);
+                for (size_t i = 0; i < out_size; i++)
                 {
-                    out[output_transform.index(output_coord)] = 0;
-                    c[output_transform.index(output_coord)] = 0;
+                    out[i] = 0;
+                    c[i] = 0;
                 }
 
-                CoordinateTransform input_transform(in_shape);
+                // Reduction axes do not advance through the output
+                Strides out_row_major_strides = row_major_strides(out_shape);
+                Strides out_strides(in_shape.size(), 0);
+                size_t out_axis = 0;
+                for (size_t i = 0; i < in_shape.size(); i++)
+                {
+                    if (reduction_axes.count(i) == 0)
+                    {
+                        out_strides[i] = out_row_major_strides.at(out_axis++);
+                    }
+                }
 
-                for (const Coordinate& input_coord : input_transform)
+                // Kahan summation, accumulated in input order
+                StridedIterator<2> it(in_shape, {{row_major_strides(in_shape), out_strides}});
+                for (; !it.is_end(); ++it)
                 {
-                    Coordinate output_coord = reduce(input_coord, reduction_axes);
-                    T y = arg[input_transform.index(input_coord)] -
-                          c[output_transform.index(output_coord)];
-                    T t = out[output_transform.index(output_coord)] + y;
-                    c[output_transform.index(output_coord)] =
-                        (t - out[output_transform.index(output_coord)]) - y;
-                    out[output_transform.index(output_coord)] = t;
+                    const T* in_run = arg + it.offset(0);
+                    size_t in_stride = it.run_stride(0);
+                    size_t out_index = it.offset(1);
+                    size_t out_stride = it.run_stride(1);
+                    for (size_t i = 0; i < it.run_length(); i++)
+                    {
+                        T y = in_run[i * in_stride] - c[out_index];
+                        T t = out[out_index] + y;
+                        c[out_index] = (t - out[out_index]) - y;
+                        out[out_index] = t;
+                        out_index += out_stride;
+                    }
                 }
             }
         }
@@ -16,7 +16,9 @@
 
 #include <fstream>
 #include <functional>
+#include <limits>
 
+#include "ngraph/binary_model.hpp"
 #include "ngraph/cpio.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/graph_util.hpp"
@@ -119,6 +121,7 @@
 #include "ngraph/op/tan.hpp"
 #include "ngraph/op/tanh.hpp"
 #include "ngraph/op/topk.hpp"
+#include "ngraph/runtime/aligned_buffer.hpp"
 #include "ngraph/serializer.hpp"
 #include "ngraph/util.hpp"
 #include "nlohmann/json.hpp"
@@ -308,10 +311,16 @@ static void serialize_to_cpio(ostream& out, shared_ptr<ngraph::Function> func, s
                        [&](shared_ptr<Node> node) {
                            if (auto c = dynamic_pointer_cast<op::Constant>(node))
                            {
-                               uint32_t size =
-                                   static_cast<uint32_t>(shape_size(c->get_output_shape(0)) *
-                                                         c->get_output_element_type(0).size());
-                               writer.write(c->get_name(), c->get_data_ptr(), size);
+                               size_t size = shape_size(c->get_output_shape(0)) *
+                                             c->get_output_element_type(0).size();
+                               if (size > numeric_limits<uint32_t>::max())
+                               {
+                                   throw ngraph_error("Constant " + c->get_name() +
+                                                      " is too large for cpio, use "
+                                                      "serialize_binary");
+                               }
+                               writer.write(
+                                   c->get_name(), c->get_data_ptr(), static_cast<uint32_t>(size));
                            }
                        },
                        true);
@@ -348,21 +357,105 @@ std::string ngraph::serialize(std::shared_ptr<ngraph::Function> func, size_t ind
     return ::serialize(func, indent, false);
 }
 
+void ngraph::serialize_binary(const string& path, shared_ptr<ngraph::Function> func)
+{
+    ofstream out(path, ios_base::binary | ios_base::out);
+    serialize_binary(out, func);
+}
+
+void ngraph::serialize_binary(ostream& out, shared_ptr<ngraph::Function> func)
+{
+    // The first record is the model, followed by one record per constant
+    string j = ::serialize(func, 0, true);
+    binary_model::Writer writer(out);
+    writer.write(func->get_name(), j.data(), j.size());
+
+    traverse_functions(func, [&](shared_ptr<ngraph::Function> f) {
+        traverse_nodes(const_cast<Function*>(f.get()),
+                       [&](shared_ptr<Node> node) {
+                           if (auto c = dynamic_pointer_cast<op::Constant>(node))
+                           {
+                               size_t size = shape_size(c->get_output_shape(0)) *
+                                             c->get_output_element_type(0).size();
+                               writer.write(c->get_name(), c->get_data_ptr(), size);
+                           }
+                       },
+                       true);
+    });
+}
+
+static shared_ptr<ngraph::Function> deserialize(binary_model::Reader& reader)
+{
+    shared_ptr<Function> rc;
+    const vector<binary_model::Record>& records = reader.get_records();
+    if (records.size() > 0)
+    {
+        // The first record is the model
+        string jstr(records[0].get_size(), '\0');
+        reader.read(records[0], &jstr[0]);
+        json js = json::parse(jstr);
+        unordered_map<string, shared_ptr<Function>> function_map;
+        for (json func : js)
+        {
+            shared_ptr<Function> f = read_function(
+                func,
+                function_map,
+                [&](const string& const_name, const element::Type& et, const Shape& shape) {
+                    shared_ptr<Node> const_node;
+                    const binary_model::Record* record = reader.find(const_name);
+                    if (record)
+                    {
+                        if (record->get_size() != shape_size(shape) * et.size())
+                        {
+                            throw ngraph_error("Size of constant " + const_name +
+                                               " does not match its shape");
+                        }
+                        if (reader.is_mapped())
+                        {
+                            // Use the mapped data in place
+                            const_node = make_shared<op::Constant>(
+                                et, shape, reader.get_data(*record), reader.get_mapping());
+                        }
+                        else
+                        {
+                            auto buffer =
+                                make_shared<runtime::AlignedBuffer>(record->get_size(), 64);
+                            reader.read(*record, buffer->get_ptr());
+                            const_node =
+                                make_shared<op::Constant>(et, shape, buffer->get_ptr(), buffer);
+                        }
+                    }
+                    return const_node;
+                });
+            rc = f;
+        }
+    }
+    return rc;
+}
+
 shared_ptr<ngraph::Function> ngraph::deserialize(istream& in)
 {
     shared_ptr<Function> rc;
-    if (cpio::is_cpio(in))
+    if (binary_model::is_binary_model(in))
+    {
+        binary_model::Reader reader(in);
+        rc = ::deserialize(reader);
+    }
+    else if (cpio::is_cpio(in))
     {
         cpio::Reader reader(in);
         vector<cpio::FileInfo> file_info = reader.get_file_info();
         if (file_info.size() > 0)
         {
+            unordered_map<string, const cpio::FileInfo*> file_map;
+            for (const cpio::FileInfo& info : file_info)
+            {
+                file_map.insert({info.get_name(), &info});
+            }
+
             // The first file is the model
-            uint32_t size = static_cast<uint32_t>(file_info[0].get_size());
-            char* data = new char[size];
-            reader.read(file_info[0].get_name(), data, size);
-            string jstr(data, size);
-            delete[] data;
+            string jstr(file_info[0].get_size(), '\0');
+            reader.read(file_info[0].get_name(), &jstr[0], jstr.size());
             json js = json::parse(jstr);
             unordered_map<string, shared_ptr<Function>> function_map;
             for (json func : js)
@@ -372,16 +465,14 @@ shared_ptr<ngraph::Function> ngraph::deserialize(istream& in)
                     function_map,
                     [&](const string& const_name, const element::Type& et, const Shape& shape) {
                         shared_ptr<Node> const_node;
-                        for (const cpio::FileInfo& info : file_info)
+                        auto it = file_map.find(const_name);
+                        if (it != file_map.end())
                         {
-                            if (info.get_name() == const_name)
-                            {
-                                void* const_data = ngraph_malloc(info.get_size());
-                                reader.read(const_name, const_data, info.get_size());
-                                const_node = make_shared<op::Constant>(et, shape, const_data);
-                                ngraph_free(const_data);
-                                break;
-                            }
+                            size_t size = it->second->get_size();
+                            auto buffer = make_shared<runtime::AlignedBuffer>(size, 64);
+                            reader.read(const_name, buffer->get_ptr(), size);
+                            const_node =
+                                make_shared<op::Constant>(et, shape, buffer->get_ptr(), buffer);
                         }
                         return const_node;
                     });
@@ -405,8 +496,16 @@ shared_ptr<ngraph::Function> ngraph::deserialize(const string& s)
     if (file_util::exists(s))
     {
         // s is a file and not a json string
-        ifstream in(s, ios_base::binary | ios_base::in);
-        rc = deserialize(in);
+        if (binary_model::is_binary_model(s))
+        {
+            binary_model::Reader reader(s);
+            rc = ::deserialize(reader);
+        }
+        else
+        {
+            ifstream in(s, ios_base::binary | ios_base::in);
+            rc = deserialize(in);
+        }
     }
     else
     {
@@ -48,12 +48,27 @@ namespace ngraph
     ///    indent level specified.
     void serialize(std::ostream& out, std::shared_ptr<ngraph::Function> func, size_t indent = 0);
 
+    /// \brief Serialize a Function to a binary model file
+    ///
+    /// The graph is stored as json and the data of every constant is stored as a separate,
+    /// aligned record with 64-bit offsets, so models larger than 4GB are supported. Loading the
+    /// file with deserialize(path) memory maps it and constants use the mapped data in place.
+    /// \param path The path to the output file
+    /// \param func The Function to serialize
+    void serialize_binary(const std::string& path, std::shared_ptr<ngraph::Function> func);
+
+    /// \brief Serialize a Function to a binary model stream
+    /// \param out The output stream to which the data is serialized.
+    /// \param func The Function to serialize
+    void serialize_binary(std::ostream& out, std::shared_ptr<ngraph::Function> func);
+
     /// \brief Deserialize a Function
     /// \param in An isteam to the input data
     std::shared_ptr<ngraph::Function> deserialize(std::istream& in);
 
     /// \brief Deserialize a Function
-    /// \param str The json formatted string to deseriailze.
+    /// \param str The json formatted string to deseriailze, or the path of a file. A binary model
+    ///    file is memory mapped and its constants reference the mapping rather than copies.
     std::shared_ptr<ngraph::Function> deserialize(const std::string& str);
 
     /// \brief If enabled adds output shapes to the serialized graph
@@ -0,0 +1,355 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+// windows.h must be before processthreadsapi.h so we need this comment
+#include <processthreadsapi.h>
+#define getpid() GetCurrentProcessId()
+#else
+#include <unistd.h>
+#endif
+
+#include "ngraph/log.hpp"
+#include "ngraph/trace.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+namespace
+{
+    // Slots are written by the owning thread and may be read by an exporting thread at the
+    // same time, so every field is atomic. Relaxed accesses compile to plain moves.
+    struct Slot
+    {
+        atomic<uint64_t> start;
+        atomic<uint64_t> end;
+        atomic<uint64_t> ids;
+    };
+
+    struct ThreadBuffer
+    {
+        ThreadBuffer(size_t capacity, size_t thread_index)
+            : slots(new Slot[capacity])
+            , mask(capacity - 1)
+            , tid(thread_index)
+            , started(0)
+            , head(0)
+            , cleared(0)
+        {
+        }
+
+        unique_ptr<Slot[]> slots;
+        size_t mask;
+        size_t tid;
+        // Number of events whose recording has started and finished. Event i lives in slot
+        // i & mask until event i + capacity starts.
+        atomic<uint64_t> started;
+        atomic<uint64_t> head;
+        // Events before this one were dropped by clear(). Only clear() writes it, so the owning
+        // thread can keep recording while the buffer is cleared.
+        atomic<uint64_t> cleared;
+    };
+
+    // Set in the category half of Slot::ids for counter samples, whose end holds the value
+    const uint64_t counter_flag = uint64_t(1) << 63;
+
+    struct Event
+    {
+        uint64_t start;
+        uint64_t end;
+        uint64_t ids;
+        size_t tid;
+    };
+
+    size_t get_env_size(const char* name, size_t default_value)
+    {
+        const char* value = getenv(name);
+        return value ? strtoul(value, nullptr, 10) : default_value;
+    }
+
+    class Tracer
+    {
+    public:
+        Tracer()
+            : m_enabled(getenv("NGRAPH_ENABLE_TRACING") != nullptr)
+            , m_write_at_exit(m_enabled)
+            , m_sample_rate(max(get_env_size("NGRAPH_TRACE_SAMPLE_RATE", 1), size_t(1)))
+            , m_capacity(1)
+        {
+            // Round the buffer size up to a power of two so that slots are found by masking
+            size_t capacity = max(get_env_size("NGRAPH_TRACE_BUFFER_SIZE", 65536), size_t(2));
+            while (m_capacity < capacity)
+            {
+                m_capacity <<= 1;
+            }
+            const char* file_name = getenv("NGRAPH_TRACE_FILE");
+            m_file_name = file_name ? file_name : "ngraph_event_trace.json";
+        }
+
+        ~Tracer()
+        {
+            if (m_write_at_exit)
+            {
+                write_file();
+            }
+        }
+
+        uint32_t intern(const string& name)
+        {
+            lock_guard<mutex> lock(m_mutex);
+            auto it = m_name_ids.find(name);
+            if (it != m_name_ids.end())
+            {
+                return it->second;
+            }
+            uint32_t id = static_cast<uint32_t>(m_names.size());
+            m_names.push_back(name);
+            m_name_ids.insert({name, id});
+            return id;
+        }
+
+        ThreadBuffer& get_thread_buffer()
+        {
+            thread_local shared_ptr<ThreadBuffer> buffer;
+            if (!buffer)
+            {
+                lock_guard<mutex> lock(m_mutex);
+                buffer = make_shared<ThreadBuffer>(m_capacity, m_buffers.size());
+                m_buffers.push_back(buffer);
+            }
+            return *buffer;
+        }
+
+        vector<Event> collect()
+        {
+            vector<Event> events;
+            lock_guard<mutex> lock(m_mutex);
+            for (const shared_ptr<ThreadBuffer>& buffer : m_buffers)
+            {
+                uint64_t head = buffer->head.load(memory_order_acquire);
+                uint64_t capacity = buffer->mask + 1;
+                uint64_t first = max(head > capacity ? head - capacity : 0,
+                                     buffer->cleared.load(memory_order_relaxed));
+                first = min(first, head);
+                size_t begin = events.size();
+                for (uint64_t i = first; i < head; i++)
+                {
+                    const Slot& slot = buffer->slots[i & buffer->mask];
+                    events.push_back({slot.start.load(memory_order_relaxed),
+                                      slot.end.load(memory_order_relaxed),
+                                      slot.ids.load(memory_order_relaxed),
+                                      buffer->tid});
+                }
+                // Drop the events the owning thread may have overwritten while they were copied
+                atomic_thread_fence(memory_order_acquire);
+                uint64_t started = buffer->started.load(memory_order_relaxed);
+                if (started > capacity + first)
+                {
+                    size_t overwritten = min(started - capacity - first, head - first);
+                    events.erase(events.begin() + begin, events.begin() + begin + overwritten);
+                }
+            }
+            return events;
+        }
+
+        void clear()
+        {
+            lock_guard<mutex> lock(m_mutex);
+            for (const shared_ptr<ThreadBuffer>& buffer : m_buffers)
+            {
+                buffer->cleared.store(buffer->head.load(memory_order_acquire),
+                                      memory_order_relaxed);
+            }
+        }
+
+        void write(ostream& out)
+        {
+            vector<Event> events = collect();
+            vector<string> names;
+            {
+                lock_guard<mutex> lock(m_mutex);
+                names.assign(m_names.begin(), m_names.end());
+            }
+            int pid = getpid();
+            ios_base::fmtflags flags = out.flags();
+            streamsize precision = out.precision();
+            char fill = out.fill();
+            out << "{\"traceEvents\":[";
+            out << fixed << setprecision(3);
+            for (size_t i = 0; i < events.size(); i++)
+            {
+                const Event& event = events[i];
+                bool counter = (event.ids & counter_flag) != 0;
+                out << (i == 0 ? "\n" : ",\n") << "{\"name\":";
+                write_string(out, names.at(event.ids & 0xFFFFFFFF));
+                out << ",\"cat\":";
+                write_string(out, names.at((event.ids & ~counter_flag) >> 32));
+                // Chrome trace timestamps are in microseconds
+                out << ",\"ph\":\"" << (counter ? "C" : "X") << "\",\"pid\":" << pid
+                    << ",\"tid\":" << event.tid << ",\"ts\":" << event.start / 1000.0;
+                if (counter)
+                {
+                    out << ",\"args\":{\"value\":" << event.end << "}}";
+                }
+                else
+                {
+                    out << ",\"dur\":" << (event.end - event.start) / 1000.0 << "}";
+                }
+            }
+            out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+            out.flags(flags);
+            out.precision(precision);
+            out.fill(fill);
+        }
+
+        void write_file()
+        {
+            ofstream out(m_file_name);
+            write(out);
+            if (!out)
+            {
+                NGRAPH_WARN << "Unable to write trace file " << m_file_name;
+            }
+        }
+
+        atomic<bool> m_enabled;
+        bool m_write_at_exit;
+        size_t m_sample_rate;
+
+    private:
+        static void write_string(ostream& out, const string& s)
+        {
+            out << '"';
+            for (char c : s)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    out << '\\' << c;
+                }
+                else if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    out << "\\u" << hex << setw(4) << setfill('0') << static_cast<int>(c)
+                        << dec << setfill(' ');
+                }
+                else
+                {
+                    out << c;
+                }
+            }
+            out << '"';
+        }
+
+        size_t m_capacity;
+        string m_file_name;
+        mutex m_mutex;
+        deque<string> m_names;
+        unordered_map<string, uint32_t> m_name_ids;
+        vector<shared_ptr<ThreadBuffer>> m_buffers;
+    };
+
+    Tracer& get_tracer()
+    {
+        static Tracer tracer;
+        return tracer;
+    }
+}
+
+bool trace::is_enabled()
+{
+    return get_tracer().m_enabled.load(memory_order_relaxed);
+}
+
+void trace::enable()
+{
+    get_tracer().m_enabled.store(true, memory_order_relaxed);
+}
+
+void trace::disable()
+{
+    get_tracer().m_enabled.store(false, memory_order_relaxed);
+}
+
+uint32_t trace::intern(const string& name)
+{
+    return get_tracer().intern(name);
+}
+
+bool trace::sample()
+{
+    Tracer& tracer = get_tracer();
+    if (!tracer.m_enabled.load(memory_order_relaxed))
+    {
+        return false;
+    }
+    thread_local size_t count = 0;
+    return count++ % tracer.m_sample_rate == 0;
+}
+
+uint64_t trace::now()
+{
+    return chrono::duration_cast<chrono::nanoseconds>(
+               chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+static void record_slot(uint64_t ids, uint64_t start, uint64_t end)
+{
+    ThreadBuffer& buffer = get_tracer().get_thread_buffer();
+    uint64_t head = buffer.head.load(memory_order_relaxed);
+    buffer.started.store(head + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    Slot& slot = buffer.slots[head & buffer.mask];
+    slot.start.store(start, memory_order_relaxed);
+    slot.end.store(end, memory_order_relaxed);
+    slot.ids.store(ids, memory_order_relaxed);
+    buffer.head.store(head + 1, memory_order_release);
+}
+
+void trace::record(uint32_t category, uint32_t name, uint64_t start, uint64_t end)
+{
+    record_slot(static_cast<uint64_t>(category) << 32 | name, start, end);
+}
+
+void trace::record_counter(uint32_t category, uint32_t name, uint64_t time, uint64_t value)
+{
+    record_slot(counter_flag | static_cast<uint64_t>(category) << 32 | name, time, value);
+}
+
+void trace::write_chrome_trace(ostream& out)
+{
+    get_tracer().write(out);
+}
+
+void trace::write_chrome_trace()
+{
+    get_tracer().write_file();
+}
+
+void trace::clear()
+{
+    get_tracer().clear();
+}
@@ -0,0 +1,94 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace ngraph
+{
+    /// \brief Process-wide event tracing for compilation and execution.
+    ///
+    /// Each thread records complete events into its own fixed-size ring buffer without taking
+    /// a lock, so a full buffer overwrites its oldest events. Names and categories are interned
+    /// once and events carry only their ids and nanosecond timestamps. The buffers are
+    /// exported together as a Chrome trace, viewable at chrome://tracing.
+    ///
+    /// Tracing is enabled by NGRAPH_ENABLE_TRACING, in which case the trace is written to
+    /// NGRAPH_TRACE_FILE (default ngraph_event_trace.json) at exit. Backends trace the ops of
+    /// one call in every NGRAPH_TRACE_SAMPLE_RATE calls (default 1). NGRAPH_TRACE_BUFFER_SIZE
+    /// sets the number of events each thread keeps (default 65536).
+    namespace trace
+    {
+        bool is_enabled();
+        void enable();
+        void disable();
+
+        /// \brief Returns the id of name, which stays valid for the lifetime of the process
+        uint32_t intern(const std::string& name);
+
+        /// \brief Returns true if tracing is enabled and this call of the calling thread is
+        ///     one selected by the sample rate
+        bool sample();
+
+        /// \brief Nanoseconds on a monotonic clock
+        uint64_t now();
+
+        /// \brief Records an event that ran from start to end, both from now()
+        void record(uint32_t category, uint32_t name, uint64_t start, uint64_t end);
+
+        /// \brief Records the value of a counter, such as a node count, at time
+        void record_counter(uint32_t category, uint32_t name, uint64_t time, uint64_t value);
+
+        /// \brief Writes the buffered events of every thread in Chrome trace format
+        void write_chrome_trace(std::ostream& out);
+
+        /// \brief Writes the buffered events to NGRAPH_TRACE_FILE
+        void write_chrome_trace();
+
+        /// \brief Drops the events every thread has buffered so far. Threads may keep recording,
+        ///     an event that finishes while clear() runs may be kept or dropped.
+        void clear();
+
+        /// \brief Records the lifetime of the scope if tracing was enabled when it started
+        class Scope
+        {
+        public:
+            Scope(uint32_t category, uint32_t name)
+                : m_category(category)
+                , m_name(name)
+                , m_start(is_enabled() ? now() : 0)
+            {
+            }
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+            ~Scope()
+            {
+                if (m_start != 0)
+                {
+                    record(m_category, m_name, m_start, now());
+                }
+            }
+
+        private:
+            uint32_t m_category;
+            uint32_t m_name;
+            uint64_t m_start;
+        };
+    }
+}
@@ -14,7 +14,14 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
 #include <random>
+#include <thread>
 #if defined(__x86_64__) || defined(__amd64__)
 #include <xmmintrin.h>
 #endif
@@ -126,96 +133,255 @@ static void random_init(shared_ptr<runtime::Tensor> tv)
     }
 }
 
-vector<runtime::PerformanceCounter> run_benchmark(shared_ptr<Function> f,
-                                                  const string& backend_name,
-                                                  size_t iterations,
-                                                  bool timing_detail,
-                                                  int warmup_iterations,
-                                                  bool copy_data)
+double BenchmarkResult::mean() const
 {
-    stopwatch timer;
-    timer.start();
-    auto backend = runtime::Backend::create(backend_name);
-    auto compiled_func = backend->compile(f, timing_detail);
-    timer.stop();
-    cout.imbue(locale(""));
-    cout << "compile time: " << timer.get_milliseconds() << "ms" << endl;
+    double sum = 0;
+    for (double latency : latencies)
+    {
+        sum += latency;
+    }
+    return latencies.empty() ? 0 : sum / latencies.size();
+}
+
+double BenchmarkResult::percentile(double p) const
+{
+    if (latencies.empty())
+    {
+        return 0;
+    }
+    size_t rank = static_cast<size_t>(ceil(p / 100.0 * latencies.size()));
+    return latencies[min(max(rank, size_t(1)), latencies.size()) - 1];
+}
+
+double BenchmarkResult::throughput() const
+{
+    return wall_milliseconds > 0 ? latencies.size() * 1000.0 / wall_milliseconds : 0;
+}
+
+namespace
+{
+    // Input and output tensors owned by one calling thread
+    struct CallData
+    {
+        vector<shared_ptr<runtime::HostTensor>> arg_data;
+        vector<shared_ptr<runtime::Tensor>> args;
+        vector<shared_ptr<runtime::HostTensor>> result_data;
+        vector<shared_ptr<runtime::Tensor>> results;
+    };
+}
 
-    vector<shared_ptr<runtime::HostTensor>> arg_data;
-    vector<shared_ptr<runtime::Tensor>> args;
-    vector<bool> args_cacheable;
+static CallData create_call_data(runtime::Backend& backend, shared_ptr<Function> f)
+{
+    CallData data;
     for (shared_ptr<op::Parameter> param : f->get_parameters())
     {
-        auto tensor = backend->create_tensor(param->get_element_type(), param->get_shape());
+        auto tensor = backend.create_tensor(param->get_element_type(), param->get_shape());
         auto tensor_data =
             make_shared<runtime::HostTensor>(param->get_element_type(), param->get_shape());
         random_init(tensor_data);
         tensor->write(tensor_data->get_data_ptr(),
                       0,
                       tensor_data->get_element_count() * tensor_data->get_element_type().size());
-        args.push_back(tensor);
-        arg_data.push_back(tensor_data);
-        args_cacheable.push_back(param->get_cacheable());
+        if (param->get_cacheable())
+        {
+            tensor->set_stale(false);
+        }
+        data.args.push_back(tensor);
+        data.arg_data.push_back(tensor_data);
     }
-    set_denormals_flush_to_zero();
-
-    vector<shared_ptr<runtime::HostTensor>> result_data;
-    vector<shared_ptr<runtime::Tensor>> results;
     for (shared_ptr<Node> out : f->get_results())
     {
-        auto result = backend->create_tensor(out->get_element_type(), out->get_shape());
+        auto result = backend.create_tensor(out->get_element_type(), out->get_shape());
         auto tensor_data =
             make_shared<runtime::HostTensor>(out->get_element_type(), out->get_shape());
-        results.push_back(result);
-        result_data.push_back(tensor_data);
+        data.results.push_back(result);
+        data.result_data.push_back(tensor_data);
     }
+    return data;
+}
 
-    for (size_t i = 0; i < args.size(); i++)
+// Runs one iteration and returns its latency in microseconds
+static double timed_call(runtime::Executable& exec, CallData& data, bool copy_data)
+{
+    auto start = chrono::steady_clock::now();
+    if (copy_data)
     {
-        if (args_cacheable[i])
+        for (size_t arg_index = 0; arg_index < data.args.size(); arg_index++)
         {
-            args[i]->set_stale(false);
+            const shared_ptr<runtime::Tensor>& arg = data.args[arg_index];
+            if (arg->get_stale())
+            {
+                const shared_ptr<runtime::HostTensor>& host = data.arg_data[arg_index];
+                arg->write(host->get_data_ptr(),
+                           0,
+                           host->get_element_count() * host->get_element_type().size());
+            }
         }
     }
+    exec.call(data.results, data.args);
+    if (copy_data)
+    {
+        for (size_t result_index = 0; result_index < data.results.size(); result_index++)
+        {
+            const shared_ptr<runtime::HostTensor>& host = data.result_data[result_index];
+            const shared_ptr<runtime::Tensor>& result = data.results[result_index];
+            result->read(host->get_data_ptr(),
+                         0,
+                         host->get_element_count() * host->get_element_type().size());
+        }
+    }
+    chrono::duration<double, micro> elapsed = chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
 
-    stopwatch t1;
-    for (size_t i = 0; i < iterations + warmup_iterations; i++)
+// Calls exec in windows of calls until the median latency of one window is within 5% of the
+// previous window's. Returns the number of calls made.
+static size_t warm_up_to_steady_state(runtime::Executable& exec,
+                                      CallData& data,
+                                      bool copy_data,
+                                      size_t max_iterations)
+{
+    const size_t window = 10;
+    const double tolerance = 0.05;
+    vector<double> latencies(window);
+    double previous_median = 0;
+    size_t count = 0;
+    while (count + window <= max_iterations)
     {
-        if (i == warmup_iterations)
+        for (double& latency : latencies)
         {
-            t1.start();
+            latency = timed_call(exec, data, copy_data);
         }
-        if (copy_data)
+        count += window;
+        nth_element(latencies.begin(), latencies.begin() + window / 2, latencies.end());
+        double median = latencies[window / 2];
+        if (previous_median > 0 && fabs(median - previous_median) <= tolerance * previous_median)
         {
-            for (size_t arg_index = 0; arg_index < args.size(); arg_index++)
+            break;
+        }
+        previous_median = median;
+    }
+    return count;
+}
+
+BenchmarkResult run_benchmark(shared_ptr<Function> f,
+                              const string& backend_name,
+                              const BenchmarkOptions& options)
+{
+    BenchmarkResult result;
+    size_t thread_count = max(options.threads, size_t(1));
+
+    stopwatch timer;
+    timer.start();
+    auto backend = runtime::Backend::create(backend_name);
+    auto compiled_func = backend->compile(f, options.timing_detail);
+    timer.stop();
+    result.compile_milliseconds = timer.get_milliseconds();
+
+    // An executable only admits get_max_concurrent_calls() callers at a time, so each group of
+    // that many threads gets its own compiled copy
+    size_t threads_per_executable = max(compiled_func->get_max_concurrent_calls(), size_t(1));
+    vector<shared_ptr<runtime::Executable>> executables{compiled_func};
+    while (executables.size() * threads_per_executable < thread_count)
+    {
+        executables.push_back(backend->compile(f, options.timing_detail));
+    }
+
+    vector<CallData> call_data;
+    for (size_t i = 0; i < thread_count; i++)
+    {
+        call_data.push_back(create_call_data(*backend, f));
+    }
+
+    if (options.steady_state)
+    {
+        set_denormals_flush_to_zero();
+        result.warmup_iterations = warm_up_to_steady_state(
+            *compiled_func, call_data[0], options.copy_data, options.max_warmup_iterations);
+    }
+    result.warmup_iterations += options.warmup_iterations;
+
+    // Every thread warms up, then waits until all are ready so that the timed phase measures
+    // the callers running concurrently
+    mutex start_mutex;
+    condition_variable start_condition;
+    size_t ready_count = 0;
+    bool started = false;
+    vector<vector<double>> thread_latencies(thread_count);
+    vector<exception_ptr> errors(thread_count);
+    auto worker = [&](size_t index) {
+        set_denormals_flush_to_zero();
+        CallData& data = call_data[index];
+        runtime::Executable& exec = *executables[index / threads_per_executable];
+        try
+        {
+            for (size_t i = 0; i < options.warmup_iterations; i++)
             {
-                const shared_ptr<runtime::Tensor>& arg = args[arg_index];
-                if (arg->get_stale())
-                {
-                    const shared_ptr<runtime::HostTensor>& data = arg_data[arg_index];
-                    arg->write(data->get_data_ptr(),
-                               0,
-                               data->get_element_count() * data->get_element_type().size());
-                }
+                timed_call(exec, data, options.copy_data);
             }
         }
-        compiled_func->call(results, args);
-        if (copy_data)
+        catch (...)
+        {
+            errors[index] = current_exception();
+        }
         {
-            for (size_t result_index = 0; result_index < results.size(); result_index++)
+            unique_lock<mutex> lock(start_mutex);
+            ready_count++;
+            start_condition.notify_all();
+            start_condition.wait(lock, [&]() { return started; });
+        }
+        if (errors[index])
+        {
+            return;
+        }
+        try
+        {
+            vector<double>& latencies = thread_latencies[index];
+            latencies.reserve(options.iterations);
+            for (size_t i = 0; i < options.iterations; i++)
             {
-                const shared_ptr<runtime::HostTensor>& data = result_data[result_index];
-                const shared_ptr<runtime::Tensor>& result = results[result_index];
-                result->read(data->get_data_ptr(),
-                             0,
-                             data->get_element_count() * data->get_element_type().size());
+                latencies.push_back(timed_call(exec, data, options.copy_data));
             }
         }
+        catch (...)
+        {
+            errors[index] = current_exception();
+        }
+    };
+
+    vector<thread> threads;
+    for (size_t i = 0; i < thread_count; i++)
+    {
+        threads.emplace_back(worker, i);
+    }
+    stopwatch wall_timer;
+    {
+        unique_lock<mutex> lock(start_mutex);
+        start_condition.wait(lock, [&]() { return ready_count == thread_count; });
+        wall_timer.start();
+        started = true;
+    }
+    start_condition.notify_all();
+    for (thread& t : threads)
+    {
+        t.join();
+    }
+    wall_timer.stop();
+
+    for (const exception_ptr& error : errors)
+    {
+        if (error)
+        {
+            rethrow_exception(error);
+        }
     }
-    t1.stop();
-    float time = t1.get_milliseconds();
-    cout << time / iterations << "ms per iteration" << endl;
 
-    vector<runtime::PerformanceCounter> perf_data = compiled_func->get_performance_data();
-    return perf_data;
+    result.wall_milliseconds = wall_timer.get_microseconds() / 1000.0;
+    for (const vector<double>& latencies : thread_latencies)
+    {
+        result.latencies.insert(result.latencies.end(), latencies.begin(), latencies.end());
+    }
+    sort(result.latencies.begin(), result.latencies.end());
+    result.perf_data = compiled_func->get_performance_data();
+    return result;
 }
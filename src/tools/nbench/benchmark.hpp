@@ -28,9 +28,41 @@
 std::multimap<size_t, std::string>
     aggregate_timing(const std::vector<ngraph::runtime::PerformanceCounter>& perf_data);
 
-std::vector<ngraph::runtime::PerformanceCounter> run_benchmark(std::shared_ptr<ngraph::Function> f,
-                                                               const std::string& backend_name,
-                                                               size_t iterations,
-                                                               bool timing_detail,
-                                                               int warmup_iterations,
-                                                               bool copy_data);
+struct BenchmarkOptions
+{
+    /// Timed iterations run by each calling thread
+    size_t iterations = 10;
+    /// Untimed iterations run by each calling thread before timing starts
+    size_t warmup_iterations = 1;
+    /// Extend warm-up until the latency of successive windows of calls settles
+    bool steady_state = false;
+    /// Upper bound on warm-up iterations when steady_state is set
+    size_t max_warmup_iterations = 1000;
+    /// Number of threads calling the model concurrently; the model is compiled again for
+    /// every get_max_concurrent_calls() threads
+    size_t threads = 1;
+    bool timing_detail = false;
+    bool copy_data = true;
+};
+
+struct BenchmarkResult
+{
+    double compile_milliseconds = 0;
+    /// Warm-up iterations run before timing, per thread
+    size_t warmup_iterations = 0;
+    /// Wall time of the timed phase across all threads
+    double wall_milliseconds = 0;
+    /// Latency of every timed call in microseconds, sorted ascending
+    std::vector<double> latencies;
+    std::vector<ngraph::runtime::PerformanceCounter> perf_data;
+
+    double mean() const;
+    /// \brief Nearest-rank percentile of latencies, p in [0, 100]
+    double percentile(double p) const;
+    /// \brief Completed calls per second over the timed phase
+    double throughput() const;
+};
+
+BenchmarkResult run_benchmark(std::shared_ptr<ngraph::Function> f,
+                              const std::string& backend_name,
+                              const BenchmarkOptions& options);
@@ -22,6 +22,7 @@
 
 #include <fstream>
 #include <iomanip>
+#include <map>
 
 #include "benchmark.hpp"
 #include "ngraph/distributed.hpp"
@@ -35,6 +36,7 @@
 #include "ngraph/runtime/backend.hpp"
 #include "ngraph/serializer.hpp"
 #include "ngraph/util.hpp"
+#include "nlohmann/json.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -127,6 +129,48 @@ void print_times(const multimap<size_t, string>& timing)
     }
 }
 
+void print_hardware_counters(const vector<PerfShape>& perf_data)
+{
+    struct Events
+    {
+        uint64_t cycles = 0;
+        uint64_t instructions = 0;
+        uint64_t cache_misses = 0;
+        uint64_t branch_misses = 0;
+    };
+    map<string, Events> events;
+    for (const PerfShape& p : perf_data)
+    {
+        if (p.has_hardware_counters())
+        {
+            auto node = p.get_node();
+            Events& e = events[node->get_name().substr(0, node->get_name().find('_'))];
+            e.cycles += p.cycles();
+            e.instructions += p.instructions();
+            e.cache_misses += p.cache_misses();
+            e.branch_misses += p.branch_misses();
+        }
+    }
+    if (events.empty())
+    {
+        return;
+    }
+
+    cout << "\n---- Hardware counters per op type ----\n";
+    cout << setw(20) << left << "op" << setw(16) << right << "cycles" << setw(16)
+         << "instructions" << setw(8) << "IPC" << setw(14) << "LLC misses" << setw(16)
+         << "branch misses" << "\n";
+    for (const auto& e : events)
+    {
+        double ipc =
+            e.second.cycles == 0 ? 0 : static_cast<double>(e.second.instructions) / e.second.cycles;
+        cout << setw(20) << left << e.first << setw(16) << right << e.second.cycles << setw(16)
+             << e.second.instructions << setw(8) << fixed << setprecision(2) << ipc
+             << defaultfloat << setw(14) << e.second.cache_misses << setw(16)
+             << e.second.branch_misses << "\n";
+    }
+}
+
 void print_results(vector<PerfShape> perf_data, bool timing_detail)
 {
     sort(perf_data.begin(), perf_data.end(), [](const PerfShape& p1, const PerfShape& p2) {
@@ -142,9 +186,69 @@ void print_results(vector<PerfShape> perf_data, bool timing_detail)
 
         cout << "\n---- Aggregate times per op type/shape/count ----\n";
         print_times(timing_details);
+
+        print_hardware_counters(perf_data);
+    }
+}
+
+void print_latency(const BenchmarkResult& result, size_t threads)
+{
+    cout << "compile time: " << result.compile_milliseconds << "ms" << endl;
+    cout << "warmup iterations: " << result.warmup_iterations << endl;
+    cout << result.mean() / 1000 << "ms per iteration" << endl;
+    cout << "latency (us): min " << result.percentile(0) << ", p50 " << result.percentile(50)
+         << ", p90 " << result.percentile(90) << ", p99 " << result.percentile(99) << ", p99.9 "
+         << result.percentile(99.9) << ", max " << result.percentile(100) << endl;
+    if (threads > 1)
+    {
+        cout << "throughput: " << result.throughput() << " iterations/s over " << threads
+             << " threads" << endl;
     }
 }
 
+nlohmann::json to_json(const string& model,
+                       const string& backend,
+                       const BenchmarkOptions& options,
+                       const BenchmarkResult& result,
+                       const vector<PerfShape>& perf_data)
+{
+    nlohmann::json latency = {{"mean", result.mean()},
+                              {"min", result.percentile(0)},
+                              {"p50", result.percentile(50)},
+                              {"p90", result.percentile(90)},
+                              {"p99", result.percentile(99)},
+                              {"p99.9", result.percentile(99.9)},
+                              {"max", result.percentile(100)}};
+    nlohmann::json ops = nlohmann::json::array();
+    for (const PerfShape& p : perf_data)
+    {
+        auto node = p.get_node();
+        nlohmann::json op = {{"name", node->get_name()},
+                             {"op", node->description()},
+                             {"shape", static_cast<const vector<size_t>&>(p.shape)},
+                             {"total_us", p.total_microseconds()},
+                             {"calls", p.call_count()}};
+        if (p.has_hardware_counters())
+        {
+            op["cycles"] = p.cycles();
+            op["instructions"] = p.instructions();
+            op["cache_misses"] = p.cache_misses();
+            op["branch_misses"] = p.branch_misses();
+        }
+        ops.push_back(op);
+    }
+    return {{"model", model},
+            {"backend", backend},
+            {"threads", options.threads},
+            {"iterations", options.iterations},
+            {"warmup_iterations", result.warmup_iterations},
+            {"compile_ms", result.compile_milliseconds},
+            {"wall_ms", result.wall_milliseconds},
+            {"throughput", result.throughput()},
+            {"latency_us", latency},
+            {"ops", ops}};
+}
+
 element::Type get_op_element_type(const Node& op)
 {
     element::Type type;
@@ -173,13 +277,11 @@ int main(int argc, char** argv)
     string model_arg;
     string backend;
     string directory;
-    int iterations = 10;
+    BenchmarkOptions options;
+    string json_file;
     bool failed = false;
     bool statistics = false;
-    bool timing_detail = false;
     bool visualize = false;
-    int warmup_iterations = 1;
-    bool copy_data = true;
     bool dot_file = false;
 
     for (size_t i = 1; i < argc; i++)
@@ -197,7 +299,7 @@ int main(int argc, char** argv)
         {
             try
             {
-                iterations = stoi(argv[++i]);
+                options.iterations = stoul(argv[++i]);
             }
             catch (...)
             {
@@ -211,11 +313,11 @@ int main(int argc, char** argv)
         }
         else if (arg == "--timing_detail" || arg == "--timing-detail")
         {
-            timing_detail = true;
+            options.timing_detail = true;
         }
         else if (arg == "--no_copy_data")
         {
-            copy_data = false;
+            options.copy_data = false;
         }
         else if (arg == "-v" || arg == "--visualize")
         {
@@ -233,7 +335,7 @@ int main(int argc, char** argv)
         {
             try
             {
-                warmup_iterations = stoi(argv[++i]);
+                options.warmup_iterations = stoul(argv[++i]);
             }
             catch (...)
             {
@@ -241,6 +343,26 @@ int main(int argc, char** argv)
                 failed = true;
             }
         }
+        else if (arg == "--steady_state")
+        {
+            options.steady_state = true;
+        }
+        else if (arg == "-t" || arg == "--threads")
+        {
+            try
+            {
+                options.threads = stoul(argv[++i]);
+            }
+            catch (...)
+            {
+                cout << "Invalid Argument\n";
+                failed = true;
+            }
+        }
+        else if (arg == "--json")
+        {
+            json_file = argv[++i];
+        }
         else
         {
             cout << "Unknown option: " << arg << endl;
@@ -276,11 +398,16 @@ OPTIONS
         -f|--file                 Serialized model file
         -b|--backend              Backend to use (default: CPU)
         -d|--directory            Directory to scan for models. All models are benchmarked.
-        -i|--iterations           Iterations (default: 10)
+        -i|--iterations           Iterations per thread (default: 10)
         -s|--statistics           Display op statistics
         -v|--visualize            Visualize a model (WARNING: requires Graphviz installed)
-        --timing_detail           Gather detailed timing
-        -w|--warmup_iterations    Number of warm-up iterations
+        --timing_detail           Gather detailed timing. On CPU, set NGRAPH_CPU_PERF_EVENTS to
+                                  also count cycles, instructions, LLC and branch misses per op
+        -w|--warmup_iterations    Number of warm-up iterations per thread
+        --steady_state            Warm up until per-call latency stops changing
+        -t|--threads              Threads calling the compiled model concurrently (default: 1)
+                                  With the CPU backend set NGRAPH_CPU_CONCURRENCY to match
+        --json                    Write results, latency percentiles and op timings to a file
         --no_copy_data            Disable copy of input/result data every iteration
         --dot                     Generate Graphviz dot file
 )###";
@@ -307,6 +434,7 @@ OPTIONS
     }
 
     vector<PerfShape> aggregate_perf_data;
+    nlohmann::json json_results = nlohmann::json::array();
     int rc = 0;
     for (const string& model : models)
     {
@@ -335,6 +463,10 @@ OPTIONS
                 pass_manager.register_pass<pass::Liveness>();
                 pass_manager.register_pass<pass::MemoryLayout>();
                 pass_manager.run_passes(f);
+                size_t temporary_pool_size = f->get_temporary_pool_size();
+                pass::MemoryLayout greedy_layout(
+                    1, false, pass::MemoryLayout::Planner::GREEDY_BY_SIZE);
+                greedy_layout.run_on_function(f);
 
                 cout << "\n---- Source Graph Statistics ----\n";
                 cout << "Total nodes: " << locale_string(f->get_ops().size()) << endl;
@@ -403,7 +535,10 @@ OPTIONS
                 cout << "Total Temporary size: " << locale_string(total_temporary_bytes)
                      << " bytes in " << total_temporary_count << " temporaries\n";
                 cout << "Temporary size with reuse : "
-                     << locale_string(f->get_temporary_pool_size()) << " bytes\n";
+                     << locale_string(temporary_pool_size) << " bytes\n";
+                cout << "Temporary size with greedy by size reuse: "
+                     << locale_string(greedy_layout.get_pool_size()) << " bytes (lower bound "
+                     << locale_string(greedy_layout.get_lower_bound()) << " bytes)\n";
                 cout << "--\n";
                 cout << "Types used:\n";
                 for (const string& type : type_list)
@@ -421,12 +556,17 @@ OPTIONS
             {
                 cout << "\n---- Benchmark ----\n";
                 shared_ptr<Function> f = deserialize(model);
-                auto perf_data = run_benchmark(
-                    f, backend, iterations, timing_detail, warmup_iterations, copy_data);
-                auto perf_shape = to_perf_shape(f, perf_data);
+                BenchmarkResult result = run_benchmark(f, backend, options);
+                cout.imbue(locale(""));
+                print_latency(result, options.threads);
+                auto perf_shape = to_perf_shape(f, result.perf_data);
                 aggregate_perf_data.insert(
                     aggregate_perf_data.end(), perf_shape.begin(), perf_shape.end());
-                print_results(perf_shape, timing_detail);
+                print_results(perf_shape, options.timing_detail);
+                if (!json_file.empty())
+                {
+                    json_results.push_back(to_json(model, backend, options, result, perf_shape));
+                }
             }
         }
         catch (ngraph::unsupported_op& ue)
@@ -447,7 +587,18 @@ OPTIONS
         cout << "============================================================================\n";
         cout << "---- Aggregate over all models\n";
         cout << "============================================================================\n";
-        print_results(aggregate_perf_data, timing_detail);
+        print_results(aggregate_perf_data, options.timing_detail);
+    }
+
+    if (!json_file.empty())
+    {
+        ofstream out(json_file);
+        out << setw(4) << json_results << endl;
+        if (!out)
+        {
+            cout << "Unable to write " << json_file << endl;
+            rc += 1;
+        }
     }
 
     return rc;
@@ -14,10 +14,16 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 #include "gtest/gtest.h"
 #include "ngraph/ngraph.hpp"
 #include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/batch_bucketed_executable.hpp"
 #include "ngraph/util.hpp"
+#include "util/test_tools.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -34,3 +40,260 @@ TEST(backend_api, invalid_name)
 {
     ASSERT_ANY_THROW(ngraph::runtime::Backend::create("COMPLETELY-BOGUS-NAME"));
 }
+
+TEST(backend_api, begin_call)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(make_shared<op::Add>(A, B), ParameterVector{A, B});
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    auto handle = backend->compile(f);
+    EXPECT_GE(handle->get_max_concurrent_calls(), 1);
+
+    auto a = backend->create_tensor(element::f32, shape);
+    copy_data(a, vector<float>{1, 2, 3, 4});
+
+    const size_t call_count = 8;
+    vector<shared_ptr<runtime::Tensor>> bs;
+    vector<shared_ptr<runtime::Tensor>> results;
+    vector<future<bool>> futures;
+    for (size_t i = 0; i < call_count; i++)
+    {
+        float v = static_cast<float>(i);
+        bs.push_back(backend->create_tensor(element::f32, shape));
+        copy_data(bs.back(), vector<float>{v, v, v, v});
+        results.push_back(backend->create_tensor(element::f32, shape));
+        futures.push_back(handle->begin_call({results.back()}, {a, bs.back()}));
+    }
+    for (size_t i = 0; i < call_count; i++)
+    {
+        float v = static_cast<float>(i);
+        EXPECT_TRUE(futures[i].get());
+        EXPECT_EQ((vector<float>{1 + v, 2 + v, 3 + v, 4 + v}), read_vector<float>(results[i]));
+    }
+
+    // Mismatched arguments are rejected before the call is queued
+    EXPECT_ANY_THROW(handle->begin_call({results[0]}, {a}));
+}
+
+TEST(backend_api, begin_call_then_destroy)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(make_shared<op::Negative>(A), ParameterVector{A});
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    auto handle = backend->compile(f);
+    auto a = backend->create_tensor(element::f32, shape);
+    copy_data(a, vector<float>{1, 2, 3, 4});
+
+    // Calls still queued when the executable is released run before it is destroyed
+    vector<shared_ptr<runtime::Tensor>> results;
+    vector<future<bool>> futures;
+    for (size_t i = 0; i < 4; i++)
+    {
+        results.push_back(backend->create_tensor(element::f32, shape));
+        futures.push_back(handle->begin_call({results.back()}, {a}));
+    }
+    handle.reset();
+    for (size_t i = 0; i < 4; i++)
+    {
+        EXPECT_TRUE(futures[i].get());
+        EXPECT_EQ((vector<float>{-1, -2, -3, -4}), read_vector<float>(results[i]));
+    }
+}
+
+namespace
+{
+    // Declares no destructor, so nothing but the base class keeps queued calls from running on
+    // a destroyed object
+    class SlowCopyExecutable : public runtime::Executable
+    {
+    public:
+        SlowCopyExecutable(const shared_ptr<Function>& f)
+            : m_values(shape_size(f->get_output_shape(0)), 7)
+        {
+            set_parameters_and_results(*f);
+        }
+
+        bool call(const vector<shared_ptr<runtime::Tensor>>& outputs,
+                  const vector<shared_ptr<runtime::Tensor>>& inputs) override
+        {
+            this_thread::sleep_for(chrono::milliseconds(10));
+            outputs[0]->write(m_values.data(), 0, m_values.size() * sizeof(float));
+            return true;
+        }
+
+    private:
+        vector<float> m_values;
+    };
+}
+
+TEST(backend_api, begin_call_then_destroy_subclass)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(make_shared<op::Negative>(A), ParameterVector{A});
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    shared_ptr<runtime::Executable> handle = make_shared<SlowCopyExecutable>(f);
+    auto a = backend->create_tensor(element::f32, shape);
+
+    vector<shared_ptr<runtime::Tensor>> results;
+    vector<future<bool>> futures;
+    for (size_t i = 0; i < 4; i++)
+    {
+        results.push_back(backend->create_tensor(element::f32, shape));
+        futures.push_back(handle->begin_call({results.back()}, {a}));
+    }
+    handle.reset();
+    for (size_t i = 0; i < 4; i++)
+    {
+        EXPECT_TRUE(futures[i].get());
+        EXPECT_EQ((vector<float>{7, 7, 7, 7}), read_vector<float>(results[i]));
+    }
+}
+
+TEST(backend_api, concurrent_calls)
+{
+    // Intermediates live in the executable's temporary pool, which overlapping calls must not
+    // share
+    Shape shape{1 << 18};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>((A + B) * (A - B) + A, ParameterVector{A, B});
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    auto handle = backend->compile(f, true);
+
+    const size_t thread_count = 8;
+    atomic<size_t> mismatches{0};
+    vector<thread> threads;
+    for (size_t t = 0; t < thread_count; t++)
+    {
+        threads.emplace_back([&, t]() {
+            float v = static_cast<float>(t);
+            auto a = backend->create_tensor(element::f32, shape);
+            auto b = backend->create_tensor(element::f32, shape);
+            auto result = backend->create_tensor(element::f32, shape);
+            copy_data(a, vector<float>(shape_size(shape), v));
+            copy_data(b, vector<float>(shape_size(shape), 1));
+            for (size_t i = 0; i < 20; i++)
+            {
+                handle->call({result}, {a, b});
+                if (read_vector<float>(result) !=
+                    vector<float>(shape_size(shape), (v + 1) * (v - 1) + v))
+                {
+                    mismatches++;
+                }
+            }
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    EXPECT_EQ(0, mismatches);
+
+    // Every call's timers are merged into the performance data
+    for (const runtime::PerformanceCounter& counter : handle->get_performance_data())
+    {
+        EXPECT_EQ(thread_count * 20, counter.call_count());
+    }
+}
+
+TEST(backend_api, batch_bucketed_executable)
+{
+    auto x = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic(), 3});
+    auto y = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic(), 3});
+    auto f = make_shared<Function>(
+        NodeVector{x * y, make_shared<op::Sum>(x + y, AxisSet{1})}, ParameterVector{x, y});
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    runtime::BatchBucketedExecutable handle(backend, f, 2);
+
+    auto run = [&](size_t batch) {
+        vector<float> x_data(batch * 3);
+        vector<float> y_data(batch * 3);
+        vector<float> expected_product(batch * 3);
+        vector<float> expected_sum(batch, 0);
+        for (size_t i = 0; i < batch * 3; i++)
+        {
+            x_data[i] = static_cast<float>(i);
+            y_data[i] = static_cast<float>(i % 5);
+            expected_product[i] = x_data[i] * y_data[i];
+            expected_sum[i / 3] += x_data[i] + y_data[i];
+        }
+        auto a = backend->create_tensor(element::f32, Shape{batch, 3});
+        auto b = backend->create_tensor(element::f32, Shape{batch, 3});
+        copy_data(a, x_data);
+        copy_data(b, y_data);
+        auto product = backend->create_tensor(element::f32, Shape{batch, 3});
+        auto sum = backend->create_tensor(element::f32, Shape{batch});
+        handle.call_with_validate({product, sum}, {a, b});
+        EXPECT_EQ(read_vector<float>(product), expected_product);
+        EXPECT_EQ(read_vector<float>(sum), expected_sum);
+    };
+
+    run(3);
+    EXPECT_EQ(handle.get_cached_buckets(), (vector<size_t>{4}));
+    run(4);
+    run(5);
+    EXPECT_EQ(handle.get_cached_buckets(), (vector<size_t>{8, 4}));
+    run(1);
+    EXPECT_EQ(handle.get_cached_buckets(), (vector<size_t>{1, 8}));
+    run(7);
+    EXPECT_EQ(handle.get_cached_buckets(), (vector<size_t>{8, 1}));
+
+    auto a = backend->create_tensor(element::f32, Shape{2, 3});
+    auto b = backend->create_tensor(element::f32, Shape{3, 3});
+    auto product = backend->create_tensor(element::f32, Shape{2, 3});
+    auto sum = backend->create_tensor(element::f32, Shape{2});
+    EXPECT_ANY_THROW(handle.call_with_validate({product, sum}, {a, b}));
+}
+
+TEST(backend_api, batch_bucketed_executable_concurrent_calls)
+{
+    auto x = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic(), 3});
+    auto f = make_shared<Function>(x * x, ParameterVector{x});
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    runtime::BatchBucketedExecutable handle(backend, f, 2);
+
+    // Threads share buckets and evict each other's, while each gets its own padding
+    const size_t thread_count = 6;
+    atomic<size_t> mismatches{0};
+    vector<thread> threads;
+    for (size_t t = 0; t < thread_count; t++)
+    {
+        threads.emplace_back([&, t]() {
+            for (size_t i = 0; i < 20; i++)
+            {
+                size_t batch = 1 + (t + i) % 7;
+                vector<float> data(batch * 3);
+                vector<float> expected(batch * 3);
+                for (size_t j = 0; j < data.size(); j++)
+                {
+                    data[j] = static_cast<float>(t * 100 + j);
+                    expected[j] = data[j] * data[j];
+                }
+                auto a = backend->create_tensor(element::f32, Shape{batch, 3});
+                auto result = backend->create_tensor(element::f32, Shape{batch, 3});
+                copy_data(a, data);
+                handle.call_with_validate({result}, {a});
+                if (read_vector<float>(result) != expected)
+                {
+                    mismatches++;
+                }
+            }
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    EXPECT_EQ(0, mismatches);
+    EXPECT_LE(handle.get_cached_buckets().size(), 2);
+}
@@ -705,6 +705,48 @@ NGRAPH_TEST(${BACKEND_NAME}, topk_3d_large_input_min)
     }
 }
 
+NGRAPH_TEST(${BACKEND_NAME}, topk_2d_large_input_with_equal_values)
+{
+    Shape shape{3, 4096};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+
+    auto B = make_shared<op::TopK>(A, 1, element::i64, 20, true);
+
+    auto interp_f_0 =
+        make_shared<Function>(make_shared<op::GetOutputElement>(B, 0), ParameterVector{A});
+    auto interp_f_1 =
+        make_shared<Function>(make_shared<op::GetOutputElement>(B, 1), ParameterVector{A});
+    auto backend_f_0 = ngraph::clone_function(*interp_f_0);
+    auto backend_f_1 = ngraph::clone_function(*interp_f_1);
+
+    // Only a handful of distinct values, so the selection must break ties by position
+    vector<vector<float>> args;
+    for (shared_ptr<op::Parameter> param : interp_f_0->get_parameters())
+    {
+        vector<float> tensor_val(shape_size(param->get_shape()));
+        for (size_t i = 0; i < tensor_val.size(); i++)
+        {
+            tensor_val[i] = static_cast<float>((i * 7) % 13);
+        }
+        args.push_back(tensor_val);
+    }
+
+    auto interp_results_0 = execute<float, int64_t>(interp_f_0, args, "INTERPRETER");
+    auto backend_results_0 = execute<float, int64_t>(backend_f_0, args, "${BACKEND_NAME}");
+    for (size_t i = 0; i < backend_results_0.size(); i++)
+    {
+        EXPECT_EQ(backend_results_0.at(i), interp_results_0.at(i));
+    }
+
+    auto interp_results_1 = execute(interp_f_1, args, "INTERPRETER");
+    auto backend_results_1 = execute(backend_f_1, args, "${BACKEND_NAME}");
+    for (size_t i = 0; i < backend_results_1.size(); i++)
+    {
+        EXPECT_TRUE(test::all_close_f(
+            backend_results_1.at(i), interp_results_1.at(i), MIN_FLOAT_TOLERANCE_BITS));
+    }
+}
+
 NGRAPH_TEST(${BACKEND_NAME}, topk_3d_single_output)
 {
     Shape shape{2, 3, 2};
@@ -0,0 +1,136 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <cstdint>
+#include <memory>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "ngraph/binary_model.hpp"
+#include "ngraph/file_util.hpp"
+
+using namespace ngraph;
+using namespace std;
+
+TEST(binary_model, stream)
+{
+    string s1 = "this is a test";
+    string s2 = "the quick brown fox jumps over the lazy dog";
+    stringstream ss;
+    {
+        binary_model::Writer writer(ss, 16);
+        writer.write("file1.txt", s1.data(), s1.size());
+        writer.write("file.txt", s2.data(), s2.size());
+    }
+
+    EXPECT_TRUE(binary_model::is_binary_model(ss));
+    binary_model::Reader reader(ss);
+    auto records = reader.get_records();
+    ASSERT_EQ(2, records.size());
+    EXPECT_FALSE(reader.is_mapped());
+
+    EXPECT_STREQ(records[0].get_name().c_str(), "file1.txt");
+    EXPECT_STREQ(records[1].get_name().c_str(), "file.txt");
+    EXPECT_EQ(records[0].get_size(), 14);
+    EXPECT_EQ(records[1].get_size(), 43);
+    EXPECT_EQ(records[0].get_offset() % 16, 0);
+    EXPECT_EQ(records[1].get_offset() % 16, 0);
+
+    const binary_model::Record* record = reader.find("file.txt");
+    ASSERT_NE(record, nullptr);
+    string content(record->get_size(), '\0');
+    reader.read(*record, &content[0]);
+    EXPECT_EQ(content, s2);
+    EXPECT_EQ(reader.find("missing.txt"), nullptr);
+}
+
+TEST(binary_model, mapped)
+{
+    const string test_file = "test1.ngbm";
+    vector<float> data(1000);
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<float>(i);
+    }
+    {
+        binary_model::Writer writer(test_file);
+        writer.write("small", "abc", 3);
+        writer.write("data", data.data(), data.size() * sizeof(float));
+    }
+
+    shared_ptr<void> mapping;
+    const float* mapped_data;
+    {
+        binary_model::Reader reader(test_file);
+        ASSERT_TRUE(reader.is_mapped());
+        const binary_model::Record* record = reader.find("data");
+        ASSERT_NE(record, nullptr);
+        ASSERT_EQ(record->get_size(), data.size() * sizeof(float));
+        mapped_data = static_cast<const float*>(reader.get_data(*record));
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(mapped_data) % 64, 0);
+        mapping = reader.get_mapping();
+    }
+
+    // The mapping outlives the reader
+    EXPECT_TRUE(equal(data.begin(), data.end(), mapped_data));
+    mapping.reset();
+    file_util::remove_file(test_file);
+}
+
+TEST(binary_model, not_binary_model)
+{
+    stringstream ss("[{\"name\":\"Function_0\"}]");
+    EXPECT_FALSE(binary_model::is_binary_model(ss));
+    EXPECT_ANY_THROW(binary_model::Reader reader(ss));
+}
+
+TEST(binary_model, write_errors)
+{
+    stringstream ss;
+    {
+        binary_model::Writer writer(ss, 16);
+        ss.setstate(ios_base::badbit);
+        string s1 = "this is a test";
+        EXPECT_ANY_THROW(writer.write("file1.txt", s1.data(), s1.size()));
+        EXPECT_ANY_THROW(writer.close());
+    }
+    {
+        // The destructor swallows the error close() would have reported
+        stringstream failing;
+        binary_model::Writer writer(failing, 16);
+        failing.setstate(ios_base::badbit);
+    }
+}
+
+TEST(binary_model, corrupt_record_count)
+{
+    string s1 = "this is a test";
+    stringstream ss;
+    {
+        binary_model::Writer writer(ss, 16);
+        writer.write("file1.txt", s1.data(), s1.size());
+    }
+    // Overwrite the record count in the trailer with one the index cannot hold
+    string data = ss.str();
+    size_t count_offset = data.size() - 16;
+    for (size_t i = 0; i < 8; i++)
+    {
+        data[count_offset + i] = static_cast<char>(0xFF);
+    }
+    stringstream corrupt(data);
+    EXPECT_ANY_THROW(binary_model::Reader reader(corrupt));
+}
@@ -19,9 +19,13 @@
 #include "ngraph/file_util.hpp"
 #include "ngraph/ngraph.hpp"
 #include "ngraph/serializer.hpp"
+#include "ngraph/util.hpp"
 #include "util/test_tools.hpp"
 
 #include <memory>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
 using namespace std;
 using namespace ngraph;
 
@@ -131,3 +135,137 @@ TEST(build_graph, function_undeclared_parameters)
         FAIL() << "Function construction failed for unexpected reason";
     }
 }
+
+TEST(build_graph, ordered_ops_follow_graph_changes)
+{
+    auto arg0 = make_shared<op::Parameter>(element::f32, Shape{2});
+    auto arg1 = make_shared<op::Parameter>(element::f32, Shape{2});
+    auto add = make_shared<op::Add>(arg0, arg1);
+    auto neg = make_shared<op::Negative>(add);
+    auto f = make_shared<Function>(neg, ParameterVector{arg0, arg1});
+
+    auto ops = f->get_ordered_ops();
+    EXPECT_EQ(ops, f->get_ordered_ops());
+    EXPECT_EQ(5, ops.size());
+
+    // Replacing a node or rewiring an edge must not return the cached order
+    auto mul = make_shared<op::Multiply>(arg0, arg1);
+    replace_node(add, mul);
+    ops = f->get_ordered_ops();
+    EXPECT_EQ(5, ops.size());
+    EXPECT_EQ(find(ops.begin(), ops.end(), add), ops.end());
+    EXPECT_NE(find(ops.begin(), ops.end(), mul), ops.end());
+
+    auto abs = make_shared<op::Abs>(mul);
+    neg->input(0).replace_source_output(abs->output(0));
+    ops = f->get_ordered_ops();
+    EXPECT_EQ(ops, f->get_ordered_ops());
+    EXPECT_EQ(6, ops.size());
+    auto abs_position = find(ops.begin(), ops.end(), abs);
+    ASSERT_NE(abs_position, ops.end());
+    EXPECT_NE(find(abs_position, ops.end(), neg), ops.end());
+}
+
+TEST(build_graph, ordered_ops_release_removed_nodes)
+{
+    auto arg0 = make_shared<op::Parameter>(element::f32, Shape{2});
+    auto arg1 = make_shared<op::Parameter>(element::f32, Shape{2});
+    auto add = make_shared<op::Add>(arg0, arg1);
+    auto neg = make_shared<op::Negative>(add);
+    auto f = make_shared<Function>(neg, ParameterVector{arg0, arg1});
+    EXPECT_EQ(5, f->get_ordered_ops().size());
+
+    // A snapshot taken before a rewrite stays valid, the cache itself lets go of the old node
+    weak_ptr<Node> removed = add;
+    {
+        auto ops = f->get_ordered_ops();
+        replace_node(add, make_shared<op::Multiply>(arg0, arg1));
+        add.reset();
+        EXPECT_FALSE(removed.expired());
+        EXPECT_NE(find(ops.begin(), ops.end(), removed.lock()), ops.end());
+    }
+    EXPECT_TRUE(removed.expired());
+    EXPECT_EQ(5, f->get_ordered_ops().size());
+}
+
+TEST(build_graph, ordered_ops_shared_nodes)
+{
+    auto arg0 = make_shared<op::Parameter>(element::f32, Shape{2});
+    auto arg1 = make_shared<op::Parameter>(element::f32, Shape{2});
+    auto add = make_shared<op::Add>(arg0, arg1);
+    auto neg = make_shared<op::Negative>(add);
+    auto f = make_shared<Function>(neg, ParameterVector{arg0, arg1});
+    auto g = make_shared<Function>(add, ParameterVector{arg0, arg1});
+
+    // Both functions order the shared ops, and both see them rewired afterwards
+    EXPECT_EQ(5, f->get_ordered_ops().size());
+    EXPECT_EQ(4, g->get_ordered_ops().size());
+    auto abs = make_shared<op::Abs>(arg1);
+    add->input(1).replace_source_output(abs->output(0));
+    auto f_ops = f->get_ordered_ops();
+    auto g_ops = g->get_ordered_ops();
+    EXPECT_NE(find(f_ops.begin(), f_ops.end(), abs), f_ops.end());
+    EXPECT_NE(find(g_ops.begin(), g_ops.end(), abs), g_ops.end());
+}
+
+#ifndef _WIN32
+// Builds many unrolled sequences, the shape of graph that makes per-node overhead matter.
+// Reports the peak resident memory added per node and the time spent building and sorting.
+TEST(benchmark, build_graph_memory)
+{
+    const size_t sequences = 64;
+    const size_t steps = 1000;
+
+    auto max_rss = []() {
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+        return static_cast<size_t>(usage.ru_maxrss);
+#else
+        return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+    };
+    size_t rss_before = max_rss();
+
+    stopwatch timer;
+    timer.start();
+    ParameterVector parameters;
+    NodeVector results;
+    auto w = make_shared<op::Parameter>(element::f32, Shape{32, 128});
+    parameters.push_back(w);
+    for (size_t i = 0; i < sequences; i++)
+    {
+        auto h = make_shared<op::Parameter>(element::f32, Shape{32, 128});
+        parameters.push_back(h);
+        shared_ptr<Node> state = h;
+        for (size_t j = 0; j < steps; j++)
+        {
+            auto x = make_shared<op::Parameter>(element::f32, Shape{32, 128});
+            parameters.push_back(x);
+            state = make_shared<op::Tanh>(make_shared<op::Add>(state * w, x));
+        }
+        results.push_back(state);
+    }
+    auto f = make_shared<Function>(results, parameters);
+    timer.stop();
+    size_t node_count = f->get_ops().size();
+    // w, then per sequence h, a Result and per step x, Multiply, Add and Tanh
+    EXPECT_EQ(1 + sequences * (2 + steps * 4), node_count);
+    size_t bytes_per_node = (max_rss() - rss_before) / node_count;
+    cout << "built " << node_count << " nodes in " << timer.get_milliseconds() << "ms\n";
+    cout << "peak memory grew " << bytes_per_node << " bytes per node\n";
+    // About 1.2k today, this catches a node or descriptor growing by a large factor
+    EXPECT_LT(bytes_per_node, 4096);
+
+    timer.start();
+    size_t element_count = 0;
+    for (auto node : f->get_ordered_ops())
+    {
+        element_count += shape_size(node->get_output_shape(0));
+    }
+    timer.stop();
+    cout << "sorted and visited " << element_count / (32 * 128) << " outputs in "
+         << timer.get_milliseconds() << "ms\n";
+    EXPECT_EQ(node_count, element_count / (32 * 128));
+}
+#endif
@@ -15,6 +15,7 @@
 //*****************************************************************************
 
 #include "ngraph/pass/constant_folding.hpp"
+#include "ngraph/pass/constant_subgraph_folding.hpp"
 #include "gtest/gtest.h"
 #include "ngraph/ngraph.hpp"
 #include "ngraph/pass/manager.hpp"
@@ -260,3 +261,88 @@ TEST(constant_folding, const_quantize)
     vector<output_c_type> values_quantize{2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5};
     ASSERT_EQ(values_quantize, values_out);
 }
+
+#ifdef NGRAPH_INTERPRETER_ENABLE
+TEST(constant_folding, constant_subgraph)
+{
+    auto a = op::Constant::create(element::f32, Shape{2, 2}, {1, 2, 3, 4});
+    auto b = op::Constant::create(element::f32, Shape{2, 2}, {5, 6, 7, 8});
+    auto dot = make_shared<op::Dot>(a, b);
+    auto concat = make_shared<op::Concat>(NodeVector{dot, a}, 0);
+    auto slice = make_shared<op::Slice>(concat, Coordinate{1, 0}, Coordinate{3, 2});
+    auto convert = make_shared<op::Convert>(slice, element::i32);
+    auto sum = make_shared<op::Sum>(convert, AxisSet{1});
+    auto p = make_shared<op::Parameter>(element::i32, Shape{2});
+    auto f = make_shared<Function>(make_shared<op::Add>(sum, p), ParameterVector{p});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ConstantSubgraphFolding>();
+    pass_manager.run_passes(f);
+
+    ASSERT_EQ(count_ops_of_type<op::Dot>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Sum>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Constant>(f), 1);
+
+    auto add = f->get_results().at(0)->get_argument(0);
+    auto new_const = dynamic_pointer_cast<op::Constant>(add->get_argument(0));
+    ASSERT_TRUE(new_const);
+    ASSERT_EQ(new_const->get_element_type(), element::i32);
+    // Rows are [43, 50] and [1, 2]
+    vector<int32_t> values_expected{93, 3};
+    ASSERT_EQ(values_expected, new_const->get_vector<int32_t>());
+}
+
+TEST(constant_folding, constant_subgraph_size_cap)
+{
+    auto a = op::Constant::create(element::f32, Shape{2}, {1, 2});
+    auto negative = make_shared<op::Negative>(a);
+    auto broadcast = make_shared<op::Broadcast>(negative, Shape{2, 64}, AxisSet{1});
+    auto f = make_shared<Function>(broadcast, ParameterVector{});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ConstantSubgraphFolding>(256);
+    pass_manager.run_passes(f);
+
+    // The Negative fits under the cap and is folded; the 512 byte Broadcast is not
+    ASSERT_EQ(count_ops_of_type<op::Negative>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Broadcast>(f), 1);
+    auto new_const = dynamic_pointer_cast<op::Constant>(
+        f->get_results().at(0)->get_argument(0)->get_argument(0));
+    ASSERT_TRUE(new_const);
+    vector<float> values_expected{-1, -2};
+    ASSERT_EQ(values_expected, new_const->get_vector<float>());
+}
+
+TEST(constant_folding, constant_subgraph_excluded_op_types)
+{
+    auto a = op::Constant::create(element::f32, Shape{2}, {1, -2});
+    auto negative = make_shared<op::Negative>(a);
+    auto abs = make_shared<op::Abs>(negative);
+    auto f = make_shared<Function>(abs, ParameterVector{});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ConstantSubgraphFolding>(
+        1024, "INTERPRETER", unordered_set<type_index>{type_index(typeid(op::Abs))});
+    pass_manager.run_passes(f);
+
+    ASSERT_EQ(count_ops_of_type<op::Negative>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Abs>(f), 1);
+}
+
+TEST(constant_folding, constant_subgraph_execution_error)
+{
+    auto a = op::Constant::create(element::i32, Shape{2}, {1, 2});
+    auto zero = op::Constant::create(element::i32, Shape{2}, {0, 0});
+    auto divide = make_shared<op::Divide>(a, zero);
+    auto negative = make_shared<op::Negative>(a);
+    auto f = make_shared<Function>(NodeVector{divide, negative}, ParameterVector{});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ConstantSubgraphFolding>();
+    pass_manager.run_passes(f);
+
+    // Dividing by zero throws when the subgraph runs; only that subgraph is left in the graph
+    ASSERT_EQ(count_ops_of_type<op::Divide>(f), 1);
+    ASSERT_EQ(count_ops_of_type<op::Negative>(f), 0);
+}
+#endif
@@ -0,0 +1,131 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ngraph/ngraph.hpp"
+#include "ngraph/pass/manager.hpp"
+#include "ngraph/pass/share_constants.hpp"
+#include "ngraph/runtime/constant_store.hpp"
+
+using namespace ngraph;
+using namespace std;
+
+TEST(constant_store, intern)
+{
+    auto& store = runtime::ConstantStore::get();
+    size_t entries = store.get_entry_count();
+    size_t bytes = store.get_byte_count();
+
+    vector<float> a{1, 2, 3, 4};
+    vector<float> b{1, 2, 3, 4};
+    vector<float> c{1, 2, 3, 5};
+    {
+        auto sa = store.intern(a.data(), a.size() * sizeof(float), "float");
+        auto sb = store.intern(b.data(), b.size() * sizeof(float), "float");
+        auto sc = store.intern(c.data(), c.size() * sizeof(float), "float");
+        auto sd = store.intern(a.data(), a.size() * sizeof(float), "nChw16c");
+        EXPECT_EQ(sa.get(), sb.get());
+        EXPECT_NE(sa.get(), sc.get());
+        EXPECT_NE(sa.get(), sd.get());
+        EXPECT_EQ(0, memcmp(sa.get(), a.data(), a.size() * sizeof(float)));
+        EXPECT_EQ(store.get_entry_count(), entries + 3);
+        EXPECT_EQ(store.get_byte_count(), bytes + 3 * a.size() * sizeof(float));
+    }
+    EXPECT_EQ(store.get_entry_count(), entries);
+    EXPECT_EQ(store.get_byte_count(), bytes);
+}
+
+TEST(constant_store, share_constants)
+{
+    vector<float> values(1024, 0.5f);
+    auto make_function = [&values]() {
+        auto c = op::Constant::create(element::f32, Shape{values.size()}, values);
+        auto p = make_shared<op::Parameter>(element::f32, Shape{values.size()});
+        return make_shared<Function>(make_shared<op::Add>(c, p), ParameterVector{p});
+    };
+    auto f1 = make_function();
+    auto f2 = make_function();
+    auto constant_of = [](const shared_ptr<Function>& f) {
+        return static_pointer_cast<op::Constant>(
+            f->get_results().at(0)->get_argument(0)->get_argument(0));
+    };
+    EXPECT_NE(constant_of(f1)->get_data_ptr(), constant_of(f2)->get_data_ptr());
+
+    auto& store = runtime::ConstantStore::get();
+    size_t entries = store.get_entry_count();
+    {
+        pass::Manager pass_manager;
+        pass_manager.register_pass<pass::ShareConstants>();
+        pass_manager.run_passes(f1);
+        pass_manager.run_passes(f2);
+    }
+
+    EXPECT_EQ(constant_of(f1)->get_data_ptr(), constant_of(f2)->get_data_ptr());
+    EXPECT_EQ(values, constant_of(f2)->get_vector<float>());
+    EXPECT_EQ(store.get_entry_count(), entries + 1);
+
+    // The shared copy lives as long as any constant refers to it, including clones
+    auto f3 = clone_function(*f1);
+    f1 = nullptr;
+    f2 = nullptr;
+    EXPECT_EQ(store.get_entry_count(), entries + 1);
+    EXPECT_EQ(values, constant_of(f3)->get_vector<float>());
+    f3 = nullptr;
+    EXPECT_EQ(store.get_entry_count(), entries);
+}
+
+TEST(constant_store, share_constants_external_data)
+{
+    // Stands in for a memory mapped model
+    auto mapped = make_shared<vector<float>>(1024, 0.25f);
+    auto make_function = [&mapped](shared_ptr<op::Constant> c) {
+        auto p = make_shared<op::Parameter>(element::f32, Shape{mapped->size()});
+        return make_shared<Function>(make_shared<op::Add>(c, p), ParameterVector{p});
+    };
+    auto external = make_shared<op::Constant>(
+        element::f32, Shape{mapped->size()}, mapped->data(), shared_ptr<void>(mapped));
+    auto copied = op::Constant::create(element::f32, Shape{mapped->size()}, *mapped);
+    auto f1 = make_function(external);
+    auto f2 = make_function(copied);
+
+    auto& store = runtime::ConstantStore::get();
+    size_t entries = store.get_entry_count();
+    {
+        pass::Manager pass_manager;
+        pass_manager.register_pass<pass::ShareConstants>();
+        pass_manager.run_passes(f1);
+        pass_manager.run_passes(f2);
+    }
+
+    // The external data is used in place and the identical constant shares it
+    EXPECT_EQ(external->get_data_ptr(), mapped->data());
+    EXPECT_EQ(copied->get_data_ptr(), mapped->data());
+    EXPECT_EQ(store.get_entry_count(), entries + 1);
+
+    // The store keeps the external owner only while a constant uses its data
+    weak_ptr<vector<float>> weak_mapped = mapped;
+    mapped = nullptr;
+    external = nullptr;
+    f1 = nullptr;
+    EXPECT_FALSE(weak_mapped.expired());
+    EXPECT_EQ(0.25f, copied->get_vector<float>().at(0));
+    copied = nullptr;
+    f2 = nullptr;
+    EXPECT_TRUE(weak_mapped.expired());
+    EXPECT_EQ(store.get_entry_count(), entries);
+}
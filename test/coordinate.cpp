@@ -20,6 +20,7 @@
 #include "gtest/gtest.h"
 
 #include "ngraph/ngraph.hpp"
+#include "ngraph/runtime/reference/strided_iterator.hpp"
 #include "util/ndarray.hpp"
 #include "util/test_tools.hpp"
 
@@ -305,6 +306,62 @@ TEST(DISABLED_coordinate, dilation)
     EXPECT_TRUE(it == ct.end());
 }
 
+TEST(coordinate, strided_iterator_collapse_contiguous)
+{
+    Shape shape{2, 3, 4};
+    Strides strides = row_major_strides(shape);
+    runtime::reference::StridedIterator<2> it(shape, {{strides, strides}});
+    ASSERT_FALSE(it.is_end());
+    EXPECT_EQ(it.run_length(), 24);
+    EXPECT_EQ(it.run_stride(0), 1);
+    EXPECT_EQ(it.run_stride(1), 1);
+    ++it;
+    EXPECT_TRUE(it.is_end());
+}
+
+TEST(coordinate, strided_iterator_transpose)
+{
+    // Walk a {2, 3} tensor in column-major order
+    Shape shape{3, 2};
+    runtime::reference::StridedIterator<2> it(shape, {{Strides{1, 3}, Strides{2, 1}}});
+    vector<size_t> offsets;
+    for (; !it.is_end(); ++it)
+    {
+        ASSERT_EQ(it.run_length(), 2);
+        ASSERT_EQ(it.run_stride(0), 3);
+        ASSERT_EQ(it.run_stride(1), 1);
+        offsets.push_back(it.offset(0));
+    }
+    EXPECT_EQ(offsets, (vector<size_t>{0, 1, 2}));
+}
+
+TEST(coordinate, strided_iterator_broadcast_and_unit_axes)
+{
+    Shape shape{2, 1, 3};
+    runtime::reference::StridedIterator<2> it(shape, {{Strides{1, 0, 0}, Strides{3, 3, 1}}});
+    vector<size_t> offsets;
+    for (; !it.is_end(); ++it)
+    {
+        ASSERT_EQ(it.run_length(), 3);
+        ASSERT_EQ(it.run_stride(0), 0);
+        offsets.push_back(it.offset(0));
+        offsets.push_back(it.offset(1));
+    }
+    EXPECT_EQ(offsets, (vector<size_t>{0, 0, 1, 3}));
+}
+
+TEST(coordinate, strided_iterator_scalar_and_empty)
+{
+    runtime::reference::StridedIterator<1> scalar(Shape{}, {{Strides{}}});
+    ASSERT_FALSE(scalar.is_end());
+    EXPECT_EQ(scalar.run_length(), 1);
+    ++scalar;
+    EXPECT_TRUE(scalar.is_end());
+
+    runtime::reference::StridedIterator<1> empty(Shape{2, 0, 3}, {{Strides{0, 3, 1}}});
+    EXPECT_TRUE(empty.is_end());
+}
+
 TEST(benchmark, coordinate)
 {
     Shape source_shape{128, 3, 2000, 1000};
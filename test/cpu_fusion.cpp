@@ -19,10 +19,13 @@
 #include <iostream>
 #include <list>
 #include <memory>
+#include <thread>
 
 #include "gtest/gtest.h"
 #include "misc.hpp"
 #include "ngraph/autodiff/adjoints.hpp"
+#include "ngraph/distributed/null.hpp"
+#include "ngraph/distributed/shared_memory.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/graph_util.hpp"
 #include "ngraph/log.hpp"
@@ -57,6 +60,7 @@
 #include "ngraph/pattern/op/skip.hpp"
 #include "ngraph/runtime/cpu/cpu_layout_descriptor.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
+#include "ngraph/runtime/cpu/op/allreduce_async.hpp"
 #include "ngraph/runtime/cpu/op/batch_mat_mul_transpose.hpp"
 #include "ngraph/runtime/cpu/op/batch_norm_relu.hpp"
 #include "ngraph/runtime/cpu/op/bounded_relu.hpp"
@@ -73,6 +77,7 @@
 #include "ngraph/runtime/cpu/op/rnn_utils.hpp"
 #include "ngraph/runtime/cpu/op/sigmoid_mul.hpp"
 #include "ngraph/runtime/cpu/op/update_slice.hpp"
+#include "ngraph/runtime/cpu/pass/cpu_allreduce_bucketing.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_loop_kernel_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_mat_fusion.hpp"
@@ -2279,8 +2284,6 @@ TEST(cpu_fusion, rnn_fprop_1_lstm_cell)
     EXPECT_TRUE(test::all_close(expected_ct, read_vector<float>(result_ct)));
 }
 
-#if 0
-
 TEST(cpu_fusion, loop_kernel_fusion_multiple_groups_pruned)
 {
     auto make_function = []() -> std::shared_ptr<Function> {
@@ -2473,6 +2476,47 @@ TEST(cpu_fusion, loop_kernel_fusion_one_group)
     }
 }
 
+#if !defined(NGRAPH_HALIDE)
+
+TEST(cpu_fusion, loop_kernel_fusion_elementwise_tail)
+{
+    auto make_function = []() -> std::shared_ptr<Function> {
+        Shape shape{37, 29};
+        auto a = make_shared<op::Parameter>(element::f64, shape);
+        auto b = make_shared<op::Parameter>(element::f64, shape);
+        auto c = make_shared<op::Parameter>(element::f64, shape);
+        auto gate = make_shared<op::Sigmoid>(a * b + c);
+        auto act = make_shared<op::Tanh>(gate - a) * make_shared<op::Relu>(gate + c);
+        auto scale = make_shared<op::Exp>(-a) + c * c +
+                     make_shared<op::Sqrt>(make_shared<op::Abs>(c));
+        auto out = make_shared<op::Minimum>(
+            make_shared<op::Maximum>(act, make_shared<op::Abs>(b)) / scale, gate);
+        return make_shared<Function>(NodeVector{out, gate}, ParameterVector{a, b, c});
+    };
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<runtime::cpu::pass::CPULoopKernelFusion>(2);
+    auto cpu_f = make_function();
+    auto int_f = make_function();
+    pass_manager.run_passes(cpu_f);
+    ASSERT_EQ(count_ops_of_type<runtime::cpu::op::LoopKernel>(cpu_f), 1);
+
+    test::Uniform<double> rng(-2.0, 2.0);
+    vector<vector<double>> args;
+    for (shared_ptr<op::Parameter> param : cpu_f->get_parameters())
+    {
+        vector<double> tensor_val(shape_size(param->get_shape()));
+        rng.initialize(tensor_val);
+        args.push_back(tensor_val);
+    }
+    auto int_results = execute(int_f, args, "INTERPRETER");
+    auto cpu_results = execute(cpu_f, args, "CPU");
+    for (size_t i = 0; i < cpu_results.size(); i++)
+    {
+        EXPECT_TRUE(test::all_close(cpu_results.at(i), int_results.at(i), 1.0e-10, 1.0e-10));
+    }
+}
+
 #endif
 
 void sigmoid_multiply_fusion_forward_compute(runtime::Backend* backend,
@@ -4087,3 +4131,132 @@ TEST(cpu_fusion, validate_fuse_gru_inputs)
     }
 }
 #endif
+
+TEST(cpu_fusion, allreduce_bucketing)
+{
+    auto A = make_shared<op::Parameter>(element::f32, Shape{2, 3});
+    auto B = make_shared<op::Parameter>(element::f32, Shape{4});
+    auto C = make_shared<op::Parameter>(element::f32, Shape{});
+    auto D = make_shared<op::Parameter>(element::f32, Shape{64});
+    auto ar_a = make_shared<op::AllReduce>(A);
+    auto ar_b = make_shared<op::AllReduce>(B);
+    auto ar_c = make_shared<op::AllReduce>(C);
+    // Depends on ar_a, so it cannot share its bucket
+    auto ar_e = make_shared<op::AllReduce>(make_shared<op::Negative>(ar_a));
+    // Larger than a bucket
+    auto ar_d = make_shared<op::AllReduce>(D);
+    auto f = make_shared<Function>(NodeVector{ar_a, ar_b, ar_c, ar_d, ar_e},
+                                   ParameterVector{A, B, C, D});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<runtime::cpu::pass::CPUAllReduceBucketing>(128);
+    pass_manager.run_passes(f);
+
+    EXPECT_EQ(count_ops_of_type<op::AllReduce>(f), 0);
+    EXPECT_EQ(count_ops_of_type<op::AllReduceStart>(f), 3);
+    EXPECT_EQ(count_ops_of_type<op::AllReduceWait>(f), 3);
+    EXPECT_EQ(f->get_ordered_ops().size(), f->get_ops().size());
+    for (size_t i = 0; i < f->get_output_size(); i++)
+    {
+        EXPECT_EQ(f->get_output_shape(i), f->get_results().at(i)->get_shape());
+    }
+    EXPECT_EQ(f->get_output_shape(0), (Shape{2, 3}));
+    EXPECT_EQ(f->get_output_shape(2), (Shape{}));
+}
+
+TEST(cpu_fusion, allreduce_bucketing_values)
+{
+    // Runs each rank of an in-process world on its own thread, with and without bucketing.
+    // A real distributed interface would own the process, so this needs the null one.
+    if (get_distributed_interface()->get_name() != "NULL")
+    {
+        return;
+    }
+    auto make_function = []() {
+        auto A = make_shared<op::Parameter>(element::f32, Shape{2, 3});
+        auto B = make_shared<op::Parameter>(element::f32, Shape{4});
+        auto C = make_shared<op::Parameter>(element::f32, Shape{});
+        auto D = make_shared<op::Parameter>(element::f32, Shape{64});
+        auto ar_a = make_shared<op::AllReduce>(A);
+        auto ar_e = make_shared<op::AllReduce>(make_shared<op::Negative>(ar_a));
+        return make_shared<Function>(NodeVector{ar_a,
+                                                make_shared<op::AllReduce>(B),
+                                                make_shared<op::AllReduce>(C),
+                                                make_shared<op::AllReduce>(D),
+                                                ar_e},
+                                     ParameterVector{A, B, C, D});
+    };
+
+    const int world_size = 4;
+    auto backend = runtime::Backend::create("CPU");
+    vector<shared_ptr<Function>> bucketed_functions;
+    vector<shared_ptr<runtime::Executable>> bucketed;
+    vector<shared_ptr<runtime::Executable>> unbucketed;
+    // Every rank compiles its own executables, the pass is only on while compiling bucketed
+    for (int rank = 0; rank < world_size; rank++)
+    {
+        set_environment("NGRAPH_PASS_ENABLES", "CPUAllReduceBucketing:1", 1);
+        bucketed_functions.push_back(make_function());
+        bucketed.push_back(backend->compile(bucketed_functions.back()));
+        unset_environment("NGRAPH_PASS_ENABLES");
+        unbucketed.push_back(backend->compile(make_function()));
+    }
+    EXPECT_EQ(count_ops_of_type<op::AllReduce>(bucketed_functions.front()), 0);
+
+    auto interface = new distributed::SharedMemoryDistributedInterface(world_size);
+    set_distributed_interface(unique_ptr<DistributedInterface>(interface));
+    vector<vector<vector<float>>> bucketed_results(world_size);
+    vector<vector<vector<float>>> unbucketed_results(world_size);
+    vector<thread> threads;
+    for (int rank = 0; rank < world_size; rank++)
+    {
+        threads.emplace_back([&, rank]() {
+            interface->set_rank(rank);
+            auto run = [&](const shared_ptr<runtime::Executable>& handle) {
+                vector<shared_ptr<runtime::Tensor>> args;
+                for (auto& param : handle->get_parameters())
+                {
+                    vector<float> data(shape_size(param->get_shape()));
+                    for (size_t i = 0; i < data.size(); i++)
+                    {
+                        data[i] = static_cast<float>((rank + 1) * (i + 1));
+                    }
+                    args.push_back(backend->create_tensor(element::f32, param->get_shape()));
+                    copy_data(args.back(), data);
+                }
+                vector<shared_ptr<runtime::Tensor>> results;
+                for (auto& result : handle->get_results())
+                {
+                    results.push_back(backend->create_tensor(element::f32, result->get_shape()));
+                }
+                handle->call_with_validate(results, args);
+                vector<vector<float>> values;
+                for (auto& result : results)
+                {
+                    values.push_back(read_vector<float>(result));
+                }
+                return values;
+            };
+            // Collectives are entered in the same order on every rank
+            bucketed_results[rank] = run(bucketed[rank]);
+            unbucketed_results[rank] = run(unbucketed[rank]);
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    set_distributed_interface(
+        unique_ptr<DistributedInterface>(new distributed::NullDistributedInterface()));
+
+    for (int rank = 0; rank < world_size; rank++)
+    {
+        ASSERT_EQ(unbucketed_results[rank].size(), bucketed_results[rank].size());
+        for (size_t i = 0; i < unbucketed_results[rank].size(); i++)
+        {
+            EXPECT_TRUE(test::all_close_f(unbucketed_results[rank][i], bucketed_results[rank][i]));
+        }
+    }
+    // The sum over ranks of (rank + 1) * (i + 1)
+    EXPECT_EQ(bucketed_results[0][0].at(1), 2 * (1 + 2 + 3 + 4));
+}
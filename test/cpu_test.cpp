@@ -15,10 +15,12 @@
 //*****************************************************************************
 
 #include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <iostream>
 #include <list>
 #include <memory>
+#include <set>
 #include <thread>
 
 #include "gtest/gtest.h"
@@ -38,6 +40,7 @@
 #include "ngraph/pass/visualize_tree.hpp"
 #include "ngraph/runtime/cpu/cpu_backend.hpp"
 #include "ngraph/runtime/cpu/cpu_builder.hpp"
+#include "ngraph/runtime/cpu/cpu_scheduler.hpp"
 #include "ngraph/runtime/cpu/mkldnn_utils.hpp"
 #include "ngraph/runtime/cpu/op/convert_layout.hpp"
 #include "ngraph/serializer.hpp"
@@ -1347,3 +1350,205 @@ TEST(cpu_test, gauss_error_function_erf_int32)
     auto expected_values = expected_result_nd_array.get_vector();
     ASSERT_EQ(result_values, expected_values);
 }
+
+TEST(cpu_test, scheduler_dependencies)
+{
+    // A wide graph: 8 independent chains of 50 ops that join into one final op
+    size_t chains = 8;
+    size_t length = 50;
+    size_t op_count = chains * length + 1;
+    vector<vector<size_t>> successors(op_count);
+    for (size_t c = 0; c < chains; c++)
+    {
+        for (size_t i = 0; i + 1 < length; i++)
+        {
+            successors[c * length + i].push_back(c * length + i + 1);
+        }
+        successors[c * length + length - 1].push_back(op_count - 1);
+    }
+    vector<size_t> costs(op_count, 1);
+    // The first chain is the critical path
+    for (size_t i = 0; i < length; i++)
+    {
+        costs[i] = 10;
+    }
+    runtime::cpu::executor::CPUScheduler scheduler(successors, costs, 4);
+    EXPECT_EQ(10 * length + 1, scheduler.get_priority(0));
+    EXPECT_EQ(length + 1, scheduler.get_priority(length));
+
+    for (size_t iteration = 0; iteration < 20; iteration++)
+    {
+        vector<atomic<bool>> done(op_count);
+        for (auto& d : done)
+        {
+            d = false;
+        }
+        atomic<size_t> calls{0};
+        atomic<bool> in_order{true};
+        atomic<bool> valid_worker{true};
+        scheduler.run([&](size_t op, size_t worker) {
+            valid_worker = valid_worker && worker < 4;
+            for (size_t c = 0; c < chains; c++)
+            {
+                for (size_t i = 0; i < length; i++)
+                {
+                    bool is_predecessor =
+                        op == op_count - 1 ? i == length - 1 : op == c * length + i + 1 &&
+                                                                    i + 1 < length;
+                    if (is_predecessor && !done[c * length + i])
+                    {
+                        in_order = false;
+                    }
+                }
+            }
+            done[op] = true;
+            calls++;
+        });
+        EXPECT_EQ(op_count, calls);
+        EXPECT_TRUE(in_order);
+        EXPECT_TRUE(valid_worker);
+    }
+}
+
+TEST(cpu_test, scheduler_exception)
+{
+    vector<vector<size_t>> successors{{1, 2}, {3}, {3}, {}};
+    runtime::cpu::executor::CPUScheduler scheduler(successors, {1, 1, 1, 1}, 3);
+    atomic<bool> last_called{false};
+    EXPECT_THROW(scheduler.run([&](size_t op, size_t worker) {
+        if (op == 1)
+        {
+            throw runtime_error("failed");
+        }
+        if (op == 3)
+        {
+            last_called = true;
+        }
+    }),
+                 runtime_error);
+    EXPECT_FALSE(last_called);
+
+    // The scheduler is usable again after a failed run
+    atomic<size_t> calls{0};
+    scheduler.run([&](size_t op, size_t worker) { calls++; });
+    EXPECT_EQ(4, calls);
+}
+
+TEST(cpu_test, scheduler_shared_helpers)
+{
+    // Schedulers share one set of helper threads. Runs on different schedulers may overlap,
+    // and an op may run another function's scheduler without waiting on helpers held by the
+    // outer run.
+    vector<vector<size_t>> successors(64);
+    for (size_t op = 0; op + 1 < successors.size(); op += 2)
+    {
+        successors[op].push_back(op + 1);
+    }
+    vector<size_t> costs(successors.size(), 1);
+    runtime::cpu::executor::CPUScheduler inner(successors, costs, 4);
+    vector<unique_ptr<runtime::cpu::executor::CPUScheduler>> outers;
+    for (size_t i = 0; i < 4; i++)
+    {
+        outers.emplace_back(new runtime::cpu::executor::CPUScheduler(successors, costs, 4));
+    }
+    mutex inner_mutex;
+    atomic<size_t> inner_calls{0};
+    atomic<size_t> outer_calls{0};
+    vector<thread> threads;
+    for (auto& scheduler : outers)
+    {
+        runtime::cpu::executor::CPUScheduler* outer = scheduler.get();
+        threads.emplace_back([&, outer]() {
+            for (size_t iteration = 0; iteration < 10; iteration++)
+            {
+                outer->run([&](size_t op, size_t worker) {
+                    if (op == 0)
+                    {
+                        lock_guard<mutex> lock(inner_mutex);
+                        inner.run([&](size_t, size_t) { inner_calls++; });
+                    }
+                    outer_calls++;
+                });
+            }
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    EXPECT_EQ(outers.size() * 10 * successors.size(), outer_calls);
+    EXPECT_EQ(outers.size() * 10 * successors.size(), inner_calls);
+}
+
+TEST(cpu_test, scheduler_memory_dependencies)
+{
+    runtime::cpu::executor::MemoryDependencies memory;
+    auto access = [&memory](size_t op, size_t space, size_t begin, size_t end, bool write) {
+        set<size_t> predecessors;
+        memory.access(op, space, begin, end, write, [&predecessors](size_t predecessor) {
+            predecessors.insert(predecessor);
+        });
+        return predecessors;
+    };
+    EXPECT_EQ(set<size_t>{}, access(0, 0, 0, 8, true));
+    EXPECT_EQ(set<size_t>{0}, access(1, 0, 0, 8, false));
+    EXPECT_EQ(set<size_t>{0}, access(2, 0, 0, 4, false));
+    // Overwriting [4, 12) waits for the reader of [4, 8), which already waits for op 0
+    EXPECT_EQ(set<size_t>{1}, access(3, 0, 4, 12, true));
+    EXPECT_EQ((set<size_t>{0, 3}), access(4, 0, 0, 12, false));
+    // Other bytes and other spaces are independent
+    EXPECT_EQ(set<size_t>{}, access(5, 0, 100, 104, true));
+    EXPECT_EQ(set<size_t>{}, access(6, 1, 0, 12, true));
+    // Only the readers since the last writes
+    EXPECT_EQ((set<size_t>{1, 2, 4}), access(7, 0, 0, 12, true));
+    // An op computed in place reads and then writes the same bytes
+    EXPECT_EQ(set<size_t>{7}, access(8, 0, 0, 12, false));
+    EXPECT_EQ(set<size_t>{}, access(8, 0, 0, 12, true));
+    EXPECT_EQ(set<size_t>{8}, access(9, 0, 2, 3, false));
+}
+
+TEST(cpu_test, scheduler_reused_intermediates)
+{
+    // Independent branches of elementwise chains, so the memory planner reuses intermediate
+    // buffers across branches that the scheduler may run concurrently. The scheduler is used
+    // when NGRAPH_INTER_OP_PARALLELISM gives the executor more than one thread pool, and only
+    // after the first call.
+    auto make_function = []() -> std::shared_ptr<Function> {
+        Shape shape{64, 256};
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        NodeVector branches;
+        for (size_t i = 0; i < 8; i++)
+        {
+            shared_ptr<Node> value = make_shared<op::Multiply>(
+                A, op::Constant::create(element::f32, shape, vector<float>(64 * 256, i + 1.0f)));
+            for (size_t j = 0; j < 4; j++)
+            {
+                value = make_shared<op::Negative>(make_shared<op::Add>(value, A));
+                value = make_shared<op::Reshape>(value, AxisVector{1, 0}, Shape{256, 64});
+                value = make_shared<op::Reshape>(value, AxisVector{1, 0}, shape);
+            }
+            branches.push_back(make_shared<op::Sum>(value, AxisSet{1}));
+        }
+        return make_shared<Function>(make_shared<op::Concat>(branches, 0), ParameterVector{A});
+    };
+
+    auto backend = runtime::Backend::create("CPU");
+    auto cpu_f = make_function();
+    auto int_f = make_function();
+
+    test::Uniform<float> rng(-1.0f, 1.0f);
+    vector<float> a(shape_size(cpu_f->get_parameters().at(0)->get_shape()));
+    rng.initialize(a);
+    auto int_results = execute(int_f, {a}, "INTERPRETER");
+
+    auto input = backend->create_tensor(element::f32, cpu_f->get_parameters().at(0)->get_shape());
+    auto result = backend->create_tensor(element::f32, cpu_f->get_output_shape(0));
+    copy_data(input, a);
+    auto handle = backend->compile(cpu_f);
+    for (size_t i = 0; i < 20; i++)
+    {
+        handle->call_with_validate({result}, {input});
+        EXPECT_TRUE(
+            test::all_close(read_vector<float>(result), int_results.at(0), 1.0e-4f, 1.0e-4f));
+    }
+}
@@ -15,11 +15,16 @@
 //*****************************************************************************
 
 #include <fstream>
+#include <functional>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 
 #include "ngraph/distributed.hpp"
+#include "ngraph/distributed/null.hpp"
+#include "ngraph/distributed/shared_memory.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/ngraph.hpp"
 #include "ngraph/serializer.hpp"
@@ -29,7 +34,7 @@
 using namespace std;
 using namespace ngraph;
 
-TEST(distributed_${BACKEND_NAME}, allreduce)
+static void allreduce()
 {
     auto comm_size = get_distributed_interface()->get_size();
     if (comm_size > 1)
@@ -55,7 +60,7 @@ TEST(distributed_${BACKEND_NAME}, allreduce)
     }
 }
 
-TEST(distributed_${BACKEND_NAME}, broadcastdistributed)
+static void broadcastdistributed()
 {
     auto shape = Shape{2, 2};
     auto A = make_shared<op::Parameter>(element::f32, shape);
@@ -77,3 +82,56 @@ TEST(distributed_${BACKEND_NAME}, broadcastdistributed)
     handle->call_with_validate({result}, {result});
     EXPECT_EQ(v, read_vector<float>(result));
 }
+
+// Runs test once on every rank of an in-process world of each size, one thread per rank. Only
+// done when no real distributed interface is configured, which would own the process.
+static void run_shared_memory_world_sizes(const function<void()>& test)
+{
+    if (get_distributed_interface()->get_name() != "NULL")
+    {
+        return;
+    }
+    for (int size : {2, 4, 8})
+    {
+        auto interface = new distributed::SharedMemoryDistributedInterface(size);
+        set_distributed_interface(unique_ptr<DistributedInterface>(interface));
+        vector<thread> threads;
+        for (int rank = 0; rank < size; rank++)
+        {
+            threads.emplace_back([interface, &test, rank]() {
+                interface->set_rank(rank);
+                test();
+            });
+        }
+        for (thread& t : threads)
+        {
+            t.join();
+        }
+    }
+    set_distributed_interface(
+        unique_ptr<DistributedInterface>(new distributed::NullDistributedInterface()));
+}
+
+TEST(distributed_${BACKEND_NAME}, allreduce)
+{
+    allreduce();
+}
+
+TEST(distributed_${BACKEND_NAME}, allreduce_shared_memory)
+{
+    run_shared_memory_world_sizes(allreduce);
+}
+
+TEST(distributed_${BACKEND_NAME}, broadcastdistributed)
+{
+    // Without a distributed build the null interface has no broadcast
+    if (get_distributed_interface()->get_name() != "NULL")
+    {
+        broadcastdistributed();
+    }
+}
+
+TEST(distributed_${BACKEND_NAME}, broadcastdistributed_shared_memory)
+{
+    run_shared_memory_world_sizes(broadcastdistributed);
+}
@@ -0,0 +1,158 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/distributed.hpp"
+#include "ngraph/distributed/null.hpp"
+#include "ngraph/distributed/shared_memory.hpp"
+#include "ngraph/ngraph.hpp"
+#include "util/test_tools.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+// Runs body once on each rank, one thread per rank
+static void run_ranks(distributed::SharedMemoryDistributedInterface& interface,
+                      const function<void(int)>& body)
+{
+    vector<thread> threads;
+    for (int rank = 0; rank < interface.get_size(); rank++)
+    {
+        threads.emplace_back([&interface, &body, rank]() {
+            interface.set_rank(rank);
+            body(rank);
+        });
+    }
+    for (thread& t : threads)
+    {
+        t.join();
+    }
+}
+
+TEST(distributed_shared_memory, all_reduce)
+{
+    const int size = 4;
+    const size_t count = 1001;
+    distributed::SharedMemoryDistributedInterface interface(size);
+    vector<vector<float>> inputs(size, vector<float>(count));
+    vector<vector<float>> outputs(size, vector<float>(count));
+    vector<vector<double>> in_place(size, vector<double>(count));
+    for (int rank = 0; rank < size; rank++)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            inputs[rank][i] = static_cast<float>(rank * i);
+            in_place[rank][i] = static_cast<double>(rank + i);
+        }
+    }
+
+    run_ranks(interface, [&](int rank) {
+        interface.all_reduce(
+            inputs[rank].data(), outputs[rank].data(), element::Type_t::f32, count);
+        interface.all_reduce(
+            in_place[rank].data(), in_place[rank].data(), element::Type_t::f64, count);
+    });
+
+    for (int rank = 0; rank < size; rank++)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            EXPECT_EQ(outputs[rank][i], static_cast<float>(6 * i));
+            EXPECT_EQ(in_place[rank][i], static_cast<double>(6 + 4 * i));
+        }
+    }
+}
+
+TEST(distributed_shared_memory, broadcast)
+{
+    const int size = 3;
+    distributed::SharedMemoryDistributedInterface interface(size);
+    vector<vector<int>> buffers{{1, 2, 3}, {0, 0, 0}, {7, 8, 9}};
+
+    run_ranks(interface, [&](int rank) {
+        interface.broadcast(buffers[rank].data(), element::Type_t::i32, 3);
+    });
+
+    for (auto& buffer : buffers)
+    {
+        EXPECT_EQ(buffer, (vector<int>{1, 2, 3}));
+    }
+}
+
+TEST(distributed_shared_memory, unbound_thread)
+{
+    distributed::SharedMemoryDistributedInterface interface(2);
+    EXPECT_ANY_THROW(interface.get_rank());
+    EXPECT_ANY_THROW(interface.set_rank(2));
+}
+
+// Runs an AllReduce on INTERPRETER on every rank, queued through begin_call if async is set
+static void backend_allreduce(bool async)
+{
+    // Only replace the process-wide interface when no real one is configured
+    if (get_distributed_interface()->get_name() != "NULL")
+    {
+        return;
+    }
+    const int size = 4;
+    auto interface = new distributed::SharedMemoryDistributedInterface(size);
+    set_distributed_interface(unique_ptr<DistributedInterface>(interface));
+
+    Shape shape{2, 2};
+    vector<vector<float>> results(size);
+    run_ranks(*interface, [&](int rank) {
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto f = make_shared<Function>(make_shared<op::AllReduce>(A), ParameterVector{A});
+        auto backend = runtime::Backend::create("INTERPRETER");
+        auto a = backend->create_tensor(element::f32, shape);
+        float v = static_cast<float>(rank + 1);
+        copy_data(a, vector<float>{v, 2 * v, 3 * v, 4 * v});
+        auto result = backend->create_tensor(element::f32, shape);
+        auto handle = backend->compile(f);
+        if (async)
+        {
+            // The call runs on a worker thread of the executable, which must act as this rank
+            EXPECT_TRUE(handle->begin_call({result}, {a}).get());
+        }
+        else
+        {
+            handle->call_with_validate({result}, {a});
+        }
+        results[rank] = read_vector<float>(result);
+    });
+
+    set_distributed_interface(
+        unique_ptr<DistributedInterface>(new distributed::NullDistributedInterface()));
+    for (auto& result : results)
+    {
+        EXPECT_EQ(result, (vector<float>{10, 20, 30, 40}));
+    }
+}
+
+TEST(distributed_shared_memory, backend_allreduce)
+{
+    backend_allreduce(false);
+}
+
+TEST(distributed_shared_memory, backend_allreduce_begin_call)
+{
+    backend_allreduce(true);
+}
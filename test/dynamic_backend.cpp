@@ -0,0 +1,163 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/ngraph.hpp"
+#include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/dynamic/dynamic_backend.hpp"
+#include "util/test_tools.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+TEST(dynamic_backend, dyn_reshape)
+{
+    auto data = make_shared<op::Parameter>(element::f32, PartialShape::dynamic());
+    auto pattern = make_shared<op::Parameter>(element::i64, PartialShape{Dimension::dynamic()});
+    auto reshape = make_shared<op::DynReshape>(data, pattern);
+    auto f = make_shared<Function>(reshape + reshape, ParameterVector{data, pattern});
+
+    auto backend =
+        make_shared<runtime::dynamic::DynamicBackend>(runtime::Backend::create("INTERPRETER"));
+    auto handle = backend->compile(f);
+    auto dynamic_handle = dynamic_pointer_cast<runtime::dynamic::DynamicExecutable>(handle);
+    ASSERT_NE(dynamic_handle, nullptr);
+
+    auto run = [&](const Shape& data_shape, const vector<int64_t>& pattern_values) {
+        auto a = backend->create_tensor(element::f32, data_shape);
+        vector<float> values(shape_size(data_shape));
+        iota(values.begin(), values.end(), 0.0f);
+        copy_data(a, values);
+        auto b = backend->create_tensor(element::i64, Shape{pattern_values.size()});
+        copy_data(b, pattern_values);
+
+        vector<Shape> result_shapes = dynamic_handle->get_result_shapes({a, b});
+        EXPECT_EQ(result_shapes.at(0), Shape(pattern_values.begin(), pattern_values.end()));
+        auto result = backend->create_tensor(element::f32, result_shapes.at(0));
+        handle->call_with_validate({result}, {a, b});
+        for (float& v : values)
+        {
+            v *= 2;
+        }
+        EXPECT_EQ(read_vector<float>(result), values);
+    };
+
+    run(Shape{2, 3}, {3, 2});
+    run(Shape{2, 3}, {6});
+    run(Shape{4, 2}, {2, 2, 2});
+    EXPECT_EQ(dynamic_handle->get_specialization_count(), 3);
+    run(Shape{2, 3}, {3, 2});
+    EXPECT_EQ(dynamic_handle->get_specialization_count(), 3);
+
+    // A pattern that does not fit the data fails to specialize and is not cached
+    auto bad_data = backend->create_tensor(element::f32, Shape{2, 3});
+    auto bad_pattern = backend->create_tensor(element::i64, Shape{2});
+    copy_data(bad_pattern, vector<int64_t>{4, 2});
+    EXPECT_ANY_THROW(dynamic_handle->get_result_shapes({bad_data, bad_pattern}));
+    EXPECT_EQ(dynamic_handle->get_specialization_count(), 3);
+    run(Shape{2, 3}, {6});
+
+    auto a = backend->create_tensor(element::f32, Shape{2, 3});
+    auto b = backend->create_tensor(element::i64, Shape{2});
+    copy_data(b, vector<int64_t>{3, 2});
+    auto wrong = backend->create_tensor(element::f32, Shape{2, 3});
+    EXPECT_ANY_THROW(handle->call_with_validate({wrong}, {a, b}));
+}
+
+TEST(dynamic_backend, shape_of)
+{
+    // Broadcasts x to the shape of y; only the shape of y matters, not its values
+    auto x = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic()});
+    auto y = make_shared<op::Parameter>(element::f32, PartialShape::dynamic(2));
+    auto axes = op::Constant::create(element::i64, Shape{1}, {0});
+    auto broadcast = make_shared<op::DynBroadcast>(x, make_shared<op::ShapeOf>(y), axes);
+    auto f = make_shared<Function>(broadcast, ParameterVector{x, y});
+
+    auto backend =
+        make_shared<runtime::dynamic::DynamicBackend>(runtime::Backend::create("INTERPRETER"));
+    auto handle = backend->compile(f);
+    auto dynamic_handle = dynamic_pointer_cast<runtime::dynamic::DynamicExecutable>(handle);
+
+    auto a = backend->create_tensor(element::f32, Shape{3});
+    copy_data(a, vector<float>{1, 2, 3});
+    auto b = backend->create_tensor(element::f32, Shape{2, 3});
+    auto result = backend->create_tensor(element::f32, Shape{2, 3});
+    handle->call_with_validate({result}, {a, b});
+    EXPECT_EQ(read_vector<float>(result), (vector<float>{1, 2, 3, 1, 2, 3}));
+
+    copy_data(b, vector<float>{6, 5, 4, 3, 2, 1});
+    handle->call_with_validate({result}, {a, b});
+    EXPECT_EQ(dynamic_handle->get_specialization_count(), 1);
+}
+
+TEST(dynamic_backend, max_cached)
+{
+    auto x = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic()});
+    auto f = make_shared<Function>(x + x, ParameterVector{x});
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    runtime::dynamic::DynamicExecutable handle(f, backend, false, 2);
+    for (size_t n : {1, 2, 3, 1, 2, 3})
+    {
+        auto a = backend->create_tensor(element::f32, Shape{n});
+        copy_data(a, vector<float>(n, 1));
+        auto result = backend->create_tensor(element::f32, Shape{n});
+        handle.call_with_validate({result}, {a});
+        EXPECT_EQ(read_vector<float>(result), vector<float>(n, 2));
+        EXPECT_LE(handle.get_specialization_count(), 2);
+    }
+}
+
+TEST(dynamic_backend, concurrent_calls)
+{
+    // Calls with different shapes specialize concurrently and each gets its own result
+    auto x = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic()});
+    auto f = make_shared<Function>(x + x, ParameterVector{x});
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    runtime::dynamic::DynamicExecutable handle(f, backend, false, 4);
+    atomic<size_t> mismatches{0};
+    vector<thread> threads;
+    for (size_t t = 0; t < 8; t++)
+    {
+        threads.emplace_back([&, t]() {
+            size_t n = t % 4 + 1;
+            auto a = backend->create_tensor(element::f32, Shape{n});
+            copy_data(a, vector<float>(n, static_cast<float>(t)));
+            auto result = backend->create_tensor(element::f32, Shape{n});
+            for (size_t i = 0; i < 10; i++)
+            {
+                handle.call_with_validate({result}, {a});
+                if (read_vector<float>(result) != vector<float>(n, 2.0f * t))
+                {
+                    mismatches++;
+                }
+            }
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    EXPECT_EQ(0, mismatches);
+    EXPECT_EQ(4, handle.get_specialization_count());
+}
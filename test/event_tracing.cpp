@@ -14,23 +14,35 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <atomic>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <mutex>
+#include <sstream>
 #include <stdlib.h>
+#include <thread>
 #include <vector>
 #include "nlohmann/json.hpp"
 
 #include "gtest/gtest.h"
 #include "ngraph/event_tracing.hpp"
 #include "ngraph/file_util.hpp"
+#include "ngraph/ngraph.hpp"
+#include "ngraph/pass/manager.hpp"
+#include "ngraph/pass/nop_elimination.hpp"
+#include "ngraph/trace.hpp"
 
 using namespace std;
 
 TEST(event_tracing, event_file)
 {
     // Set the environment variable to ensure logging
+    ngraph::trace::clear();
+    bool process_tracing = ngraph::trace::is_enabled();
     ngraph::Event::enable_event_tracing();
+    // The Event API is independent of process-wide tracing
+    EXPECT_EQ(ngraph::trace::is_enabled(), process_tracing);
     std::vector<std::thread> threads;
     std::mutex mtx;
     for (auto i = 0; i < 10; i++)
@@ -55,11 +67,142 @@ TEST(event_tracing, event_file)
         next.join();
     }
 
+    // Disabling tracing writes the file
+    ngraph::Event::disable_event_tracing();
+
     // Now read the file
     auto json_string = ngraph::file_util::read_file_to_string("ngraph_event_trace.json");
-    nlohmann::json json_from_file(json_string);
+    auto json_from_file = nlohmann::json::parse(json_string);
 
     // Validate the JSON objects - there should be 10 of them
-    // TODO
-    ngraph::Event::disable_event_tracing();
+    size_t count = 0;
+    for (auto& event : json_from_file["traceEvents"])
+    {
+        if (event["cat"] == "Dummy")
+        {
+            EXPECT_EQ(event["ph"], "X");
+            EXPECT_GE(event["dur"].get<double>(), 200000.0);
+            count++;
+        }
+    }
+    EXPECT_EQ(count, 10);
+}
+
+static size_t count_events(const nlohmann::json& trace, const std::string& category)
+{
+    size_t count = 0;
+    for (auto& event : trace["traceEvents"])
+    {
+        if (event["cat"] == category && event["ph"] == "X")
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+TEST(event_tracing, ring_buffer)
+{
+    ngraph::trace::clear();
+    ngraph::trace::enable();
+    uint32_t category = ngraph::trace::intern("Ring");
+    uint32_t name = ngraph::trace::intern("a \"quoted\" name");
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; i++)
+    {
+        threads.emplace_back([&]() {
+            for (size_t j = 0; j < 100; j++)
+            {
+                ngraph::trace::Scope scope(category, name);
+            }
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    ngraph::trace::disable();
+
+    std::stringstream ss;
+    ngraph::trace::write_chrome_trace(ss);
+    auto trace = nlohmann::json::parse(ss.str());
+    EXPECT_EQ(count_events(trace, "Ring"), 400);
+
+    // Scopes started while tracing is disabled are not recorded
+    {
+        ngraph::trace::Scope scope(category, name);
+    }
+    ngraph::trace::clear();
+    ss.str("");
+    ngraph::trace::write_chrome_trace(ss);
+    EXPECT_EQ(count_events(nlohmann::json::parse(ss.str()), "Ring"), 0);
+
+    // Recording continues after a clear, and writing leaves the stream's format alone
+    ngraph::trace::enable();
+    {
+        ngraph::trace::Scope scope(category, name);
+    }
+    ngraph::trace::disable();
+    ss.str("");
+    ss << std::setprecision(2);
+    auto flags = ss.flags();
+    ngraph::trace::write_chrome_trace(ss);
+    EXPECT_EQ(count_events(nlohmann::json::parse(ss.str()), "Ring"), 1);
+    EXPECT_EQ(ss.flags(), flags);
+    EXPECT_EQ(ss.precision(), 2);
+    ngraph::trace::clear();
+}
+
+TEST(event_tracing, clear_while_recording)
+{
+    ngraph::trace::clear();
+    ngraph::trace::enable();
+    uint32_t category = ngraph::trace::intern("Clear");
+    uint32_t name = ngraph::trace::intern("event");
+    std::atomic<bool> done{false};
+    std::thread recorder([&]() {
+        while (!done)
+        {
+            ngraph::trace::Scope scope(category, name);
+        }
+    });
+    for (size_t i = 0; i < 100; i++)
+    {
+        ngraph::trace::clear();
+    }
+    done = true;
+    recorder.join();
+    ngraph::trace::disable();
+
+    ngraph::trace::clear();
+    std::stringstream ss;
+    ngraph::trace::write_chrome_trace(ss);
+    EXPECT_EQ(count_events(nlohmann::json::parse(ss.str()), "Clear"), 0);
+}
+
+TEST(event_tracing, pass_events)
+{
+    auto A = std::make_shared<ngraph::op::Parameter>(ngraph::element::f32, ngraph::Shape{2});
+    auto f = std::make_shared<ngraph::Function>(std::make_shared<ngraph::op::Abs>(A),
+                                                ngraph::ParameterVector{A});
+    ngraph::pass::Manager pass_manager;
+    pass_manager.register_pass<ngraph::pass::NopElimination>();
+
+    ngraph::trace::clear();
+    ngraph::trace::enable();
+    pass_manager.run_passes(f);
+    ngraph::trace::disable();
+
+    std::stringstream ss;
+    ngraph::trace::write_chrome_trace(ss);
+    auto trace = nlohmann::json::parse(ss.str());
+    ASSERT_EQ(count_events(trace, "Pass"), 1);
+    for (auto& event : trace["traceEvents"])
+    {
+        if (event["cat"] == "Pass" && event["ph"] == "X")
+        {
+            EXPECT_EQ(event["name"], "ngraph::pass::NopElimination");
+        }
+    }
+    ngraph::trace::clear();
 }
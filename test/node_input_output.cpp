@@ -26,6 +26,35 @@
 using namespace ngraph;
 using namespace std;
 
+namespace
+{
+    // An op whose output count grows after it already has users, as fused ops do when type
+    // inference is re-run
+    class GrowingOp : public Node
+    {
+    public:
+        GrowingOp(const shared_ptr<Node>& arg)
+            : Node("GrowingOp", {arg}, 1)
+        {
+            set_output_type(0, element::f32, Shape{2});
+        }
+
+        void grow(size_t n)
+        {
+            set_output_size(n);
+            for (size_t i = 0; i < n; i++)
+            {
+                set_output_type(i, element::f32, Shape{2});
+            }
+        }
+
+        shared_ptr<Node> copy_with_new_args(const NodeVector& new_args) const override
+        {
+            return make_shared<GrowingOp>(new_args.at(0));
+        }
+    };
+}
+
 TEST(node_input_output, input_create)
 {
     auto x = make_shared<op::Parameter>(element::f32, Shape{1, 2, 3, 4});
@@ -111,3 +140,21 @@ TEST(node_input_output, output_create_const)
 
     EXPECT_THROW(add->output(1), std::out_of_range);
 }
+
+TEST(node_input_output, output_grow_with_users)
+{
+    auto x = make_shared<op::Parameter>(element::f32, Shape{2});
+    auto op = make_shared<GrowingOp>(x);
+    auto neg = make_shared<op::Negative>(op);
+    auto tensor = &op->output(0).get_tensor();
+
+    op->grow(4);
+
+    EXPECT_EQ(op->get_output_size(), 4);
+    EXPECT_EQ(neg->input(0).get_source_output(), Output<Node>(op, 0));
+    EXPECT_EQ(&neg->input(0).get_tensor(), tensor);
+    auto targets = op->output(0).get_target_inputs();
+    ASSERT_EQ(targets.size(), 1);
+    EXPECT_EQ(targets.begin()->get_node(), neg.get());
+    EXPECT_TRUE(op->output(3).get_target_inputs().empty());
+}
@@ -0,0 +1,72 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/ngraph.hpp"
+#include "ngraph/pass/dyn_elimination.hpp"
+#include "ngraph/pass/manager.hpp"
+#include "util/test_tools.hpp"
+
+using namespace ngraph;
+using namespace std;
+
+TEST(dyn_elimination, chain)
+{
+    auto param = make_shared<op::Parameter>(element::f32, Shape{2, 3, 4});
+    auto pattern = op::Constant::create(element::i64, Shape{2}, {6, 4});
+    auto dyn_reshape = make_shared<op::DynReshape>(param, pattern);
+    auto lower = op::Constant::create(element::i64, Shape{2}, {1, 0});
+    auto upper = op::Constant::create(element::i64, Shape{2}, {-1, 100});
+    auto strides = op::Constant::create(element::i64, Shape{2}, {2, 1});
+    auto dyn_slice = make_shared<op::DynSlice>(dyn_reshape, lower, upper, strides);
+    auto order = op::Constant::create(element::i64, Shape{2}, {1, 0});
+    auto transpose = make_shared<op::Transpose>(dyn_slice, order);
+    auto f = make_shared<Function>(transpose, ParameterVector{param});
+    ASSERT_TRUE(f->is_dynamic());
+
+    pass::Manager manager;
+    manager.register_pass<pass::DynElimination>();
+    manager.run_passes(f);
+
+    ASSERT_FALSE(f->is_dynamic());
+    EXPECT_EQ(count_ops_of_type<op::DynReshape>(f), 0);
+    EXPECT_EQ(count_ops_of_type<op::DynSlice>(f), 0);
+    EXPECT_EQ(count_ops_of_type<op::Transpose>(f), 0);
+    auto slice = dynamic_pointer_cast<op::Slice>(
+        f->get_results().at(0)->get_argument(0)->get_argument(0));
+    ASSERT_NE(slice, nullptr);
+    EXPECT_EQ(slice->get_lower_bounds(), (Coordinate{1, 0}));
+    EXPECT_EQ(slice->get_upper_bounds(), (Coordinate{5, 4}));
+    EXPECT_EQ(f->get_results().at(0)->get_shape(), (Shape{4, 2}));
+}
+
+TEST(dyn_elimination, non_constant_shape)
+{
+    auto param = make_shared<op::Parameter>(element::f32, Shape{2, 3});
+    auto pattern = make_shared<op::Parameter>(element::i64, Shape{1});
+    auto dyn_reshape = make_shared<op::DynReshape>(param, pattern);
+    auto f = make_shared<Function>(dyn_reshape, ParameterVector{param, pattern});
+
+    pass::Manager manager;
+    manager.register_pass<pass::DynElimination>();
+    manager.run_passes(f);
+
+    EXPECT_EQ(count_ops_of_type<op::DynReshape>(f), 1);
+}
@@ -14,9 +14,12 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <chrono>
+#include <iostream>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -41,3 +44,101 @@ TEST(pass_manager, add)
     EXPECT_EQ(node_count, sorted.size());
     EXPECT_TRUE(validate_list(sorted));
 }
+
+namespace
+{
+    // Sleeps so that it uses up a compile time budget
+    class SlowPass : public pass::FunctionPass
+    {
+    public:
+        bool run_on_function(shared_ptr<Function> f) override
+        {
+            this_thread::sleep_for(chrono::milliseconds(20));
+            return false;
+        }
+    };
+
+    // Bypasses every Abs
+    class RemoveAbs : public pass::FunctionPass
+    {
+    public:
+        RemoveAbs(size_t& runs)
+            : m_runs(runs)
+        {
+        }
+        bool run_on_function(shared_ptr<Function> f) override
+        {
+            m_runs++;
+            bool replaced = false;
+            for (auto node : f->get_ordered_ops())
+            {
+                if (node->description() == "Abs")
+                {
+                    replace_node(node, node->get_argument(0));
+                    replaced = true;
+                }
+            }
+            return replaced;
+        }
+
+    private:
+        size_t& m_runs;
+    };
+}
+
+static shared_ptr<Function> make_abs_function()
+{
+    auto A = make_shared<op::Parameter>(element::f32, Shape{2});
+    auto B = make_shared<op::Abs>(make_shared<op::Abs>(A));
+    return make_shared<Function>(make_shared<op::Negative>(B), ParameterVector{A});
+}
+
+TEST(pass_manager, profile_node_delta)
+{
+    auto f = make_abs_function();
+    size_t runs = 0;
+    pass::Manager pass_manager;
+    pass_manager.set_per_pass_profiling(true);
+    pass_manager.register_pass<RemoveAbs>(runs);
+    auto flags = cout.flags();
+    pass_manager.run_passes(f);
+    // Printing the profile leaves the formatting of cout as it was
+    EXPECT_EQ(cout.flags(), flags);
+
+    auto& profile = pass_manager.get_pass_profile();
+    ASSERT_EQ(profile.size(), 1);
+    EXPECT_FALSE(profile[0].skipped);
+    EXPECT_EQ(profile[0].node_count, f->get_ops().size());
+    EXPECT_EQ(profile[0].node_delta, -2);
+    EXPECT_NE(profile[0].name.find("RemoveAbs"), string::npos);
+}
+
+TEST(pass_manager, compile_time_budget)
+{
+    auto f = make_abs_function();
+    size_t required_runs = 0;
+    size_t optional_runs = 0;
+    pass::Manager pass_manager;
+    pass_manager.get_pass_config().set_compile_time_budget(10);
+    pass_manager.register_pass<SlowPass>();
+    pass_manager.register_optional_pass<RemoveAbs>(optional_runs);
+    pass_manager.register_pass<RemoveAbs>(required_runs);
+    pass_manager.run_passes(f);
+
+    // The optional pass is skipped once the budget is spent, later required passes still run
+    EXPECT_EQ(optional_runs, 0);
+    EXPECT_EQ(required_runs, 1);
+    auto& profile = pass_manager.get_pass_profile();
+    ASSERT_EQ(profile.size(), 3);
+    EXPECT_FALSE(profile[0].skipped);
+    EXPECT_GE(profile[0].milliseconds, 20);
+    EXPECT_TRUE(profile[1].skipped);
+    EXPECT_FALSE(profile[2].skipped);
+
+    // Without a budget optional passes run
+    pass::Manager unlimited;
+    unlimited.register_pass<SlowPass>();
+    unlimited.register_optional_pass<RemoveAbs>(optional_runs);
+    unlimited.run_passes(make_abs_function());
+    EXPECT_EQ(optional_runs, 1);
+}
@@ -216,7 +216,8 @@ TEST(memory_layout, basic)
     pass_manager.run_passes(graph);
     auto sorted = graph->get_ordered_ops();
     size_t temporary_pool_size = graph->get_temporary_pool_size();
-    EXPECT_EQ(12, temporary_pool_size);
+    // The Multiply and both inner Adds write over the dying t0 and t1
+    EXPECT_EQ(8, temporary_pool_size);
 }
 
 TEST(memory_layout, constant)
@@ -236,3 +237,167 @@ TEST(memory_layout, constant)
     size_t temporary_pool_size = f->get_temporary_pool_size();
     EXPECT_EQ(4, temporary_pool_size);
 }
+
+TEST(memory_layout, elementwise_in_place)
+{
+    Shape shape{16};
+    auto a = make_shared<op::Parameter>(element::f32, shape);
+    auto b = make_shared<op::Parameter>(element::f32, shape);
+    auto t0 = make_shared<op::Add>(a, b);
+    auto t1 = make_shared<op::Exp>(t0);
+    auto t2 = make_shared<op::Multiply>(t1, b);
+    auto t3 = make_shared<op::Tanh>(t2);
+    // t3 is still used below, so the Subtract cannot write over it
+    auto t4 = make_shared<op::Subtract>(t3, a);
+    auto t5 = make_shared<op::Divide>(t4, t3);
+    auto f = make_shared<Function>(make_shared<op::Abs>(t5), ParameterVector{a, b});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::Liveness>();
+    pass_manager.register_pass<pass::MemoryLayout>();
+    pass_manager.run_passes(f);
+
+    size_t offset = t0->get_output_tensor().get_pool_offset();
+    EXPECT_EQ(offset, t1->get_output_tensor().get_pool_offset());
+    EXPECT_EQ(offset, t2->get_output_tensor().get_pool_offset());
+    EXPECT_EQ(offset, t3->get_output_tensor().get_pool_offset());
+    EXPECT_NE(offset, t4->get_output_tensor().get_pool_offset());
+    EXPECT_EQ(t4->get_output_tensor().get_pool_offset(),
+              t5->get_output_tensor().get_pool_offset());
+    EXPECT_EQ(2 * shape_size(shape) * sizeof(float), f->get_temporary_pool_size());
+}
+
+TEST(memory_layout, elementwise_in_place_type_change)
+{
+    Shape shape{16};
+    auto a = make_shared<op::Parameter>(element::f32, shape);
+    auto b = make_shared<op::Parameter>(element::f32, Shape{4, 4});
+    auto t0 = make_shared<op::Exp>(a);
+    auto t1 = make_shared<op::Greater>(t0, a);
+    auto t2 = make_shared<op::Negative>(b);
+    auto t3 = make_shared<op::Reshape>(t2, AxisVector{0, 1}, shape);
+    auto t4 = make_shared<op::Abs>(t3);
+    auto f = make_shared<Function>(NodeVector{t1, t4}, ParameterVector{a, b});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::Liveness>();
+    pass_manager.register_pass<pass::MemoryLayout>();
+    pass_manager.run_passes(f);
+
+    // Greater produces booleans and the Reshape is not pointwise, so neither reuses its input
+    EXPECT_NE(t0->get_output_tensor().get_pool_offset(), t1->get_output_tensor().get_pool_offset());
+    EXPECT_NE(t2->get_output_tensor().get_pool_offset(), t3->get_output_tensor().get_pool_offset());
+    EXPECT_EQ(t3->get_output_tensor().get_pool_offset(), t4->get_output_tensor().get_pool_offset());
+}
+
+TEST(memory_layout, greedy_by_size)
+{
+    // First fit puts t3 above t2 because t1's freed hole is too small; planning the largest
+    // buffer first lets t1 and t3 share the bottom of the pool
+    auto p = make_shared<op::Parameter>(element::f32, Shape{25});
+    auto t1 = make_shared<op::Negative>(p);
+    auto t2 = make_shared<op::Slice>(t1, Coordinate{0}, Coordinate{2});
+    auto t3 = make_shared<op::Broadcast>(t2, Shape{14, 2}, AxisSet{0});
+    auto t4 = make_shared<op::Negative>(t3);
+    auto make_function = [&]() { return make_shared<Function>(t4, ParameterVector{p}); };
+
+    auto f = make_function();
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::Liveness>();
+    pass_manager.run_passes(f);
+
+    pass::MemoryLayout first_fit;
+    first_fit.run_on_function(f);
+    EXPECT_EQ(220, first_fit.get_pool_size());
+    EXPECT_EQ(120, first_fit.get_lower_bound());
+
+    pass::MemoryLayout greedy(1, false, pass::MemoryLayout::Planner::GREEDY_BY_SIZE);
+    greedy.run_on_function(f);
+    EXPECT_EQ(120, greedy.get_pool_size());
+    EXPECT_EQ(120, greedy.get_lower_bound());
+    EXPECT_EQ(120, f->get_temporary_pool_size());
+    EXPECT_EQ(0, t1->get_output_tensor().get_pool_offset());
+    EXPECT_EQ(112, t2->get_output_tensor().get_pool_offset());
+    EXPECT_EQ(0, t3->get_output_tensor().get_pool_offset());
+}
+
+// Tensors live at the same step must not overlap in the pool, other than tensors computed in
+// place over one another, which start at the same offset
+static void check_no_overlap(const shared_ptr<Function>& f, size_t alignment, bool in_place)
+{
+    set<descriptor::Tensor*> live;
+    for (auto node : f->get_ordered_ops())
+    {
+        live.insert(node->liveness_new_list.begin(), node->liveness_new_list.end());
+        for (auto a : live)
+        {
+            EXPECT_EQ(0, a->get_pool_offset() % alignment);
+            for (auto b : live)
+            {
+                if (a != b && (!in_place || a->get_pool_offset() != b->get_pool_offset()))
+                {
+                    EXPECT_TRUE(a->get_pool_offset() + a->size() <= b->get_pool_offset() ||
+                                b->get_pool_offset() + b->size() <= a->get_pool_offset());
+                }
+            }
+        }
+        for (auto tensor : node->liveness_free_list)
+        {
+            live.erase(tensor);
+        }
+    }
+}
+
+TEST(memory_layout, greedy_by_size_no_overlap)
+{
+    pass::PassConfig config;
+    config.set_pass_attribute("MemoryLayout::GreedyBySize", true);
+    ASSERT_EQ(pass::MemoryLayout::Planner::GREEDY_BY_SIZE,
+              pass::MemoryLayout::get_planner(config));
+
+    auto f = make_test_graph();
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::Liveness>();
+    pass_manager.register_pass<pass::MemoryLayout>(
+        64, false, pass::MemoryLayout::get_planner(config));
+    pass_manager.run_passes(f);
+
+    check_no_overlap(f, 64, true);
+    EXPECT_EQ(128, f->get_temporary_pool_size());
+}
+
+TEST(memory_layout, greedy_by_size_many_buffers)
+{
+    // Tensors of varied sizes whose lifetimes overlap in many different ways. Reverse and
+    // Concat are not computed in place, so every tensor has a buffer of its own.
+    auto p = make_shared<op::Parameter>(element::f32, Shape{64});
+    NodeVector values;
+    NodeVector results;
+    for (size_t i = 0; i < 200; i++)
+    {
+        size_t size = 1 + (i * 37) % 64;
+        shared_ptr<Node> value = make_shared<op::Reverse>(
+            make_shared<op::Slice>(p, Coordinate{0}, Coordinate{size}), AxisSet{0});
+        if (!values.empty())
+        {
+            auto earlier = values[(i * 11) % values.size()];
+            value = make_shared<op::Reverse>(make_shared<op::Concat>(NodeVector{value, earlier}, 0),
+                                             AxisSet{0});
+            value = make_shared<op::Slice>(value, Coordinate{0}, Coordinate{size});
+        }
+        values.push_back(value);
+        if (i % 10 == 9)
+        {
+            results.push_back(value);
+        }
+    }
+    auto f = make_shared<Function>(results, ParameterVector{p});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::Liveness>();
+    pass_manager.register_pass<pass::MemoryLayout>(
+        4, false, pass::MemoryLayout::Planner::GREEDY_BY_SIZE);
+    pass_manager.run_passes(f);
+
+    check_no_overlap(f, 4, false);
+}
@@ -293,6 +293,44 @@ TEST(pattern, graph_rewrite)
     }
 }
 
+TEST(pattern, graph_rewrite_dispatch)
+{
+    Shape shape{};
+    auto a = make_shared<op::Parameter>(element::i32, shape);
+    auto b = make_shared<op::Parameter>(element::i32, shape);
+    auto sum = make_shared<op::Add>(a, b);
+    auto product = make_shared<op::Multiply>(sum, b);
+    auto f = make_shared<Function>(product, ParameterVector{a, b});
+
+    vector<string> visits;
+    auto lhs = make_shared<pattern::op::Label>(element::i32, shape);
+    auto rhs = make_shared<pattern::op::Label>(element::i32, shape);
+    auto add_pattern = make_shared<op::Add>(lhs, rhs);
+    auto label_pattern = make_shared<pattern::op::Label>(
+        element::i32, shape, [](shared_ptr<Node> n) { return n->description() != "Result"; });
+
+    pass::GraphRewrite rewrite;
+    rewrite.add_matcher(make_shared<pattern::Matcher>(add_pattern, "add"),
+                        [&visits](pattern::Matcher& m) {
+                            visits.push_back("add:" + m.get_match_root()->description());
+                            return false;
+                        });
+    rewrite.add_matcher(make_shared<pattern::Matcher>(label_pattern, "label"),
+                        [&visits](pattern::Matcher& m) {
+                            visits.push_back("label:" + m.get_match_root()->description());
+                            return false;
+                        });
+    rewrite.run_on_function(f);
+
+    // The Add matcher is only offered Add nodes and still runs before the later matcher
+    vector<string> expected{"label:Parameter",
+                            "label:Parameter",
+                            "add:Add",
+                            "label:Add",
+                            "label:Multiply"};
+    EXPECT_EQ(expected, visits);
+}
+
 std::ostream& operator<<(std::ostream& os, const ngraph::NodeVector& nv)
 {
     std::vector<std::string> names;
@@ -190,6 +190,50 @@ TEST(serialize, constant)
     EXPECT_TRUE(found);
 }
 
+TEST(serialize, binary_constant)
+{
+    const string tmp_file = "serialize_binary_constant.ngbm";
+    Shape shape{2, 2, 2};
+    auto A = op::Constant::create(element::f32, shape, {1, 2, 3, 4, 5, 6, 7, 8});
+    auto B = op::Constant::create(element::i64, Shape{3}, {-1, 0, 1});
+    auto f = make_shared<Function>(NodeVector{A, B}, ParameterVector{});
+
+    serialize_binary(tmp_file, f);
+
+    // Loading from a path maps the file, loading from a stream copies the constants
+    shared_ptr<Function> mapped = deserialize(tmp_file);
+    shared_ptr<Function> copied;
+    {
+        ifstream in(tmp_file, ios_base::binary | ios_base::in);
+        copied = deserialize(in);
+    }
+    file_util::remove_file(tmp_file);
+
+    for (shared_ptr<Function> g : {mapped, copied})
+    {
+        ASSERT_NE(g, nullptr);
+        size_t found = 0;
+        for (shared_ptr<Node> node : g->get_ordered_ops())
+        {
+            shared_ptr<op::Constant> c = dynamic_pointer_cast<op::Constant>(node);
+            if (c && c->get_element_type() == element::f32)
+            {
+                found++;
+                EXPECT_EQ((vector<float>{1, 2, 3, 4, 5, 6, 7, 8}), c->get_vector<float>());
+                auto copy = c->copy_with_new_args({});
+                EXPECT_EQ((vector<float>{1, 2, 3, 4, 5, 6, 7, 8}),
+                          static_pointer_cast<op::Constant>(copy)->get_vector<float>());
+            }
+            else if (c)
+            {
+                found++;
+                EXPECT_EQ((vector<int64_t>{-1, 0, 1}), c->get_vector<int64_t>());
+            }
+        }
+        EXPECT_EQ(found, 2);
+    }
+}
+
 TEST(benchmark, serialize)
 {
     stopwatch timer;